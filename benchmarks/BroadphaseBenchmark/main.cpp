@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bullet/BulletWorld.h"
+#include "bullet/BulletCollisionShapes.h"
+
+/**
+ * BroadphaseBenchmark - Headless broadphase comparison
+ *
+ * Replays the layouts of the demo scenes at large body counts against every
+ * BroadphaseType and prints per-step timings:
+ * - BallCollision: bounded arena with walls and randomly moving balls
+ *   (BallCollisionScene / BallCollision2Scene), scaled to keep the demo's ball density
+ * - BallFreeFall: grid of balls dropped onto a ground plane
+ *   (BallFreeFallScene / BasicGroundBallScene)
+ *
+ * Usage: BroadphaseBenchmark [--frames N] [--warmup N] [--counts 1000,10000,50000] [--scene name]
+ */
+
+namespace {
+
+constexpr float FIXED_TIME_STEP = 1.0f / 60.0f;
+
+// Ball density of BallCollisionScene: 15 balls on a 5x5 m plane
+constexpr float ARENA_BALL_DENSITY = 15.0f / 25.0f;
+constexpr float ARENA_BALL_RADIUS = 0.2f;
+constexpr float ARENA_WALL_HEIGHT = 2.0f; // Taller than the demo so fast balls stay inside
+constexpr float ARENA_WALL_WIDTH = 0.2f;
+
+constexpr float FREE_FALL_BALL_RADIUS = 0.5f;
+constexpr float FREE_FALL_SPACING = 1.5f;
+
+struct BenchmarkOptions {
+    int frames = 120;
+    int warmupFrames = 10;
+    std::vector<int> bodyCounts = {1000, 10000, 50000};
+    std::string sceneFilter;
+};
+
+struct StepStatistics {
+    double buildMs = 0.0;
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double maxMs = 0.0;
+    int overlappingPairs = 0;
+};
+
+// Owns the Bullet objects of one benchmark run. Bodies are created directly instead of
+// through BulletRigidBody so per-body debug output does not skew the timings.
+class BenchmarkScene {
+public:
+    explicit BenchmarkScene(const BulletWorldConfig& config)
+        : m_world(std::make_unique<BulletWorld>(config)) {}
+
+    ~BenchmarkScene() {
+        for (btRigidBody* body : m_bodies) {
+            m_world->RemoveRigidBody(body);
+            delete body->getMotionState();
+            delete body;
+        }
+        for (btCollisionShape* shape : m_shapes) {
+            BulletCollisionShapes::DeleteShape(shape);
+        }
+    }
+
+    BulletWorld& world() { return *m_world; }
+
+    btCollisionShape* addShape(btCollisionShape* shape) {
+        m_shapes.push_back(shape);
+        return shape;
+    }
+
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const glm::vec3& position,
+                         const glm::vec3& velocity = glm::vec3(0.0f)) {
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(btVector3(position.x, position.y, position.z));
+
+        btVector3 inertia(0, 0, 0);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+
+        btDefaultMotionState* motionState = new btDefaultMotionState(transform);
+        btRigidBody::btRigidBodyConstructionInfo info(mass, motionState, shape, inertia);
+        btRigidBody* body = new btRigidBody(info);
+
+        // Same material defaults as BulletRigidBody
+        body->setRestitution(0.1f);
+        body->setFriction(0.8f);
+        body->setRollingFriction(0.05f);
+        body->setSpinningFriction(0.05f);
+        body->setLinearVelocity(btVector3(velocity.x, velocity.y, velocity.z));
+
+        m_world->AddRigidBody(body);
+        m_bodies.push_back(body);
+        return body;
+    }
+
+private:
+    std::unique_ptr<BulletWorld> m_world;
+    std::vector<btCollisionShape*> m_shapes;
+    std::vector<btRigidBody*> m_bodies;
+};
+
+struct SceneLayout {
+    const char* name;
+    // Computes world bounds for a body count
+    void (*computeBounds)(int bodyCount, glm::vec3& worldMin, glm::vec3& worldMax);
+    // Populates the scene with bodyCount dynamic bodies
+    void (*populate)(BenchmarkScene& scene, int bodyCount);
+};
+
+float arenaSize(int bodyCount) {
+    return std::max(5.0f, std::sqrt(static_cast<float>(bodyCount) / ARENA_BALL_DENSITY));
+}
+
+void ballCollisionBounds(int bodyCount, glm::vec3& worldMin, glm::vec3& worldMax) {
+    float half = arenaSize(bodyCount) * 0.5f + 5.0f;
+    worldMin = glm::vec3(-half, -10.0f, -half);
+    worldMax = glm::vec3(half, 50.0f, half);
+}
+
+void populateBallCollision(BenchmarkScene& scene, int bodyCount) {
+    float size = arenaSize(bodyCount);
+    float half = size * 0.5f;
+
+    // Ground box (top surface at Y = 0) and boundary walls, as in BallCollision2Scene
+    btCollisionShape* ground = scene.addShape(BulletCollisionShapes::CreateBox(glm::vec3(half, 0.15f, half)));
+    scene.addBody(ground, 0.0f, glm::vec3(0.0f, -0.15f, 0.0f));
+
+    btCollisionShape* wallX = scene.addShape(BulletCollisionShapes::CreateBox(
+        glm::vec3(half, ARENA_WALL_HEIGHT * 0.5f, ARENA_WALL_WIDTH * 0.5f)));
+    btCollisionShape* wallZ = scene.addShape(BulletCollisionShapes::CreateBox(
+        glm::vec3(ARENA_WALL_WIDTH * 0.5f, ARENA_WALL_HEIGHT * 0.5f, half)));
+    float wallOffset = half + ARENA_WALL_WIDTH * 0.5f;
+    scene.addBody(wallX, 0.0f, glm::vec3(0.0f, ARENA_WALL_HEIGHT * 0.5f, wallOffset));
+    scene.addBody(wallX, 0.0f, glm::vec3(0.0f, ARENA_WALL_HEIGHT * 0.5f, -wallOffset));
+    scene.addBody(wallZ, 0.0f, glm::vec3(wallOffset, ARENA_WALL_HEIGHT * 0.5f, 0.0f));
+    scene.addBody(wallZ, 0.0f, glm::vec3(-wallOffset, ARENA_WALL_HEIGHT * 0.5f, 0.0f));
+
+    // Balls with the random velocity distribution of BallCollisionScene (fixed seed)
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> velDist(-8.0f, 8.0f);
+    std::uniform_real_distribution<float> posDist(-half + ARENA_BALL_RADIUS, half - ARENA_BALL_RADIUS);
+
+    btCollisionShape* ball = scene.addShape(BulletCollisionShapes::CreateSphere(ARENA_BALL_RADIUS));
+    for (int i = 0; i < bodyCount; ++i) {
+        glm::vec3 position(posDist(gen), ARENA_BALL_RADIUS + 0.1f, posDist(gen));
+        glm::vec3 velocity(velDist(gen), std::abs(velDist(gen)) * 0.5f, velDist(gen));
+        scene.addBody(ball, 1.0f, position, velocity);
+    }
+}
+
+int freeFallGridSide(int bodyCount) {
+    return std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(bodyCount) / 10.0f))));
+}
+
+void freeFallBounds(int bodyCount, glm::vec3& worldMin, glm::vec3& worldMax) {
+    int side = freeFallGridSide(bodyCount);
+    int layers = (bodyCount + side * side - 1) / (side * side);
+    float half = side * FREE_FALL_SPACING * 0.5f + 10.0f;
+    worldMin = glm::vec3(-half, -10.0f, -half);
+    worldMax = glm::vec3(half, layers * FREE_FALL_SPACING + 20.0f, half);
+}
+
+void populateBallFreeFall(BenchmarkScene& scene, int bodyCount) {
+    int side = freeFallGridSide(bodyCount);
+    float start = -(side - 1) * FREE_FALL_SPACING * 0.5f;
+
+    btCollisionShape* ground = scene.addShape(BulletCollisionShapes::CreatePlane(glm::vec3(0.0f, 1.0f, 0.0f), 0.0f));
+    scene.addBody(ground, 0.0f, glm::vec3(0.0f));
+
+    btCollisionShape* ball = scene.addShape(BulletCollisionShapes::CreateSphere(FREE_FALL_BALL_RADIUS));
+    for (int i = 0; i < bodyCount; ++i) {
+        int layer = i / (side * side);
+        int x = (i / side) % side;
+        int z = i % side;
+        glm::vec3 position(start + x * FREE_FALL_SPACING,
+                           5.0f + layer * FREE_FALL_SPACING,
+                           start + z * FREE_FALL_SPACING);
+        scene.addBody(ball, 1.0f, position);
+    }
+}
+
+const SceneLayout SCENES[] = {
+    {"BallCollision", ballCollisionBounds, populateBallCollision},
+    {"BallFreeFall", freeFallBounds, populateBallFreeFall},
+};
+
+const BroadphaseType BROADPHASES[] = {
+    BroadphaseType::Dbvt,
+    BroadphaseType::AxisSweep3,
+    BroadphaseType::AxisSweep3_32Bit,
+};
+
+double percentile(std::vector<double> samples, double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1) + 0.5);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+StepStatistics runBenchmark(const SceneLayout& layout, BroadphaseType broadphase, int bodyCount,
+                            const BenchmarkOptions& options) {
+    using Clock = std::chrono::steady_clock;
+
+    BulletWorldConfig config;
+    config.broadphase = broadphase;
+    config.debugLogging = false;
+    config.maxProxies = bodyCount + 16;
+    layout.computeBounds(bodyCount, config.worldMin, config.worldMax);
+
+    StepStatistics stats;
+
+    auto buildStart = Clock::now();
+    BenchmarkScene scene(config);
+    layout.populate(scene, bodyCount);
+    stats.buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count();
+
+    for (int i = 0; i < options.warmupFrames; ++i) {
+        scene.world().Update(FIXED_TIME_STEP, 1, FIXED_TIME_STEP);
+    }
+
+    std::vector<double> samples;
+    samples.reserve(options.frames);
+    for (int i = 0; i < options.frames; ++i) {
+        auto stepStart = Clock::now();
+        scene.world().Update(FIXED_TIME_STEP, 1, FIXED_TIME_STEP);
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - stepStart).count());
+    }
+
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    stats.meanMs = samples.empty() ? 0.0 : total / samples.size();
+    stats.p50Ms = percentile(samples, 0.50);
+    stats.p95Ms = percentile(samples, 0.95);
+    stats.maxMs = samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end());
+    stats.overlappingPairs = scene.world().GetBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs();
+    return stats;
+}
+
+std::vector<int> parseCounts(const std::string& text) {
+    std::vector<int> counts;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int count = std::atoi(item.c_str());
+        if (count > 0) {
+            counts.push_back(count);
+        }
+    }
+    return counts;
+}
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmupFrames = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--counts" && hasValue) {
+            options.bodyCounts = parseCounts(argv[++i]);
+        } else if (arg == "--scene" && hasValue) {
+            options.sceneFilter = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--frames N] [--warmup N] [--counts 1000,10000,50000] [--scene BallCollision|BallFreeFall]" << std::endl;
+            return false;
+        }
+    }
+    return !options.bodyCounts.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::cout << "=== Broadphase Benchmark ===" << std::endl;
+    std::cout << "Frames: " << options.frames << " (warmup " << options.warmupFrames << "), fixed step "
+              << FIXED_TIME_STEP << " s" << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(15) << "Scene" << std::setw(9) << "Bodies" << std::setw(20) << "Broadphase"
+              << std::right << std::setw(11) << "Build ms" << std::setw(11) << "Mean ms" << std::setw(11) << "P50 ms"
+              << std::setw(11) << "P95 ms" << std::setw(11) << "Max ms" << std::setw(10) << "Pairs" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (const SceneLayout& layout : SCENES) {
+        if (!options.sceneFilter.empty() && options.sceneFilter != layout.name) {
+            continue;
+        }
+
+        for (int bodyCount : options.bodyCounts) {
+            for (BroadphaseType broadphase : BROADPHASES) {
+                std::cout << std::left << std::setw(15) << layout.name << std::setw(9) << bodyCount
+                          << std::setw(20) << BulletWorld::GetBroadphaseName(broadphase) << std::right;
+
+                // The 16-bit sweep and prune cannot hold the scene's proxies
+                if (broadphase == BroadphaseType::AxisSweep3 && bodyCount + 16 > 32766) {
+                    std::cout << "  skipped (exceeds 16-bit proxy limit)" << std::endl;
+                    continue;
+                }
+
+                StepStatistics stats = runBenchmark(layout, broadphase, bodyCount, options);
+                std::cout << std::setw(11) << stats.buildMs << std::setw(11) << stats.meanMs
+                          << std::setw(11) << stats.p50Ms << std::setw(11) << stats.p95Ms
+                          << std::setw(11) << stats.maxMs << std::setw(10) << stats.overlappingPairs << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include "rendering/FrustumCuller.h"
+
+/**
+ * CullingBenchmark - Headless frustum culling benchmark
+ *
+ * Scatters bounding spheres and AABBs uniformly through a cube around a perspective
+ * camera (60 degree FOV, 16:9, far plane at half the cube size) and times the SIMD
+ * culler against the scalar reference. Every run also checks that both produce the
+ * same visible-index list, so the benchmark doubles as a correctness test.
+ *
+ * Usage: CullingBenchmark [--iterations N] [--warmup N] [--counts 10000,100000,1000000]
+ */
+
+namespace {
+
+constexpr float WORLD_HALF_SIZE = 1000.0f;
+constexpr float MIN_OBJECT_SIZE = 0.1f;
+constexpr float MAX_OBJECT_SIZE = 5.0f;
+
+struct BenchmarkOptions {
+    int iterations = 50;
+    int warmupIterations = 5;
+    std::vector<int> objectCounts = {10000, 100000, 1000000};
+};
+
+struct CullStatistics {
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    size_t visible = 0;
+};
+
+double percentile(std::vector<double> samples, double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1) + 0.5);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+template <typename CullFunction>
+CullStatistics runBenchmark(CullFunction cull, const BenchmarkOptions& options, std::vector<uint32_t>& visible) {
+    using Clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < options.warmupIterations; ++i) {
+        cull(visible);
+    }
+
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+    for (int i = 0; i < options.iterations; ++i) {
+        auto start = Clock::now();
+        cull(visible);
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    CullStatistics stats;
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    stats.meanMs = samples.empty() ? 0.0 : total / samples.size();
+    stats.p50Ms = percentile(samples, 0.50);
+    stats.p95Ms = percentile(samples, 0.95);
+    stats.visible = visible.size();
+    return stats;
+}
+
+void printRow(const char* bounds, int objectCount, const char* path, const CullStatistics& stats, double scalarMeanMs) {
+    double nsPerObject = stats.meanMs * 1.0e6 / objectCount;
+    std::cout << std::left << std::setw(9) << bounds << std::setw(10) << objectCount << std::setw(9) << path
+              << std::right << std::setw(11) << stats.meanMs << std::setw(11) << stats.p50Ms
+              << std::setw(11) << stats.p95Ms << std::setw(11) << nsPerObject << std::setw(10) << stats.visible
+              << std::setw(9) << scalarMeanMs / stats.meanMs << "x" << std::endl;
+}
+
+std::vector<int> parseCounts(const std::string& text) {
+    std::vector<int> counts;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int count = std::atoi(item.c_str());
+        if (count > 0) {
+            counts.push_back(count);
+        }
+    }
+    return counts;
+}
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--iterations" && hasValue) {
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmupIterations = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--counts" && hasValue) {
+            options.objectCounts = parseCounts(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--iterations N] [--warmup N] [--counts 10000,100000,1000000]" << std::endl;
+            return false;
+        }
+    }
+    return !options.objectCounts.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    // Camera in the middle of the object cloud looking down -Z, as Camera does by default
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, WORLD_HALF_SIZE * 0.5f);
+    Frustum frustum = Frustum::fromCamera(view, projection);
+
+    std::cout << "=== Culling Benchmark ===" << std::endl;
+    std::cout << "Iterations: " << options.iterations << " (warmup " << options.warmupIterations << "), SIMD path "
+              << FrustumCuller::getSimdPath() << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(9) << "Bounds" << std::setw(10) << "Objects" << std::setw(9) << "Path"
+              << std::right << std::setw(11) << "Mean ms" << std::setw(11) << "P50 ms" << std::setw(11) << "P95 ms"
+              << std::setw(11) << "ns/object" << std::setw(10) << "Visible" << std::setw(10) << "Speedup" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    bool mismatch = false;
+    for (int objectCount : options.objectCounts) {
+        // Same seed for every count, so smaller runs are prefixes of larger ones
+        std::mt19937 gen(1234);
+        std::uniform_real_distribution<float> posDist(-WORLD_HALF_SIZE, WORLD_HALF_SIZE);
+        std::uniform_real_distribution<float> sizeDist(MIN_OBJECT_SIZE, MAX_OBJECT_SIZE);
+
+        SphereBounds spheres;
+        AABBBounds boxes;
+        spheres.reserve(objectCount);
+        boxes.reserve(objectCount);
+        for (int i = 0; i < objectCount; ++i) {
+            glm::vec3 center(posDist(gen), posDist(gen), posDist(gen));
+            spheres.add(center, sizeDist(gen));
+            glm::vec3 halfExtents(sizeDist(gen), sizeDist(gen), sizeDist(gen));
+            boxes.add(center - halfExtents, center + halfExtents);
+        }
+
+        std::vector<uint32_t> scalarVisible;
+        std::vector<uint32_t> simdVisible;
+
+        CullStatistics scalar = runBenchmark([&](std::vector<uint32_t>& visible) {
+            FrustumCuller::cullSpheresScalar(frustum, spheres, visible);
+        }, options, scalarVisible);
+        CullStatistics simd = runBenchmark([&](std::vector<uint32_t>& visible) {
+            FrustumCuller::cullSpheres(frustum, spheres, visible);
+        }, options, simdVisible);
+        printRow("Sphere", objectCount, "scalar", scalar, scalar.meanMs);
+        printRow("Sphere", objectCount, FrustumCuller::getSimdPath(), simd, scalar.meanMs);
+        if (scalarVisible != simdVisible) {
+            std::cerr << "Sphere culling mismatch at " << objectCount << " objects!" << std::endl;
+            mismatch = true;
+        }
+
+        scalar = runBenchmark([&](std::vector<uint32_t>& visible) {
+            FrustumCuller::cullAABBsScalar(frustum, boxes, visible);
+        }, options, scalarVisible);
+        simd = runBenchmark([&](std::vector<uint32_t>& visible) {
+            FrustumCuller::cullAABBs(frustum, boxes, visible);
+        }, options, simdVisible);
+        printRow("AABB", objectCount, "scalar", scalar, scalar.meanMs);
+        printRow("AABB", objectCount, FrustumCuller::getSimdPath(), simd, scalar.meanMs);
+        if (scalarVisible != simdVisible) {
+            std::cerr << "AABB culling mismatch at " << objectCount << " objects!" << std::endl;
+            mismatch = true;
+        }
+    }
+
+    return mismatch ? 1 : 0;
+}
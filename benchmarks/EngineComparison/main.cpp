@@ -0,0 +1,715 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <glm/gtc/quaternion.hpp>
+#include "bullet/BulletWorld.h"
+#include "bullet/BulletCollisionShapes.h"
+#include "core/World.h"
+#include "core/CollisionSystem.h"
+#include "core/RigidBody3D.h"
+#include "shapes/Sphere.h"
+#include "shapes/Box.h"
+#include "utils/TerrainGenerator.h"
+
+/**
+ * EngineComparison - Headless A/B benchmark of the native engine against Bullet
+ *
+ * Builds the same scenario description in both backends, steps each for N frames
+ * and emits JSON with:
+ * - stepTimeMs: mean/p50/p95/p99/max wall time of one fixed step
+ * - energy: translational kinetic + potential energy (J) at the first and last frame,
+ *   the final drift relative to the start, and the largest gain seen (contacts only
+ *   dissipate, so any gain is integrator or solver error)
+ * - penetration: ground and body-body overlap (m) measured geometrically from the
+ *   body states after every step, so both backends are judged by the same rule
+ * - snapshotMs: mean wall time of BulletWorld::Snapshot and Restore on the final state
+ *   (Bullet only; the target is under 1 ms each at --bodies 10000)
+ *
+ * Scenarios:
+ * - FreeFall: spaced balls dropped from different heights onto a ground plane
+ * - BallPit: a dense column of balls with small random sideways velocities
+ * - BoxStack: towers of unit boxes resting on a ground plane
+ * - TerrainDrop: balls thrown onto a heightfield built by TerrainGenerator
+ *
+ * The native World only resolves a ground plane and CollisionSystem treats every body
+ * as a 0.5 m sphere, so balls use that radius, boxes collide with each other as their
+ * inscribed spheres and the heightfield is matched by the native ground plane (the
+ * generator is flat). Each result carries a note when its backend approximates.
+ *
+ * Usage: EngineComparison [--frames N] [--bodies N] [--scenario name] [--backend native|bullet] [--output file]
+ */
+
+namespace {
+
+constexpr float FIXED_TIME_STEP = 1.0f / 60.0f;
+constexpr float GRAVITY = 9.81f;
+
+// The radius CollisionSystem assumes for every body
+constexpr float BALL_RADIUS = 0.5f;
+constexpr float BOX_HALF_EXTENT = 0.5f;
+constexpr int TOWER_HEIGHT = 10;
+
+// Shared material; Bullet multiplies the two bodies' coefficients, so its ground uses 1.0
+constexpr float BODY_RESTITUTION = 0.1f;
+constexpr float BODY_FRICTION = 0.8f;
+
+// Snapshot/restore round trips timed at the end of a Bullet run
+constexpr int SNAPSHOT_REPEATS = 20;
+
+constexpr int TERRAIN_SAMPLES = 65;
+constexpr float TERRAIN_SPACING = 1.0f;
+
+struct BenchmarkOptions {
+    int frames = 600;
+    int bodies = 500;
+    std::string scenarioFilter;
+    std::string backendFilter;
+    std::string outputPath; // Empty = stdout
+};
+
+enum class ShapeKind { Sphere, Box };
+enum class GroundKind { Plane, Heightfield };
+
+struct BodyDesc {
+    ShapeKind kind;
+    float size;  // Radius or half extent
+    float mass;
+    glm::vec3 position;
+    glm::vec3 velocity;
+};
+
+// Backend independent scenario; both backends are built from the same description
+struct ScenarioDesc {
+    std::string name;
+    GroundKind ground = GroundKind::Plane;
+    std::vector<BodyDesc> bodies;
+};
+
+struct BodyState {
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 velocity;
+};
+
+class Backend {
+public:
+    virtual ~Backend() = default;
+    virtual const char* name() const = 0;
+    virtual void step(float dt) = 0;
+    virtual void readStates(std::vector<BodyState>& states) const = 0;
+    // Where this backend deviates from the scenario description (empty if it does not)
+    virtual std::string note(const ScenarioDesc& scenario) const = 0;
+    // Mean time of one snapshot and one restore of the current state; false if unsupported
+    virtual bool timeSnapshot(double&, double&) { return false; }
+};
+
+// World + CollisionSystem, stepped the way the native engine would be driven
+class NativeBackend : public Backend {
+public:
+    explicit NativeBackend(const ScenarioDesc& scenario)
+        : m_world(glm::vec3(0.0f, -GRAVITY, 0.0f)) {
+        m_world.groundLevel = 0.0f;
+
+        for (const BodyDesc& desc : scenario.bodies) {
+            std::unique_ptr<BaseShape> shape;
+            if (desc.kind == ShapeKind::Sphere) {
+                shape = std::make_unique<Sphere>(desc.size);
+            } else {
+                float edge = desc.size * 2.0f;
+                shape = std::make_unique<Box>(edge, edge, edge);
+            }
+
+            auto body = std::make_unique<RigidBody3D>(std::move(shape), desc.mass);
+            body->setPosition(desc.position);
+            body->setLinearVelocity(desc.velocity);
+            body->setRestitution(BODY_RESTITUTION);
+            body->setFriction(BODY_FRICTION);
+
+            // Bullet bodies are undamped by default
+            body->setLinearDamping(1.0f);
+            body->setAngularDamping(1.0f);
+
+            m_world.AddBody(body.get());
+            m_bodies.push_back(std::move(body));
+        }
+    }
+
+    const char* name() const override { return "native"; }
+
+    void step(float dt) override {
+        m_world.Update(dt);
+
+        // ResolveCollision squares the coefficient it is given
+        m_collisionSystem.CheckCollisions(m_world.bodies, m_contacts);
+        for (const CollisionSystem::CollisionInfo& contact : m_contacts) {
+            m_collisionSystem.ResolveCollision(contact, std::sqrt(BODY_RESTITUTION));
+        }
+    }
+
+    void readStates(std::vector<BodyState>& states) const override {
+        states.resize(m_bodies.size());
+        for (size_t i = 0; i < m_bodies.size(); ++i) {
+            states[i] = {m_bodies[i]->getPosition(), m_bodies[i]->getRotation(), m_bodies[i]->getLinearVelocity()};
+        }
+    }
+
+    std::string note(const ScenarioDesc& scenario) const override {
+        std::string text;
+        for (const BodyDesc& desc : scenario.bodies) {
+            if (desc.kind == ShapeKind::Box) {
+                text = "boxes collide with each other as inscribed spheres";
+                break;
+            }
+        }
+        if (scenario.ground == GroundKind::Heightfield) {
+            text += text.empty() ? "" : "; ";
+            text += "heightfield replaced by the ground plane at Y = 0";
+        }
+        return text;
+    }
+
+private:
+    World m_world;
+    CollisionSystem m_collisionSystem;
+    std::vector<std::unique_ptr<RigidBody3D>> m_bodies;
+    std::vector<CollisionSystem::CollisionInfo> m_contacts;
+};
+
+// BulletWorld with the default solver (same setup as BroadphaseBenchmark)
+class BulletBackend : public Backend {
+public:
+    explicit BulletBackend(const ScenarioDesc& scenario) {
+        BulletWorldConfig config;
+        config.debugLogging = false;
+        m_world = std::make_unique<BulletWorld>(config);
+
+        if (scenario.ground == GroundKind::Heightfield) {
+            m_heights.resize(TERRAIN_SAMPLES * TERRAIN_SAMPLES);
+            float half = (TERRAIN_SAMPLES - 1) * TERRAIN_SPACING * 0.5f;
+            for (int z = 0; z < TERRAIN_SAMPLES; ++z) {
+                for (int x = 0; x < TERRAIN_SAMPLES; ++x) {
+                    m_heights[z * TERRAIN_SAMPLES + x] = TerrainGenerator::getHeight(
+                        x * TERRAIN_SPACING - half, z * TERRAIN_SPACING - half, TERRAIN_SPACING, 1.0f, 0.5f);
+                }
+            }
+            auto range = std::minmax_element(m_heights.begin(), m_heights.end());
+            btCollisionShape* terrain = addShape(BulletCollisionShapes::CreateHeightfield(
+                m_heights.data(), TERRAIN_SAMPLES, TERRAIN_SAMPLES, TERRAIN_SPACING, *range.first, *range.second));
+
+            // Bullet centers the height range on the body origin
+            addGround(terrain, glm::vec3(0.0f, 0.5f * (*range.first + *range.second), 0.0f));
+        } else {
+            addGround(addShape(BulletCollisionShapes::CreatePlane(glm::vec3(0.0f, 1.0f, 0.0f), 0.0f)), glm::vec3(0.0f));
+        }
+
+        // One shape per distinct size, shared by all bodies using it
+        btCollisionShape* ballShape = nullptr;
+        btCollisionShape* boxShape = nullptr;
+        for (const BodyDesc& desc : scenario.bodies) {
+            btCollisionShape*& shared = desc.kind == ShapeKind::Sphere ? ballShape : boxShape;
+            if (!shared) {
+                shared = addShape(desc.kind == ShapeKind::Sphere ? static_cast<btCollisionShape*>(BulletCollisionShapes::CreateSphere(desc.size))
+                                                                 : BulletCollisionShapes::CreateBox(glm::vec3(desc.size)));
+            }
+            m_dynamicBodies.push_back(addBody(shared, desc.mass, desc.position, desc.velocity));
+        }
+    }
+
+    ~BulletBackend() override {
+        for (btRigidBody* body : m_bodies) {
+            m_world->RemoveRigidBody(body);
+            delete body->getMotionState();
+            delete body;
+        }
+        for (btCollisionShape* shape : m_shapes) {
+            BulletCollisionShapes::DeleteShape(shape);
+        }
+    }
+
+    const char* name() const override { return "bullet"; }
+
+    void step(float dt) override {
+        m_world->Update(dt, 1, dt);
+    }
+
+    void readStates(std::vector<BodyState>& states) const override {
+        states.resize(m_dynamicBodies.size());
+        for (size_t i = 0; i < m_dynamicBodies.size(); ++i) {
+            const btTransform& transform = m_dynamicBodies[i]->getWorldTransform();
+            const btVector3& origin = transform.getOrigin();
+            btQuaternion rotation = transform.getRotation();
+            const btVector3& velocity = m_dynamicBodies[i]->getLinearVelocity();
+            states[i] = {glm::vec3(origin.x(), origin.y(), origin.z()),
+                         glm::quat(rotation.w(), rotation.x(), rotation.y(), rotation.z()),
+                         glm::vec3(velocity.x(), velocity.y(), velocity.z())};
+        }
+    }
+
+    std::string note(const ScenarioDesc&) const override { return ""; }
+
+    bool timeSnapshot(double& snapshotMs, double& restoreMs) override {
+        using Clock = std::chrono::steady_clock;
+
+        // The first snapshot sizes the reused buffer; restoring the state just saved
+        // leaves the world unchanged
+        m_world->Snapshot(m_snapshot);
+        snapshotMs = 0.0;
+        restoreMs = 0.0;
+        for (int i = 0; i < SNAPSHOT_REPEATS; ++i) {
+            auto start = Clock::now();
+            m_world->Snapshot(m_snapshot);
+            auto snapshotEnd = Clock::now();
+            if (!m_world->Restore(m_snapshot)) {
+                return false;
+            }
+            snapshotMs += std::chrono::duration<double, std::milli>(snapshotEnd - start).count();
+            restoreMs += std::chrono::duration<double, std::milli>(Clock::now() - snapshotEnd).count();
+        }
+        snapshotMs /= SNAPSHOT_REPEATS;
+        restoreMs /= SNAPSHOT_REPEATS;
+        return true;
+    }
+
+private:
+    std::unique_ptr<BulletWorld> m_world;
+    std::vector<btCollisionShape*> m_shapes;
+    std::vector<btRigidBody*> m_bodies;
+    std::vector<btRigidBody*> m_dynamicBodies;  // In scenario order
+    std::vector<float> m_heights;               // Referenced by the heightfield shape
+    std::vector<uint8_t> m_snapshot;
+
+    btCollisionShape* addShape(btCollisionShape* shape) {
+        m_shapes.push_back(shape);
+        return shape;
+    }
+
+    void addGround(btCollisionShape* shape, const glm::vec3& position) {
+        btRigidBody* ground = addBody(shape, 0.0f, position, glm::vec3(0.0f));
+        ground->setRestitution(1.0f);
+        ground->setFriction(1.0f);
+    }
+
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const glm::vec3& position, const glm::vec3& velocity) {
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(btVector3(position.x, position.y, position.z));
+
+        btVector3 inertia(0, 0, 0);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+
+        btDefaultMotionState* motionState = new btDefaultMotionState(transform);
+        btRigidBody::btRigidBodyConstructionInfo info(mass, motionState, shape, inertia);
+        btRigidBody* body = new btRigidBody(info);
+
+        // No rolling or spinning friction: the native engine has no model for either
+        body->setRestitution(BODY_RESTITUTION);
+        body->setFriction(BODY_FRICTION);
+        body->setLinearVelocity(btVector3(velocity.x, velocity.y, velocity.z));
+
+        m_world->AddRigidBody(body);
+        m_bodies.push_back(body);
+        return body;
+    }
+};
+
+// Scenario construction; bodies scales the body count of every scenario
+
+int gridSide(int count, int layers) {
+    return std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count) / layers))));
+}
+
+ScenarioDesc buildFreeFall(int bodies) {
+    ScenarioDesc scenario;
+    scenario.name = "FreeFall";
+
+    // 3 m apart so balls only ever touch the ground
+    int side = gridSide(bodies, 1);
+    float start = -(side - 1) * 1.5f;
+    for (int i = 0; i < bodies; ++i) {
+        glm::vec3 position(start + (i / side) * 3.0f, 5.0f + (i % 7) * 1.5f, start + (i % side) * 3.0f);
+        scenario.bodies.push_back({ShapeKind::Sphere, BALL_RADIUS, 1.0f, position, glm::vec3(0.0f)});
+    }
+    return scenario;
+}
+
+ScenarioDesc buildBallPit(int bodies) {
+    ScenarioDesc scenario;
+    scenario.name = "BallPit";
+
+    // Fixed seed so both backends and every run get the same velocities
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+
+    const float spacing = BALL_RADIUS * 2.1f;
+    int side = gridSide(bodies, 10);
+    float start = -(side - 1) * spacing * 0.5f;
+    for (int i = 0; i < bodies; ++i) {
+        int layer = i / (side * side);
+        int x = (i / side) % side;
+        int z = i % side;
+        glm::vec3 position(start + x * spacing, BALL_RADIUS + 0.5f + layer * spacing, start + z * spacing);
+        glm::vec3 velocity(jitter(random), 0.0f, jitter(random));
+        scenario.bodies.push_back({ShapeKind::Sphere, BALL_RADIUS, 1.0f, position, velocity});
+    }
+    return scenario;
+}
+
+ScenarioDesc buildBoxStack(int bodies) {
+    ScenarioDesc scenario;
+    scenario.name = "BoxStack";
+
+    // Boxes start exactly at rest, so any motion is solver error
+    int towers = std::max(1, (bodies + TOWER_HEIGHT - 1) / TOWER_HEIGHT);
+    int side = gridSide(towers, 1);
+    float start = -(side - 1) * 1.0f;
+    for (int i = 0; i < bodies; ++i) {
+        int tower = i / TOWER_HEIGHT;
+        int level = i % TOWER_HEIGHT;
+        glm::vec3 position(start + (tower / side) * 2.0f, BOX_HALF_EXTENT * (2 * level + 1), start + (tower % side) * 2.0f);
+        scenario.bodies.push_back({ShapeKind::Box, BOX_HALF_EXTENT, 1.0f, position, glm::vec3(0.0f)});
+    }
+    return scenario;
+}
+
+ScenarioDesc buildTerrainDrop(int bodies) {
+    ScenarioDesc scenario;
+    scenario.name = "TerrainDrop";
+    scenario.ground = GroundKind::Heightfield;
+
+    std::mt19937 random(5678);
+    std::uniform_real_distribution<float> jitter(-2.0f, 2.0f);
+
+    // Spread over the heightfield (64 m across) in a few layers
+    const float spacing = 1.5f;
+    int side = std::min(gridSide(bodies, 4), static_cast<int>((TERRAIN_SAMPLES - 5) * TERRAIN_SPACING / spacing));
+    float start = -(side - 1) * spacing * 0.5f;
+    for (int i = 0; i < bodies; ++i) {
+        int layer = i / (side * side);
+        int x = (i / side) % side;
+        int z = i % side;
+        glm::vec3 position(start + x * spacing, 8.0f + layer * spacing, start + z * spacing);
+        glm::vec3 velocity(jitter(random), -2.0f, jitter(random));
+        scenario.bodies.push_back({ShapeKind::Sphere, BALL_RADIUS, 1.0f, position, velocity});
+    }
+    return scenario;
+}
+
+struct ScenarioFactory {
+    const char* name;
+    ScenarioDesc (*build)(int bodies);
+};
+
+const ScenarioFactory SCENARIOS[] = {
+    {"FreeFall", buildFreeFall},
+    {"BallPit", buildBallPit},
+    {"BoxStack", buildBoxStack},
+    {"TerrainDrop", buildTerrainDrop},
+};
+
+// Measurements (identical for both backends)
+
+struct StepTimes {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+struct EnergyStatistics {
+    double initial = 0.0;
+    double final = 0.0;
+    double relativeDrift = 0.0;    // (final - initial) / |initial|
+    double maxRelativeGain = 0.0;  // Largest (E - initial) / |initial| over the run
+};
+
+struct PenetrationStatistics {
+    double mean = 0.0;            // Average depth of overlapping pairs
+    double max = 0.0;             // Deepest overlap seen during the run
+    double meanOverlapsPerFrame = 0.0;
+};
+
+struct SnapshotTimes {
+    bool measured = false;
+    double snapshot = 0.0;
+    double restore = 0.0;
+};
+
+struct BenchmarkResult {
+    std::string scenario;
+    std::string backend;
+    std::string note;
+    size_t bodyCount = 0;
+    StepTimes stepTimeMs;
+    EnergyStatistics energy;
+    PenetrationStatistics penetration;
+    SnapshotTimes snapshotMs;
+};
+
+double percentile(std::vector<double> samples, double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1) + 0.5);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+double mechanicalEnergy(const ScenarioDesc& scenario, const std::vector<BodyState>& states) {
+    double energy = 0.0;
+    for (size_t i = 0; i < states.size(); ++i) {
+        float mass = scenario.bodies[i].mass;
+        energy += 0.5 * mass * glm::dot(states[i].velocity, states[i].velocity) + mass * GRAVITY * states[i].position.y;
+    }
+    return energy;
+}
+
+// World space half extents of a body's bounds
+glm::vec3 worldHalfExtents(const BodyDesc& desc, const BodyState& state) {
+    if (desc.kind == ShapeKind::Sphere) {
+        return glm::vec3(desc.size);
+    }
+    glm::mat3 rotation = glm::mat3_cast(state.rotation);
+    glm::vec3 extents(0.0f);
+    for (int axis = 0; axis < 3; ++axis) {
+        extents += glm::abs(rotation[axis]) * desc.size;
+    }
+    return extents;
+}
+
+// Accumulates the overlap depth of every body against the ground (Y = 0) and every
+// overlapping pair. Sphere pairs are exact; pairs with a box use the smallest axis of
+// their world bounds overlap, which is exact while boxes stay axis aligned.
+void measurePenetration(const ScenarioDesc& scenario, const std::vector<BodyState>& states,
+                        double& depthSum, long long& overlapCount, double& maxDepth) {
+    struct Bounds {
+        glm::vec3 min;
+        glm::vec3 max;
+        size_t index;
+    };
+
+    std::vector<Bounds> bounds(states.size());
+    for (size_t i = 0; i < states.size(); ++i) {
+        glm::vec3 extents = worldHalfExtents(scenario.bodies[i], states[i]);
+        bounds[i] = {states[i].position - extents, states[i].position + extents, i};
+
+        float groundDepth = -bounds[i].min.y;
+        if (groundDepth > 0.0f) {
+            depthSum += groundDepth;
+            overlapCount++;
+            maxDepth = std::max(maxDepth, static_cast<double>(groundDepth));
+        }
+    }
+
+    // Sweep along X
+    std::sort(bounds.begin(), bounds.end(), [](const Bounds& a, const Bounds& b) { return a.min.x < b.min.x; });
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        for (size_t j = i + 1; j < bounds.size() && bounds[j].min.x < bounds[i].max.x; ++j) {
+            const BodyDesc& a = scenario.bodies[bounds[i].index];
+            const BodyDesc& b = scenario.bodies[bounds[j].index];
+
+            float depth;
+            if (a.kind == ShapeKind::Sphere && b.kind == ShapeKind::Sphere) {
+                depth = a.size + b.size - glm::length(states[bounds[i].index].position - states[bounds[j].index].position);
+            } else {
+                glm::vec3 overlap = glm::min(bounds[i].max, bounds[j].max) - glm::max(bounds[i].min, bounds[j].min);
+                depth = std::min(overlap.x, std::min(overlap.y, overlap.z));
+            }
+
+            if (depth > 0.0f) {
+                depthSum += depth;
+                overlapCount++;
+                maxDepth = std::max(maxDepth, static_cast<double>(depth));
+            }
+        }
+    }
+}
+
+BenchmarkResult runBenchmark(const ScenarioDesc& scenario, Backend& backend, const BenchmarkOptions& options) {
+    using Clock = std::chrono::steady_clock;
+
+    BenchmarkResult result;
+    result.scenario = scenario.name;
+    result.backend = backend.name();
+    result.note = backend.note(scenario);
+    result.bodyCount = scenario.bodies.size();
+
+    std::vector<BodyState> states;
+    backend.readStates(states);
+    double initialEnergy = mechanicalEnergy(scenario, states);
+    double energyScale = std::max(std::abs(initialEnergy), 1e-6);
+    double energy = initialEnergy;
+
+    std::vector<double> samples;
+    samples.reserve(options.frames);
+    double depthSum = 0.0;
+    long long overlapCount = 0;
+
+    for (int frame = 0; frame < options.frames; ++frame) {
+        auto stepStart = Clock::now();
+        backend.step(FIXED_TIME_STEP);
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - stepStart).count());
+
+        backend.readStates(states);
+        energy = mechanicalEnergy(scenario, states);
+        result.energy.maxRelativeGain = std::max(result.energy.maxRelativeGain, (energy - initialEnergy) / energyScale);
+        measurePenetration(scenario, states, depthSum, overlapCount, result.penetration.max);
+    }
+
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    result.stepTimeMs.mean = samples.empty() ? 0.0 : total / samples.size();
+    result.stepTimeMs.p50 = percentile(samples, 0.50);
+    result.stepTimeMs.p95 = percentile(samples, 0.95);
+    result.stepTimeMs.p99 = percentile(samples, 0.99);
+    result.stepTimeMs.max = samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end());
+
+    result.energy.initial = initialEnergy;
+    result.energy.final = energy;
+    result.energy.relativeDrift = (energy - initialEnergy) / energyScale;
+
+    result.penetration.mean = overlapCount > 0 ? depthSum / overlapCount : 0.0;
+    result.penetration.meanOverlapsPerFrame = static_cast<double>(overlapCount) / options.frames;
+
+    // Measured after the run so it cannot disturb the step timings
+    result.snapshotMs.measured = backend.timeSnapshot(result.snapshotMs.snapshot, result.snapshotMs.restore);
+    if (result.snapshotMs.measured) {
+        std::cerr << "  Snapshot " << result.snapshotMs.snapshot << " ms, restore " << result.snapshotMs.restore
+                  << " ms for " << result.bodyCount << " bodies (target < 1 ms at 10000)" << std::endl;
+    }
+    return result;
+}
+
+// JSON output
+
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void writeJson(std::ostream& out, const BenchmarkOptions& options, const std::vector<BenchmarkResult>& results) {
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"benchmark\": \"EngineComparison\",\n";
+    out << "  \"frames\": " << options.frames << ",\n";
+    out << "  \"timeStep\": " << FIXED_TIME_STEP << ",\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\n";
+        out << "      \"scenario\": " << jsonString(r.scenario) << ",\n";
+        out << "      \"backend\": " << jsonString(r.backend) << ",\n";
+        out << "      \"bodies\": " << r.bodyCount << ",\n";
+        out << "      \"note\": " << jsonString(r.note) << ",\n";
+        out << "      \"stepTimeMs\": {\"mean\": " << r.stepTimeMs.mean << ", \"p50\": " << r.stepTimeMs.p50
+            << ", \"p95\": " << r.stepTimeMs.p95 << ", \"p99\": " << r.stepTimeMs.p99
+            << ", \"max\": " << r.stepTimeMs.max << "},\n";
+        out << "      \"energy\": {\"initial\": " << r.energy.initial << ", \"final\": " << r.energy.final
+            << ", \"relativeDrift\": " << r.energy.relativeDrift
+            << ", \"maxRelativeGain\": " << r.energy.maxRelativeGain << "},\n";
+        out << "      \"penetration\": {\"mean\": " << r.penetration.mean << ", \"max\": " << r.penetration.max
+            << ", \"meanOverlapsPerFrame\": " << r.penetration.meanOverlapsPerFrame << "},\n";
+        out << "      \"snapshotMs\": ";
+        if (r.snapshotMs.measured) {
+            out << "{\"snapshot\": " << r.snapshotMs.snapshot << ", \"restore\": " << r.snapshotMs.restore << "}\n";
+        } else {
+            out << "null\n";
+        }
+        out << "    }";
+    }
+    out << "\n  ]\n";
+    out << "}\n";
+}
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--bodies" && hasValue) {
+            options.bodies = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--scenario" && hasValue) {
+            options.scenarioFilter = argv[++i];
+        } else if (arg == "--backend" && hasValue) {
+            options.backendFilter = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            options.outputPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--frames N] [--bodies N] [--scenario FreeFall|BallPit|BoxStack|TerrainDrop]"
+                      << " [--backend native|bullet] [--output file]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    // Progress goes to stderr so stdout stays valid JSON
+    std::vector<BenchmarkResult> results;
+    for (const ScenarioFactory& factory : SCENARIOS) {
+        if (!options.scenarioFilter.empty() && options.scenarioFilter != factory.name) {
+            continue;
+        }
+
+        ScenarioDesc scenario = factory.build(options.bodies);
+        for (const char* backendName : {"native", "bullet"}) {
+            if (!options.backendFilter.empty() && options.backendFilter != backendName) {
+                continue;
+            }
+
+            std::cerr << "Running " << scenario.name << " (" << scenario.bodies.size() << " bodies) on "
+                      << backendName << "..." << std::endl;
+
+            std::unique_ptr<Backend> backend;
+            if (std::string(backendName) == "native") {
+                backend = std::make_unique<NativeBackend>(scenario);
+            } else {
+                backend = std::make_unique<BulletBackend>(scenario);
+            }
+            results.push_back(runBenchmark(scenario, *backend, options));
+        }
+    }
+
+    if (options.outputPath.empty()) {
+        writeJson(std::cout, options, results);
+        return 0;
+    }
+
+    std::ofstream file(options.outputPath);
+    if (!file) {
+        std::cerr << "EngineComparison: Failed to open " << options.outputPath << "!" << std::endl;
+        return 1;
+    }
+    writeJson(file, options, results);
+    std::cerr << "Results written to " << options.outputPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "rendering/RenderQueue.h"
+#include "rendering/RecordingRenderBackend.h"
+
+/**
+ * RenderQueueBenchmark - Headless render queue benchmark
+ *
+ * Submits draw commands spread over a handful of programs, vertex arrays and colors in
+ * random order (mostly opaque, some background and transparent), then times
+ * RenderQueue::sort() (radix sort, comparison sort for small queues) against
+ * std::stable_sort and executes the queue on a RecordingRenderBackend.
+ * State changes are counted with sorting on and off. Every run checks that the radix
+ * sort matches the reference order, and replays the recorded calls to check that each
+ * draw saw the pass, program, vertex array and uniform values of the command in its
+ * position, so the benchmark doubles as a correctness test.
+ *
+ * Usage: RenderQueueBenchmark [--iterations N] [--warmup N] [--counts 1000,10000,100000]
+ *                             [--programs N] [--meshes N]
+ */
+
+namespace {
+
+constexpr float MAX_DEPTH = 500.0f;
+constexpr int COLOR_COUNT = 16;
+
+struct BenchmarkOptions {
+    int iterations = 20;
+    int warmupIterations = 3;
+    int programCount = 8;
+    int meshCount = 64;
+    std::vector<int> commandCounts = {1000, 10000, 100000};
+};
+
+struct TimingStatistics {
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+};
+
+double percentile(std::vector<double> samples, double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1) + 0.5);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+// Times work(), calling prepare() untimed before each run
+template <typename PrepareFunction, typename WorkFunction>
+TimingStatistics runBenchmark(PrepareFunction prepare, WorkFunction work, const BenchmarkOptions& options) {
+    using Clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < options.warmupIterations; ++i) {
+        prepare();
+        work();
+    }
+
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+    for (int i = 0; i < options.iterations; ++i) {
+        prepare();
+        auto start = Clock::now();
+        work();
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    TimingStatistics stats;
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    stats.meanMs = samples.empty() ? 0.0 : total / samples.size();
+    stats.p50Ms = percentile(samples, 0.50);
+    stats.p95Ms = percentile(samples, 0.95);
+    return stats;
+}
+
+struct SubmittedCommand {
+    RenderCommand command;
+    float depth;
+};
+
+// Commands tagged with their submission index in `first`, which the recording backend ignores
+std::vector<SubmittedCommand> generateCommands(int count, const BenchmarkOptions& options) {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> programDist(1, options.programCount);
+    std::uniform_int_distribution<int> meshDist(1, options.meshCount);
+    std::uniform_int_distribution<int> colorDist(0, COLOR_COUNT - 1);
+    std::uniform_int_distribution<int> passDist(0, 99);
+    std::uniform_real_distribution<float> depthDist(0.0f, MAX_DEPTH);
+
+    std::vector<SubmittedCommand> commands(count);
+    for (int i = 0; i < count; ++i) {
+        RenderCommand& command = commands[i].command;
+        int pass = passDist(gen);
+        command.pass = pass < 2 ? RenderPass::Background : (pass < 90 ? RenderPass::Opaque : RenderPass::Transparent);
+        command.program = programDist(gen);
+        command.vertexArray = meshDist(gen);
+        command.indexType = 0x1405;  // GL_UNSIGNED_INT
+        command.indexSize = sizeof(unsigned int);
+        command.first = i;
+        command.count = 36;
+        command.modelLocation = 0;
+        command.colorLocation = 1;
+        command.model[3] = glm::vec4(static_cast<float>(i), 0.0f, 0.0f, 1.0f);
+        command.color = glm::vec3(colorDist(gen) / static_cast<float>(COLOR_COUNT));
+        commands[i].depth = depthDist(gen);
+    }
+    return commands;
+}
+
+void submitAll(RenderQueue& queue, const std::vector<SubmittedCommand>& commands) {
+    queue.clear();
+    for (const SubmittedCommand& submitted : commands) {
+        queue.submit(submitted.command, submitted.depth);
+    }
+}
+
+uint64_t sortKey(const SubmittedCommand& submitted) {
+    const RenderCommand& command = submitted.command;
+    return RenderQueue::makeSortKey(command.pass, command.program, command.vertexArray, submitted.depth);
+}
+
+// Submission indices in key order: a stable comparison sort on the same keys
+std::vector<size_t> referenceOrder(const std::vector<SubmittedCommand>& commands) {
+    std::vector<size_t> order(commands.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return sortKey(commands[a]) < sortKey(commands[b]); });
+    return order;
+}
+
+// The radix sort must equal the reference order
+bool checkSortOrder(RenderQueue& queue, const std::vector<SubmittedCommand>& commands, const std::vector<size_t>& order) {
+    submitAll(queue, commands);
+    queue.sort();
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (queue.getSortedKey(i) != sortKey(commands[order[i]]) || queue.getSortedCommand(i).first != order[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Replays the recorded calls through a model of the GL state. Draw i must see the pass,
+// program, vertex array and uniform values of the command at position i of order, the
+// queue must leave the default state behind, and the call counts must match its statistics.
+bool checkExecution(const RenderQueue& queue, const RecordingRenderBackend& backend,
+                    const std::vector<SubmittedCommand>& commands, const std::vector<size_t>& order) {
+    using Call = RecordingRenderBackend::Call;
+
+    // Uniform values belong to the program they were set on, keyed by (program, location)
+    std::map<std::pair<size_t, size_t>, glm::mat4> matrices;
+    std::map<std::pair<size_t, size_t>, glm::vec3> vectors;
+    size_t pass = static_cast<size_t>(RenderPass::Opaque);
+    size_t program = 0;
+    size_t vertexArray = 0;
+    size_t draws = 0;
+
+    for (const RecordingRenderBackend::Record& record : backend.getRecords()) {
+        switch (record.call) {
+            case Call::SetPass:
+                pass = record.value;
+                break;
+            case Call::BindProgram:
+                program = record.value;
+                break;
+            case Call::BindVertexArray:
+                vertexArray = record.value;
+                break;
+            case Call::SetUniformMat4:
+                matrices[{program, record.value}] = backend.getMatrices()[record.argument];
+                break;
+            case Call::SetUniformVec3:
+                vectors[{program, record.value}] = backend.getVectors()[record.argument];
+                break;
+            case Call::DrawArrays:
+            case Call::DrawElements: {
+                if (draws >= order.size()) {
+                    return false;
+                }
+                const RenderCommand& command = commands[order[draws++]].command;
+                bool indexed = record.call == Call::DrawElements;
+                size_t offset = indexed ? command.first * command.indexSize : command.first;
+                if (pass != static_cast<size_t>(command.pass) || program != command.program ||
+                    vertexArray != command.vertexArray || indexed != (command.indexType != 0) ||
+                    record.value != command.count || record.argument != offset) {
+                    return false;
+                }
+                if (command.modelLocation != -1) {
+                    auto model = matrices.find({program, static_cast<size_t>(command.modelLocation)});
+                    if (model == matrices.end() || model->second != command.model) {
+                        return false;
+                    }
+                }
+                if (command.colorLocation != -1) {
+                    auto color = vectors.find({program, static_cast<size_t>(command.colorLocation)});
+                    if (color == vectors.end() || color->second != command.color) {
+                        return false;
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    const RenderQueue::Statistics& stats = queue.getStatistics();
+    return draws == order.size() && stats.drawCalls == order.size() &&
+           pass == static_cast<size_t>(RenderPass::Opaque) && vertexArray == 0 &&
+           backend.getCount(Call::BindProgram) == stats.programBinds &&
+           backend.getCount(Call::SetUniformMat4) + backend.getCount(Call::SetUniformVec3) == stats.uniformUploads;
+}
+
+void printTiming(const char* stage, int commandCount, const TimingStatistics& stats, double baselineMeanMs) {
+    double nsPerCommand = stats.meanMs * 1.0e6 / commandCount;
+    std::cout << std::left << std::setw(19) << stage << std::setw(10) << commandCount
+              << std::right << std::setw(11) << stats.meanMs << std::setw(11) << stats.p50Ms
+              << std::setw(11) << stats.p95Ms << std::setw(12) << nsPerCommand
+              << std::setw(9) << baselineMeanMs / stats.meanMs << "x" << std::endl;
+}
+
+struct StateResult {
+    int commandCount;
+    RenderQueue::Statistics sorted;
+    RenderQueue::Statistics unsorted;
+    size_t sortedStateCalls;    // Pass, program and vertex array calls the backend received
+    size_t unsortedStateCalls;
+};
+
+void printState(const char* order, int commandCount, const RenderQueue::Statistics& stats, size_t stateCalls) {
+    std::cout << std::left << std::setw(18) << order << std::setw(10) << commandCount << std::right
+              << std::setw(9) << stats.passChanges << std::setw(10) << stats.programBinds
+              << std::setw(10) << stats.vertexArrayBinds << std::setw(10) << stats.uniformUploads
+              << std::setw(14) << stateCalls << std::setw(10) << stats.redundantChangesSkipped << std::endl;
+}
+
+std::vector<int> parseCounts(const std::string& text) {
+    std::vector<int> counts;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int count = std::atoi(item.c_str());
+        if (count > 0) {
+            counts.push_back(count);
+        }
+    }
+    return counts;
+}
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--iterations" && hasValue) {
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmupIterations = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--counts" && hasValue) {
+            options.commandCounts = parseCounts(argv[++i]);
+        } else if (arg == "--programs" && hasValue) {
+            options.programCount = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--meshes" && hasValue) {
+            options.meshCount = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--iterations N] [--warmup N] [--counts 1000,10000,100000]"
+                      << " [--programs N] [--meshes N]" << std::endl;
+            return false;
+        }
+    }
+    return !options.commandCounts.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::cout << "=== Render Queue Benchmark ===" << std::endl;
+    std::cout << "Iterations: " << options.iterations << " (warmup " << options.warmupIterations << "), "
+              << options.programCount << " programs, " << options.meshCount << " meshes, "
+              << COLOR_COUNT << " colors" << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(19) << "Stage" << std::setw(10) << "Commands"
+              << std::right << std::setw(11) << "Mean ms" << std::setw(11) << "P50 ms" << std::setw(11) << "P95 ms"
+              << std::setw(12) << "ns/command" << std::setw(10) << "Speedup" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    bool failed = false;
+    std::vector<StateResult> stateResults;
+    for (int commandCount : options.commandCounts) {
+        std::vector<SubmittedCommand> commands = generateCommands(commandCount, options);
+        RenderQueue queue;
+
+        std::vector<size_t> order = referenceOrder(commands);
+        if (!checkSortOrder(queue, commands, order)) {
+            std::cerr << "Radix sort order mismatch at " << commandCount << " commands!" << std::endl;
+            failed = true;
+        }
+
+        // Reference: std::stable_sort on the same (key, index) pairs
+        std::vector<std::pair<uint64_t, uint32_t>> keys(commands.size());
+        TimingStatistics reference = runBenchmark([&]() {
+            for (size_t i = 0; i < commands.size(); ++i) {
+                const RenderCommand& command = commands[i].command;
+                keys[i] = {RenderQueue::makeSortKey(command.pass, command.program, command.vertexArray,
+                                                    commands[i].depth), static_cast<uint32_t>(i)};
+            }
+        }, [&]() {
+            std::stable_sort(keys.begin(), keys.end(),
+                             [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b) {
+                                 return a.first < b.first;
+                             });
+        }, options);
+        TimingStatistics submit = runBenchmark([&]() { queue.clear(); }, [&]() { submitAll(queue, commands); }, options);
+        TimingStatistics radix = runBenchmark([&]() { submitAll(queue, commands); }, [&]() { queue.sort(); }, options);
+
+        RecordingRenderBackend backend;
+        TimingStatistics execute = runBenchmark([&]() {
+            submitAll(queue, commands);
+            queue.sort();
+            backend.reset();
+        }, [&]() { queue.execute(backend); }, options);
+
+        printTiming("submit", commandCount, submit, submit.meanMs);
+        printTiming("std::stable_sort", commandCount, reference, reference.meanMs);
+        printTiming("RenderQueue::sort", commandCount, radix, reference.meanMs);
+        printTiming("execute (record)", commandCount, execute, execute.meanMs);
+
+        // State changes with and without sorting
+        if (!checkExecution(queue, backend, commands, order)) {
+            std::cerr << "Sorted execution does not replay to the sorted commands at " << commandCount << " commands!" << std::endl;
+            failed = true;
+        }
+        StateResult result;
+        result.commandCount = commandCount;
+        result.sorted = queue.getStatistics();
+        result.sortedStateCalls = backend.getStateChanges();
+
+        queue.setSortingEnabled(false);
+        submitAll(queue, commands);
+        backend.reset();
+        queue.execute(backend);
+        result.unsorted = queue.getStatistics();
+        result.unsortedStateCalls = backend.getStateChanges();
+        std::vector<size_t> submissionOrder(commands.size());
+        std::iota(submissionOrder.begin(), submissionOrder.end(), 0);
+        if (!checkExecution(queue, backend, commands, submissionOrder)) {
+            std::cerr << "Unsorted execution does not replay to the submitted commands at " << commandCount << " commands!" << std::endl;
+            failed = true;
+        }
+        stateResults.push_back(result);
+        if (result.sortedStateCalls > result.unsortedStateCalls) {
+            std::cerr << "Sorting increased state changes at " << commandCount << " commands!" << std::endl;
+            failed = true;
+        }
+    }
+
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(18) << "Order" << std::setw(10) << "Commands" << std::right
+              << std::setw(9) << "Passes" << std::setw(10) << "Programs" << std::setw(10) << "VAOs"
+              << std::setw(10) << "Uniforms" << std::setw(14) << "State calls" << std::setw(10) << "Skipped"
+              << std::endl;
+    for (const StateResult& result : stateResults) {
+        printState("submission", result.commandCount, result.unsorted, result.unsortedStateCalls);
+        printState("sort key", result.commandCount, result.sorted, result.sortedStateCalls);
+    }
+
+    return failed ? 1 : 0;
+}
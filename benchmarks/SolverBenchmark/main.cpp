@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "bullet/BulletWorld.h"
+#include "bullet/BulletCollisionShapes.h"
+
+/**
+ * SolverBenchmark - Headless constraint solver comparison
+ *
+ * Runs contact-heavy layouts against every SolverType and SolverProfile and
+ * prints step time next to the accuracy the solver reached:
+ * - BoxStacks: towers of unit boxes resting on a ground box; drift is how far
+ *   the boxes moved from their resting positions (stacks should stay put)
+ * - BallPile: grid of balls dropped onto a ground plane (BallFreeFallScene at scale)
+ *
+ * Penetration is sampled from the contact manifolds after every step.
+ * Pick the cheapest solver/profile whose penetration and drift are acceptable.
+ *
+ * Usage: SolverBenchmark [--frames N] [--towers N] [--height N] [--balls N] [--scene name] [--threads N]
+ */
+
+namespace {
+
+constexpr float FIXED_TIME_STEP = 1.0f / 60.0f;
+
+constexpr float BOX_SIZE = 1.0f;
+constexpr float TOWER_SPACING = 2.0f;
+
+constexpr float PILE_BALL_RADIUS = 0.5f;
+constexpr float PILE_SPACING = 1.2f;
+
+struct BenchmarkOptions {
+    int frames = 300;
+    int towers = 25;
+    int towerHeight = 10;
+    int balls = 2000;
+    int threads = 0; // 0 = task scheduler default
+    std::string sceneFilter;
+};
+
+struct SolverStatistics {
+    double meanMs = 0.0;
+    double p95Ms = 0.0;
+    float maxPenetration = 0.0f;   // Deepest contact seen during the run
+    float meanPenetration = 0.0f;  // Average depth of penetrating contacts
+    float drift = 0.0f;            // Mean distance of tracked bodies from their reference positions
+};
+
+// Owns the Bullet objects of one benchmark run (same setup as BroadphaseBenchmark)
+class BenchmarkScene {
+public:
+    explicit BenchmarkScene(const BulletWorldConfig& config)
+        : m_world(std::make_unique<BulletWorld>(config)) {}
+
+    ~BenchmarkScene() {
+        for (btRigidBody* body : m_bodies) {
+            m_world->RemoveRigidBody(body);
+            delete body->getMotionState();
+            delete body;
+        }
+        for (btCollisionShape* shape : m_shapes) {
+            BulletCollisionShapes::DeleteShape(shape);
+        }
+    }
+
+    BulletWorld& world() { return *m_world; }
+
+    btCollisionShape* addShape(btCollisionShape* shape) {
+        m_shapes.push_back(shape);
+        return shape;
+    }
+
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const glm::vec3& position) {
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(btVector3(position.x, position.y, position.z));
+
+        btVector3 inertia(0, 0, 0);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+
+        btDefaultMotionState* motionState = new btDefaultMotionState(transform);
+        btRigidBody::btRigidBodyConstructionInfo info(mass, motionState, shape, inertia);
+        btRigidBody* body = new btRigidBody(info);
+
+        // Same material defaults as BulletRigidBody
+        body->setRestitution(0.1f);
+        body->setFriction(0.8f);
+        body->setRollingFriction(0.05f);
+        body->setSpinningFriction(0.05f);
+
+        m_world->AddRigidBody(body);
+        m_bodies.push_back(body);
+        return body;
+    }
+
+    // Bodies whose drift is measured, with their reference positions
+    void track(btRigidBody* body, const glm::vec3& reference) {
+        m_tracked.push_back(body);
+        m_references.push_back(reference);
+    }
+
+    float drift() const {
+        if (m_tracked.empty()) {
+            return 0.0f;
+        }
+        float total = 0.0f;
+        for (size_t i = 0; i < m_tracked.size(); ++i) {
+            const btVector3& origin = m_tracked[i]->getWorldTransform().getOrigin();
+            total += glm::length(glm::vec3(origin.x(), origin.y(), origin.z()) - m_references[i]);
+        }
+        return total / m_tracked.size();
+    }
+
+private:
+    std::unique_ptr<BulletWorld> m_world;
+    std::vector<btCollisionShape*> m_shapes;
+    std::vector<btRigidBody*> m_bodies;
+    std::vector<btRigidBody*> m_tracked;
+    std::vector<glm::vec3> m_references;
+};
+
+struct SceneLayout {
+    const char* name;
+    // Populates the scene and registers the bodies whose drift is measured
+    void (*populate)(BenchmarkScene& scene, const BenchmarkOptions& options);
+};
+
+void populateBoxStacks(BenchmarkScene& scene, const BenchmarkOptions& options) {
+    int side = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(options.towers)))));
+    float half = side * TOWER_SPACING * 0.5f + 2.0f;
+
+    // Ground box with its top surface at Y = 0
+    btCollisionShape* ground = scene.addShape(BulletCollisionShapes::CreateBox(glm::vec3(half, 0.5f, half)));
+    scene.addBody(ground, 0.0f, glm::vec3(0.0f, -0.5f, 0.0f));
+
+    // Boxes start exactly at rest, so any motion is solver error
+    btCollisionShape* box = scene.addShape(BulletCollisionShapes::CreateBox(glm::vec3(BOX_SIZE * 0.5f)));
+    float start = -(side - 1) * TOWER_SPACING * 0.5f;
+    for (int tower = 0; tower < options.towers; ++tower) {
+        float x = start + (tower / side) * TOWER_SPACING;
+        float z = start + (tower % side) * TOWER_SPACING;
+        for (int level = 0; level < options.towerHeight; ++level) {
+            glm::vec3 position(x, BOX_SIZE * (level + 0.5f), z);
+            scene.track(scene.addBody(box, 1.0f, position), position);
+        }
+    }
+}
+
+void populateBallPile(BenchmarkScene& scene, const BenchmarkOptions& options) {
+    int side = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(options.balls) / 10.0f))));
+    float start = -(side - 1) * PILE_SPACING * 0.5f;
+
+    btCollisionShape* ground = scene.addShape(BulletCollisionShapes::CreatePlane(glm::vec3(0.0f, 1.0f, 0.0f), 0.0f));
+    scene.addBody(ground, 0.0f, glm::vec3(0.0f));
+
+    // Drift reference: a ball's horizontal start position on the ground, so sideways
+    // spreading and sinking into the plane both count
+    btCollisionShape* ball = scene.addShape(BulletCollisionShapes::CreateSphere(PILE_BALL_RADIUS));
+    for (int i = 0; i < options.balls; ++i) {
+        int layer = i / (side * side);
+        int x = (i / side) % side;
+        int z = i % side;
+        glm::vec3 position(start + x * PILE_SPACING, PILE_BALL_RADIUS + layer * PILE_SPACING, start + z * PILE_SPACING);
+        btRigidBody* body = scene.addBody(ball, 1.0f, position);
+        if (layer == 0) {
+            scene.track(body, position);
+        }
+    }
+}
+
+const SceneLayout SCENES[] = {
+    {"BoxStacks", populateBoxStacks},
+    {"BallPile", populateBallPile},
+};
+
+const SolverType SOLVERS[] = {
+    SolverType::SequentialImpulse,
+    SolverType::NNCG,
+    SolverType::SequentialImpulseMt,
+};
+
+const SolverProfile PROFILES[] = {
+    SolverProfile::Fast,
+    SolverProfile::Balanced,
+    SolverProfile::Accurate,
+};
+
+const char* profileName(SolverProfile profile) {
+    switch (profile) {
+        case SolverProfile::Fast: return "Fast";
+        case SolverProfile::Balanced: return "Balanced";
+        case SolverProfile::Accurate: return "Accurate";
+    }
+    return "unknown";
+}
+
+double percentile(std::vector<double> samples, double fraction) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1) + 0.5);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+SolverStatistics runBenchmark(const SceneLayout& layout, SolverType solver, SolverProfile profile,
+                              const BenchmarkOptions& options) {
+    using Clock = std::chrono::steady_clock;
+
+    BulletWorldConfig config;
+    config.debugLogging = false;
+    config.solver = solver;
+    config.solverSettings = SolverSettings::FromProfile(profile);
+
+    BenchmarkScene scene(config);
+    if (options.threads > 0) {
+        scene.world().SetNumTasks(options.threads);
+    }
+    layout.populate(scene, options);
+
+    SolverStatistics stats;
+    std::vector<double> samples;
+    samples.reserve(options.frames);
+    double penetrationSum = 0.0;
+    long long penetrationCount = 0;
+
+    btCollisionDispatcher* dispatcher = scene.world().GetCollisionDispatcher();
+    for (int frame = 0; frame < options.frames; ++frame) {
+        auto stepStart = Clock::now();
+        scene.world().Update(FIXED_TIME_STEP, 1, FIXED_TIME_STEP);
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - stepStart).count());
+
+        // Contact distances are negative while bodies overlap
+        int numManifolds = dispatcher->getNumManifolds();
+        for (int i = 0; i < numManifolds; ++i) {
+            const btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+            for (int j = 0; j < manifold->getNumContacts(); ++j) {
+                float distance = manifold->getContactPoint(j).getDistance();
+                if (distance < 0.0f) {
+                    stats.maxPenetration = std::max(stats.maxPenetration, -distance);
+                    penetrationSum += -distance;
+                    penetrationCount++;
+                }
+            }
+        }
+    }
+
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    stats.meanMs = samples.empty() ? 0.0 : total / samples.size();
+    stats.p95Ms = percentile(samples, 0.95);
+    stats.meanPenetration = penetrationCount > 0 ? static_cast<float>(penetrationSum / penetrationCount) : 0.0f;
+    stats.drift = scene.drift();
+    return stats;
+}
+
+bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--towers" && hasValue) {
+            options.towers = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--height" && hasValue) {
+            options.towerHeight = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--balls" && hasValue) {
+            options.balls = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--scene" && hasValue) {
+            options.sceneFilter = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--frames N] [--towers N] [--height N] [--balls N] [--scene BoxStacks|BallPile] [--threads N]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::cout << "=== Solver Benchmark ===" << std::endl;
+    std::cout << "Frames: " << options.frames << ", fixed step " << FIXED_TIME_STEP << " s, "
+              << options.towers << " towers of " << options.towerHeight << " boxes, "
+              << options.balls << " balls" << std::endl;
+    std::cout << "Penetration and drift in millimeters" << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(11) << "Scene" << std::setw(40) << "Solver" << std::setw(10) << "Profile"
+              << std::right << std::setw(11) << "Mean ms" << std::setw(11) << "P95 ms" << std::setw(12) << "Max pen"
+              << std::setw(12) << "Mean pen" << std::setw(11) << "Drift" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (const SceneLayout& layout : SCENES) {
+        if (!options.sceneFilter.empty() && options.sceneFilter != layout.name) {
+            continue;
+        }
+
+        for (SolverType solver : SOLVERS) {
+            for (SolverProfile profile : PROFILES) {
+                SolverStatistics stats = runBenchmark(layout, solver, profile, options);
+                std::cout << std::left << std::setw(11) << layout.name << std::setw(40) << BulletWorld::GetSolverName(solver)
+                          << std::setw(10) << profileName(profile) << std::right
+                          << std::setw(11) << stats.meanMs << std::setw(11) << stats.p95Ms
+                          << std::setw(12) << stats.maxPenetration * 1000.0f
+                          << std::setw(12) << stats.meanPenetration * 1000.0f
+                          << std::setw(11) << stats.drift * 1000.0f << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
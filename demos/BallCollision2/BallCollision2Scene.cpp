@@ -132,6 +132,10 @@ void BallCollision2Scene::initializeObjects() {
         }
     }
     
+    // Merge ground and walls into one static body and one draw buffer (after the material
+    // setup above, the compound takes over their friction and restitution)
+    bakeStaticGeometry();
+    
     std::cout << "BallCollision2 Scene: Created ground box (5x5x0.3), 4 boundary walls (0.3x0.3), and ball (r=0.3)" << std::endl;
     std::cout << "Ground: center at (0,0.15,0), top surface at Y=0.3" << std::endl;
     std::cout << "Walls: height=0.3m, width=0.3m, positioned at ground edges" << std::endl;
@@ -35,19 +35,19 @@ void BallCollisionScene::initializeObjects() {
     // Create walls - just one line each!
     createBox(glm::vec3(0.0f, WALL_HEIGHT/2.0f, PLANE_SIZE/2.0f - WALL_WIDTH/2.0f), 
               glm::vec3(PLANE_SIZE, WALL_HEIGHT, WALL_WIDTH), 
-              glm::vec3(0.0f), glm::vec3(0.6f, 0.4f, 0.2f), true); // North wall
+              glm::vec3(0.0f), glm::vec3(0.6f, 0.4f, 0.2f), true, 0.0f); // North wall
     
     createBox(glm::vec3(0.0f, WALL_HEIGHT/2.0f, -PLANE_SIZE/2.0f + WALL_WIDTH/2.0f), 
               glm::vec3(PLANE_SIZE, WALL_HEIGHT, WALL_WIDTH), 
-              glm::vec3(0.0f), glm::vec3(0.6f, 0.4f, 0.2f), true); // South wall
+              glm::vec3(0.0f), glm::vec3(0.6f, 0.4f, 0.2f), true, 0.0f); // South wall
     
     createBox(glm::vec3(PLANE_SIZE/2.0f - WALL_WIDTH/2.0f, WALL_HEIGHT/2.0f, 0.0f), 
               glm::vec3(WALL_WIDTH, WALL_HEIGHT, 4.6f), 
-              glm::vec3(0.0f), glm::vec3(0.6f, 0.4f, 0.2f), true); // East wall
+              glm::vec3(0.0f), glm::vec3(0.6f, 0.4f, 0.2f), true, 0.0f); // East wall
     
     createBox(glm::vec3(-PLANE_SIZE/2.0f + WALL_WIDTH/2.0f, WALL_HEIGHT/2.0f, 0.0f), 
               glm::vec3(WALL_WIDTH, WALL_HEIGHT, 4.6f), 
-              glm::vec3(0.0f), glm::vec3(0.6f, 0.4f, 0.2f), true); // West wall
+              glm::vec3(0.0f), glm::vec3(0.6f, 0.4f, 0.2f), true, 0.0f); // West wall
     
     // Create balls - just one line each!
     for (int i = 0; i < NUM_BALLS; i++) {
@@ -57,6 +57,9 @@ void BallCollisionScene::initializeObjects() {
         createSphere(position, BALL_RADIUS, color, true, 1.0f, velocity); // Physics enabled with velocity
     }
     
+    // Merge the walls into one static body and one draw buffer
+    bakeStaticGeometry();
+    
     std::cout << "Created " << NUM_BALLS << " balls, 1 floor, and 4 walls" << std::endl;
 }
 
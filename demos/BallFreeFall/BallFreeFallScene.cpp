@@ -20,6 +20,12 @@ bool BallFreeFallScene::initialize(GLFWwindow* window) {
     return true;
 }
 
+BulletWorldConfig BallFreeFallScene::getWorldConfig() const {
+    BulletWorldConfig config = BaseScene::getWorldConfig();
+    config.solverSettings = SolverSettings::FromProfile(SolverProfile::Fast);
+    return config;
+}
+
 void BallFreeFallScene::initializeObjects() {
     std::cout << "Creating BallFreeFall Scene objects..." << std::endl;
     
@@ -14,6 +14,9 @@ public:
     void cleanup() override;
     void initializeObjects() override;
     
+    // A single ball on a plane does not need 50 solver iterations
+    BulletWorldConfig getWorldConfig() const override;
+    
     const char* getName() const override { return "BallFreeFall Scene"; }
     const char* getDescription() const override { return "Simple ball falling under gravity - demonstrates basic Bullet Physics"; }
 };
@@ -5,6 +5,10 @@
 TerrainScene::TerrainScene() {
     // Set sun direction (afternoon sun)
     m_sunDirection = glm::normalize(glm::vec3(-0.5f, -0.8f, -0.3f));
+    
+    // Terrain is lit by the sun through FrameConstants
+    m_lightDirection = m_sunDirection;
+    m_lightColor = glm::vec3(1.0f, 1.0f, 0.9f);
 }
 
 bool TerrainScene::initialize(GLFWwindow* window) {
@@ -44,6 +48,38 @@ void TerrainScene::initializeTerrain() {
         std::cerr << "Failed to initialize terrain" << std::endl;
         throw std::runtime_error("Terrain initialization failed");
     }
+    
+    initializeTerrainPhysics();
+}
+
+void TerrainScene::initializeTerrainPhysics() {
+    // Heightfield shares the terrain's height array, no mesh copy or BVH build
+    m_terrainShape = BulletCollisionShapes::CreateHeightfield(*m_terrain);
+    if (!m_terrainShape) {
+        std::cerr << "Failed to create terrain collision shape" << std::endl;
+        return;
+    }
+    
+    m_terrainBody = std::make_unique<BulletRigidBody>(m_terrainShape, 0.0f,
+                                                      BulletCollisionShapes::GetHeightfieldOrigin(*m_terrain));
+    m_bulletWorld->AddRigidBody(m_terrainBody->getBulletRigidBody(), CollisionLayer::Static);
+    
+    // A few balls to show the terrain collision
+    createSphere(glm::vec3(0.0f, 4.0f, 0.0f), 0.5f, glm::vec3(0.8f, 0.2f, 0.2f), true, 1.0f);
+    createSphere(glm::vec3(1.5f, 6.0f, -1.0f), 0.5f, glm::vec3(0.2f, 0.6f, 0.9f), true, 1.0f);
+    createSphere(glm::vec3(-1.0f, 8.0f, 1.5f), 0.5f, glm::vec3(0.9f, 0.8f, 0.2f), true, 1.0f);
+}
+
+void TerrainScene::cleanupTerrainPhysics() {
+    // The heightfield reads the terrain's heights, so it goes before the terrain
+    if (m_terrainBody) {
+        if (m_bulletWorld) {
+            m_bulletWorld->RemoveRigidBody(m_terrainBody->getBulletRigidBody());
+        }
+        m_terrainBody.reset();
+    }
+    BulletCollisionShapes::DeleteShape(m_terrainShape);
+    m_terrainShape = nullptr;
 }
 
 void TerrainScene::initializeSkybox() {
@@ -72,9 +108,9 @@ void TerrainScene::update(float deltaTime) {
 }
 
 void TerrainScene::render() {
-    // BaseScene handles common rendering
+    // BaseScene handles common rendering: renderScene() before executing the render queue,
+    // renderOverlay() after it
     BaseScene::render();
-    renderScene();
 }
 
 void TerrainScene::updateScene(float deltaTime) {
@@ -82,23 +118,25 @@ void TerrainScene::updateScene(float deltaTime) {
 }
 
 void TerrainScene::renderScene() {
-    // Set lighting uniforms for terrain rendering
-    glm::mat4 view = m_camera->getViewMatrix();
-    glm::mat4 projection = m_camera->getProjectionMatrix(800.0f / 600.0f); // Default aspect ratio
+    // Camera and sun were uploaded to FrameConstants by BaseScene::render()
     
     // Render skybox first (background)
     if (m_skybox) {
-        m_skybox->render(view, projection);
+        m_skybox->render();
     }
     
-    // Render terrain with model matrix
+    // Queue terrain with model matrix; BaseScene executes the queue after renderScene()
     if (m_terrain) {
         glm::mat4 model = glm::mat4(1.0f); // Identity matrix
-        m_terrain->render(model, view, projection, m_sunDirection);
+        m_terrain->submit(m_renderQueue, model);
     }
-    
-    // Render grid overlay
+}
+
+void TerrainScene::renderOverlay() {
+    // Grid lines are drawn after the queued terrain so they land on top of it
     if (m_gridRenderer) {
+        glm::mat4 view = m_camera->getViewMatrix();
+        glm::mat4 projection = m_camera->getProjectionMatrix(800.0f / 600.0f); // Default aspect ratio
         m_gridRenderer->render(view, projection);
     }
 }
@@ -107,6 +145,7 @@ void TerrainScene::cleanup() {
     std::cout << "Cleaning up Terrain Scene..." << std::endl;
     
     // Cleanup terrain-specific resources
+    cleanupTerrainPhysics();
     m_terrain.reset();
     m_skybox.reset();
     m_gridRenderer.reset();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../engine/include/BaseScene.h"
+#include "../../engine/include/bullet/BulletCollisionShapes.h"
 #include "../../engine/src/rendering/Skybox.h"
 #include "../../engine/src/rendering/Terrain.h"
 #include "../../engine/src/rendering/GridRenderer.h"
@@ -28,6 +29,7 @@ public:
     // Scene-specific methods
     void updateScene(float deltaTime) override;
     void renderScene() override;
+    void renderOverlay() override;
     
     const char* getName() const override { return "Beautiful Terrain"; }
     const char* getDescription() const override { return "Procedural terrain with skybox, grass, and rocks"; }
@@ -38,6 +40,10 @@ private:
     std::unique_ptr<Terrain> m_terrain;
     std::unique_ptr<GridRenderer> m_gridRenderer;
     
+    // Terrain physics (heightfield over the terrain's height data)
+    btHeightfieldTerrainShape* m_terrainShape = nullptr;
+    std::unique_ptr<BulletRigidBody> m_terrainBody;
+    
     // Lighting
     glm::vec3 m_sunDirection;
     
@@ -51,6 +57,8 @@ private:
     void initializeCamera();
     void initializeObjects() override;
     void initializeTerrain();
+    void initializeTerrainPhysics();
+    void cleanupTerrainPhysics();
     void initializeSkybox();
     void initializeGrid();
 };
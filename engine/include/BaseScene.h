@@ -13,6 +13,7 @@ class Shader;
 class Mesh;
 class RigidBody3D;
 class FPSRenderer;
+class InstancedRenderer;
 
 // Include headers for complete type definitions (needed for unique_ptr destructors)
 #include "bullet/BulletWorld.h"
@@ -22,6 +23,10 @@ class FPSRenderer;
 #include "../src/rendering/Mesh.h"
 #include "../src/core/RigidBody3D.h"
 #include "../src/rendering/FPSRenderer.h"
+#include "../src/rendering/InstancedRenderer.h"
+#include "../src/rendering/FrustumCuller.h"
+#include "../src/rendering/RenderQueue.h"
+#include "../src/rendering/GLRenderBackend.h"
 
 /**
  * BaseScene - Base class for all physics scenes
@@ -37,7 +42,7 @@ class BaseScene {
 public:
     BaseScene();
     virtual ~BaseScene() = default;
-
+    
     // Scene interface - must be implemented by derived classes
     virtual const char* getName() const = 0;
     virtual const char* getDescription() const = 0;
@@ -58,6 +63,29 @@ protected:
     std::unique_ptr<Camera> m_camera;
     std::unique_ptr<Shader> m_shader;
     std::unique_ptr<FPSRenderer> m_fpsRenderer;
+    std::unique_ptr<InstancedRenderer> m_instancedRenderer;
+    
+    // Draw packets submitted during render(), sorted and executed after renderScene()
+    RenderQueue m_renderQueue;
+    std::unique_ptr<GLRenderBackend> m_renderBackend;
+    
+    // Per-draw uniforms of m_shader, looked up once after linking
+    Shader::UniformHandle m_modelUniform;
+    Shader::UniformHandle m_colorUniform;
+    
+    // Scene lighting, uploaded with the camera through FrameConstants every frame
+    glm::vec3 m_lightPosition = glm::vec3(10.0f, 10.0f, 10.0f);
+    glm::vec3 m_lightDirection = glm::normalize(glm::vec3(-0.5f, -0.8f, -0.3f));
+    glm::vec3 m_lightColor = glm::vec3(1.0f, 1.0f, 1.0f);
+    
+    // Draw statistics of the last render(), reported to the FPS display
+    int m_drawCalls = 0;
+    int m_trianglesRendered = 0;
+    
+    // Frustum culling of m_objects (bounding spheres rebuilt every frame)
+    bool m_frustumCulling = true;
+    SphereBounds m_cullBounds;
+    std::vector<uint32_t> m_visibleObjects;  // Indices into m_objects
     
     // Meshes
     std::shared_ptr<Mesh> m_boxMesh;
@@ -70,30 +98,45 @@ protected:
     // Window reference
     GLFWwindow* m_window = nullptr;
     
-    // Object creation functions
+    // Object creation functions (physics bodies are added to the world in the given collision layer;
+    // bodies with zero mass left on Default go to Static so static pairs stay filtered out)
     void createBox(glm::vec3 position, 
                    glm::vec3 scale,
                    glm::vec3 rotation = glm::vec3(0.0f),
                    glm::vec3 color = glm::vec3(0.5f),
                    bool enablePhysics = false,
-                   float mass = 1.0f);
+                   float mass = 1.0f,
+                   CollisionLayer layer = CollisionLayer::Default);
                    
     void createSphere(glm::vec3 position, 
                       float radius,
                       glm::vec3 color = glm::vec3(0.5f),
                       bool enablePhysics = false,
                       float mass = 1.0f,
-                      glm::vec3 initialVelocity = glm::vec3(0.0f));
+                      glm::vec3 initialVelocity = glm::vec3(0.0f),
+                      CollisionLayer layer = CollisionLayer::Default);
                       
     void createPlane(glm::vec3 position, 
                      glm::vec2 size,
                      glm::vec3 rotation = glm::vec3(0.0f),
                      glm::vec3 color = glm::vec3(0.3f),
-                     bool enablePhysics = false);
+                     bool enablePhysics = false,
+                     CollisionLayer layer = CollisionLayer::Static);
+    
+    // Merge all static boxes and spheres into compound collision bodies (one per layer and
+    // material) and one static vertex buffer; call at the end of initializeObjects()
+    void bakeStaticGeometry();
     
     // Rendering functions
-    void renderObject(const BulletRigidBody& body, glm::vec3 color);
-    void renderAllObjects();
+    void renderObject(const BulletRigidBody& body, glm::vec3 color);  // Submits to m_renderQueue
+    void renderAllObjects();  // Objects inside the view frustum, one instanced draw per mesh
+    void renderStaticGeometry();  // Submits to m_renderQueue
+    
+    // Mesh and model matrix an object is drawn with
+    std::shared_ptr<Mesh> getRenderMesh(const BulletRigidBody& body, glm::mat4& model) const;
+    
+    // Fill m_visibleObjects with the objects the camera can see
+    void cullObjects();
     
     // Matrix getters
     glm::mat4 getViewMatrix() const;
@@ -105,9 +148,15 @@ protected:
     void loadCommonMeshes();
     
     // Virtual functions for customization
+    virtual BulletWorldConfig getWorldConfig() const;  // Solver backend, iteration profile, broadphase
     virtual void initializeObjects() = 0;
     virtual void updateScene(float deltaTime) {}
     virtual void renderScene() {}
+    virtual void renderOverlay() {}  // After the render queue has executed: grids, debug lines
+    
+    // Fixed-rate hooks, called once per physics substep (0 to maxSubSteps times per frame)
+    virtual void prePhysicsStep(float timeStep) {}   // Before the substep: apply forces, drive kinematics
+    virtual void postPhysicsStep(float timeStep) {}  // After the substep: read sensors, drain contact events
     
     // Object storage
     struct ObjectInfo {
@@ -117,4 +166,16 @@ protected:
     };
     
     std::vector<ObjectInfo> m_objects;
+    
+    // Baked static geometry (see bakeStaticGeometry)
+    struct StaticBatch {
+        glm::vec3 color;
+        size_t firstVertex;
+        size_t vertexCount;
+    };
+    
+    std::vector<std::unique_ptr<BulletRigidBody>> m_staticBodies;  // One compound body per layer and material
+    std::vector<btCollisionShape*> m_staticShapes;                 // Compounds and their child shapes
+    std::shared_ptr<Mesh> m_staticMesh;                            // World space vertices of all baked objects
+    std::vector<StaticBatch> m_staticBatches;                      // Vertex ranges of m_staticMesh per color
 };
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <btBulletDynamicsCommon.h>
+#include <cstdint>
+
+/**
+ * Collision layers
+ * 
+ * Each layer maps to one bit of Bullet's collision filter group. The first six
+ * layers use the same bits as btBroadphaseProxy::CollisionFilterGroups, so bodies
+ * added without a layer (DefaultFilter/StaticFilter) land in Default and Static.
+ */
+enum class CollisionLayer : uint8_t {
+    Default = 0,    // Regular dynamic bodies
+    Static = 1,     // Immovable level geometry
+    Kinematic = 2,  // Animated bodies that push others but are not pushed
+    Debris = 3,     // Small dynamic clutter that only needs to hit the world
+    Sensor = 4,     // Trigger volumes
+    Character = 5,  // Player and NPC bodies
+    Custom = 6      // First free layer; use CollisionLayer(Custom + n) for game specific layers
+};
+
+/**
+ * Number of collision layers (one bit each in the 16-bit range Bullet reserves for filter groups)
+ */
+constexpr int MAX_COLLISION_LAYERS = 16;
+
+/**
+ * CollisionLayerMatrix - Symmetric layer interaction matrix
+ * 
+ * By default every layer interacts with every other layer, except the pairs
+ * nobody needs contacts for: Static vs. Static, Debris vs. Debris,
+ * Sensor vs. Static and Sensor vs. Sensor.
+ */
+class CollisionLayerMatrix {
+public:
+    CollisionLayerMatrix();
+    
+    /**
+     * Enable or disable collisions between two layers (symmetric)
+     * @param a First layer
+     * @param b Second layer
+     * @param enabled True if bodies in the two layers should collide
+     */
+    void SetInteraction(CollisionLayer a, CollisionLayer b, bool enabled);
+    
+    /**
+     * Check whether two layers collide
+     * @param a First layer
+     * @param b Second layer
+     * @return True if bodies in the two layers collide
+     */
+    bool Interacts(CollisionLayer a, CollisionLayer b) const;
+    
+    /**
+     * Get the Bullet collision filter group of a layer
+     * @param layer Collision layer
+     * @return Filter group with the layer's bit set
+     */
+    static int GetGroup(CollisionLayer layer);
+    
+    /**
+     * Get the Bullet collision filter mask of a layer
+     * @param layer Collision layer
+     * @return Filter mask with the bits of all layers the layer collides with
+     */
+    int GetMask(CollisionLayer layer) const;
+    
+    /**
+     * Get the layer of a Bullet collision filter group
+     * @param group Filter group (the lowest set bit decides)
+     * @return Collision layer, Default if the group has no layer bit set
+     */
+    static CollisionLayer GetLayerFromGroup(int group);
+    
+    /**
+     * Get a human readable name for a layer
+     * @param layer Collision layer
+     * @return Name of the layer ("Custom" for layers above Character)
+     */
+    static const char* GetLayerName(CollisionLayer layer);
+    
+private:
+    uint16_t m_masks[MAX_COLLISION_LAYERS];
+};
+
+/**
+ * CollisionLayerPairStats - Broadphase filter statistics of one layer pair
+ */
+struct CollisionLayerPairStats {
+    uint64_t acceptedOverlaps = 0;  // AABB overlaps that were turned into pairs (or kept existing ones)
+    uint64_t rejectedOverlaps = 0;  // AABB overlaps the layer matrix filtered out
+};
+
+/**
+ * CollisionLayerFilter - Overlap filter callback counting overlaps per layer pair
+ * 
+ * Applies the same group/mask test as Bullet's default filter, so installing it
+ * does not change which pairs are created, it only records what the filtering saves.
+ * The broadphase reports an overlap every time it finds two overlapping AABBs
+ * (with DBVT that is once per step for every overlapping pair), so the counts
+ * grow with the number of steps.
+ */
+class CollisionLayerFilter : public btOverlapFilterCallback {
+public:
+    CollisionLayerFilter();
+    
+    bool needBroadphaseCollision(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1) const override;
+    
+    /**
+     * Get the statistics of a layer pair (order of the layers does not matter)
+     * @param a First layer
+     * @param b Second layer
+     * @return Statistics since construction or the last Reset()
+     */
+    CollisionLayerPairStats GetStats(CollisionLayer a, CollisionLayer b) const;
+    
+    /**
+     * Reset all counters to zero
+     */
+    void Reset();
+    
+private:
+    // Indexed [min layer][max layer]; mutable because Bullet's filter callback is const
+    mutable CollisionLayerPairStats m_stats[MAX_COLLISION_LAYERS][MAX_COLLISION_LAYERS];
+};
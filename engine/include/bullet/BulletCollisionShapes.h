@@ -1,9 +1,13 @@
 #pragma once
 
 #include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
 #include <glm/glm.hpp>
+#include <string>
 #include <vector>
 
+class Terrain;
+
 /**
  * BulletCollisionShapes - Factory class for creating Bullet Physics collision shapes
  * 
@@ -18,6 +22,7 @@
  * - Plane
  * - Convex Hull
  * - Triangle Mesh
+ * - Heightfield
  * - Compound Shapes
  */
 class BulletCollisionShapes {
@@ -70,6 +75,10 @@ public:
     
     /**
      * Create a triangle mesh collision shape
+     * 
+     * Builds a quantized BVH over the mesh. If a BVH cache directory is set, the BVH is
+     * looked up by a hash of the mesh contents and memory-mapped from disk instead of
+     * being rebuilt; on a miss the freshly built BVH is written to the cache.
      * @param vertices Vector of vertices
      * @param triangles Vector of triangle indices
      * @return Pointer to btBvhTriangleMeshShape
@@ -77,6 +86,50 @@ public:
     static btBvhTriangleMeshShape* CreateTriangleMesh(const std::vector<glm::vec3>& vertices, 
                                                       const std::vector<glm::ivec3>& triangles);
     
+    /**
+     * Set the directory serialized triangle mesh BVHs are cached in
+     * @param directory Cache directory (created on first write), empty to disable caching
+     */
+    static void SetBvhCacheDirectory(const std::string& directory);
+    
+    /**
+     * Get the triangle mesh BVH cache directory
+     * @return Cache directory, empty if caching is disabled (default)
+     */
+    static std::string GetBvhCacheDirectory();
+    
+    // Heightfields
+    /**
+     * Create a heightfield collision shape over a terrain's height data (no copy)
+     * 
+     * The shape reads Terrain's height array directly, so the terrain must outlive
+     * the shape. Bullet centers heightfields on their bounding box; place the body
+     * at GetHeightfieldOrigin() to line the shape up with the rendered terrain.
+     * @param terrain Initialized terrain
+     * @return Pointer to btHeightfieldTerrainShape, nullptr if the terrain has no height data
+     */
+    static btHeightfieldTerrainShape* CreateHeightfield(const Terrain& terrain);
+    
+    /**
+     * Create a heightfield collision shape over a row-major height array (no copy)
+     * @param heights Height samples, heights[z * width + x], must outlive the shape
+     * @param width Number of samples along X
+     * @param length Number of samples along Z
+     * @param gridSpacing Distance between neighbouring samples in world units
+     * @param minHeight Lowest height in the array
+     * @param maxHeight Highest height in the array
+     * @return Pointer to btHeightfieldTerrainShape, nullptr on invalid input
+     */
+    static btHeightfieldTerrainShape* CreateHeightfield(const float* heights, int width, int length,
+                                                        float gridSpacing, float minHeight, float maxHeight);
+    
+    /**
+     * Get the body position that aligns a heightfield created from a terrain with it
+     * @param terrain Terrain passed to CreateHeightfield
+     * @return World position for the heightfield's rigid body
+     */
+    static glm::vec3 GetHeightfieldOrigin(const Terrain& terrain);
+    
     // Compound shapes
     /**
      * Create a compound collision shape
@@ -110,12 +163,40 @@ public:
     
     /**
      * Calculate the inertia tensor for a collision shape
+     * 
+     * For hulls and meshes this is the diagonal of the exact tensor about the shape origin,
+     * i.e. the moments about the shape's x, y and z axes. Bullet drops the products of
+     * inertia, so rotation is exact only when the mesh's principal axes are the shape
+     * axes (see GetMassProperties for the full tensor).
      * @param shape Shape to calculate inertia for
      * @param mass Mass of the object
      * @return Inertia tensor
      */
     static glm::vec3 CalculateInertia(btCollisionShape* shape, float mass);
-    
+
+    /**
+     * Get the exact mass properties of a convex hull or triangle mesh shape, integrated
+     * from its surface when the shape was created (unit density, shape space, unscaled)
+     * @param shape Shape created by CreateConvexHull or CreateTriangleMesh
+     * @param volume Output enclosed volume
+     * @param centerOfMass Output center of mass
+     * @param inertia Output inertia tensor about the center of mass
+     * @return False for other shapes, open meshes and shapes with local scaling
+     */
+    static bool GetMassProperties(btCollisionShape* shape, float& volume, glm::vec3& centerOfMass, glm::mat3& inertia);
+
+    /**
+     * Set the directory mass properties are persisted in, keyed by mesh content hash
+     * @param directory Cache directory (created on first write), empty to disable (default)
+     */
+    static void SetMassPropertiesCacheDirectory(const std::string& directory);
+
+    /**
+     * Get the mass properties cache directory
+     * @return Cache directory, empty if disabled
+     */
+    static std::string GetMassPropertiesCacheDirectory();
+
     // Shape validation
     /**
      * Check if a collision shape is valid
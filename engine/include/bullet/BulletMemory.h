@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class btCollisionShape;
+class BulletMemoryArena;
+
+/**
+ * Allocation categories tracked by BulletMemory
+ */
+enum class BulletMemoryCategory {
+    Body,         // btRigidBody
+    MotionState,  // btDefaultMotionState
+    Shape,        // Collision shapes and their internal data (hull points, BVHs)
+    Other,        // Everything else Bullet allocates (broadphase, manifolds, solver pools)
+    Count
+};
+
+/**
+ * BulletMemoryStats - Allocation statistics of one category
+ */
+struct BulletMemoryStats {
+    uint64_t allocations = 0;  // Blocks allocated since startup
+    uint64_t frees = 0;        // Blocks freed since startup
+    uint64_t liveBytes = 0;    // Bytes currently allocated (size class capacity)
+    uint64_t peakBytes = 0;    // Highest value of liveBytes
+};
+
+/**
+ * BulletMemory - Arena-backed allocator for Bullet Physics
+ *
+ * Installs custom allocators via btAlignedAllocSetCustom/btAlignedAllocSetCustomAligned,
+ * so everything Bullet allocates is served from size-class pools owned by an arena.
+ * Each BulletWorld owns an arena that is current while the world allocates its
+ * internals; objects created for the world inside a ScopedArena on that arena share
+ * its contiguous chunks, which are released in bulk when the world and its objects are gone.
+ *
+ * Features:
+ * - Per-thread current arena (ScopedArena), falling back to a process-wide default arena
+ * - Size-class free lists carved from 64 KB aligned chunks, large blocks take whole chunks
+ * - Object blocks: a shape created by BulletCollisionShapes reserves room for one
+ *   btRigidBody and btDefaultMotionState right behind it, so the body, motion state
+ *   and shape of an object live in one block
+ * - Allocation counts and bytes per category, globally and per arena
+ */
+class BulletMemory {
+public:
+    /**
+     * Body and motion state storage reserved behind a shape
+     */
+    struct ObjectSlots {
+        void* block = nullptr;        // Block handle to pass to ReleaseObjectSlots (null if nothing was claimed)
+        void* motionState = nullptr;  // Storage for a btDefaultMotionState
+        void* body = nullptr;         // Storage for a btRigidBody
+    };
+
+    /**
+     * Install the custom Bullet allocators (idempotent, done automatically at startup)
+     */
+    static void Install();
+
+    /**
+     * Check whether the custom allocators are installed
+     * @return True if Bullet allocations go through BulletMemory
+     */
+    static bool IsInstalled();
+
+    /**
+     * Create an arena
+     * @param name Name used in statistics output
+     * @return New arena, owned by the caller until ReleaseArena()
+     */
+    static BulletMemoryArena* CreateArena(const char* name);
+
+    /**
+     * Give up ownership of an arena. Its chunks are returned to the system
+     * as soon as every block allocated from it has been freed.
+     * @param arena Arena created by CreateArena()
+     */
+    static void ReleaseArena(BulletMemoryArena* arena);
+
+    /**
+     * Get the arena new allocations on this thread are served from
+     * @return Current arena, or nullptr for the default arena
+     */
+    static BulletMemoryArena* GetCurrentArena();
+
+    /**
+     * Set the arena new allocations on this thread are served from
+     * @param arena Arena to use, or nullptr for the default arena
+     */
+    static void SetCurrentArena(BulletMemoryArena* arena);
+
+    /**
+     * Claim the body and motion state storage reserved behind a shape
+     *
+     * Only the first caller gets the storage; until it is released, later
+     * bodies sharing the shape allocate on their own.
+     * @param shape Shape created by BulletCollisionShapes
+     * @return Reserved storage, or empty slots if the shape has none available
+     */
+    static ObjectSlots ClaimObjectSlots(btCollisionShape* shape);
+
+    /**
+     * Return storage claimed with ClaimObjectSlots() after destroying the objects in it
+     * @param block ObjectSlots::block
+     */
+    static void ReleaseObjectSlots(void* block);
+
+    /**
+     * Get allocation statistics
+     * @param category Category to query
+     * @param arena Arena to query, or nullptr for totals over all arenas
+     * @return Statistics snapshot
+     */
+    static BulletMemoryStats GetStats(BulletMemoryCategory category, const BulletMemoryArena* arena = nullptr);
+
+    /**
+     * Print allocation statistics per category
+     * @param arena Arena to print, or nullptr for totals over all arenas
+     */
+    static void PrintStatistics(const BulletMemoryArena* arena = nullptr);
+
+    /**
+     * Get a human readable name for a category
+     * @param category Allocation category
+     * @return Name of the category
+     */
+    static const char* GetCategoryName(BulletMemoryCategory category);
+
+    /**
+     * Makes an arena current for the lifetime of the scope
+     */
+    class ScopedArena {
+    public:
+        explicit ScopedArena(BulletMemoryArena* arena);
+        ~ScopedArena();
+        ScopedArena(const ScopedArena&) = delete;
+        ScopedArena& operator=(const ScopedArena&) = delete;
+    private:
+        BulletMemoryArena* m_previous;
+    };
+
+    /**
+     * Attributes allocations on this thread to a category for the lifetime of the scope
+     */
+    class ScopedCategory {
+    public:
+        explicit ScopedCategory(BulletMemoryCategory category);
+        ~ScopedCategory();
+        ScopedCategory(const ScopedCategory&) = delete;
+        ScopedCategory& operator=(const ScopedCategory&) = delete;
+    private:
+        BulletMemoryCategory m_previous;
+    };
+
+    /**
+     * Turns the next allocation on this thread into an object block (shape followed
+     * by body and motion state storage). Allocations are attributed to Shape.
+     */
+    class ScopedObjectBlock {
+    public:
+        ScopedObjectBlock();
+        ~ScopedObjectBlock();
+        ScopedObjectBlock(const ScopedObjectBlock&) = delete;
+        ScopedObjectBlock& operator=(const ScopedObjectBlock&) = delete;
+    private:
+        ScopedCategory m_category;
+    };
+};
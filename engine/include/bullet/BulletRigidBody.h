@@ -25,6 +25,9 @@ private:
     btMotionState* m_motionState;
     btTransform m_transform;
     
+    // Object block holding the body and motion state (see BulletMemory), or nullptr
+    void* m_objectBlock;
+    
     // Properties
     float m_mass;
     bool m_isStatic;
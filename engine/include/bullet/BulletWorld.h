@@ -1,10 +1,144 @@
 #pragma once
 
 #include <btBulletDynamicsCommon.h>
+#include "bullet/BulletMemory.h"
+#include "bullet/BulletCollisionLayers.h"
 #include <glm/glm.hpp>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <cstdint>
+
+class btConstraintSolverPoolMt;
+
+/**
+ * Broadphase backends available to BulletWorld
+ */
+enum class BroadphaseType {
+    Dbvt,             // btDbvtBroadphase: dynamic AABB trees, unbounded worlds (default)
+    AxisSweep3,       // btAxisSweep3: 16-bit sweep and prune, bounded worlds, up to 32766 proxies
+    AxisSweep3_32Bit  // bt32BitAxisSweep3: 32-bit sweep and prune, bounded worlds with many proxies
+};
+
+/**
+ * Constraint solver backends available to BulletWorld
+ */
+enum class SolverType {
+    SequentialImpulse,   // btSequentialImpulseConstraintSolver: projected Gauss-Seidel (default)
+    NNCG,                // btNNCGConstraintSolver: nonlinear nonsmooth conjugate gradient, converges in fewer iterations
+    SequentialImpulseMt  // btSequentialImpulseConstraintSolverMt in a btDiscreteDynamicsWorldMt, islands solved on the task scheduler
+};
+
+/**
+ * Solver iteration profiles, from cheapest to most accurate
+ */
+enum class SolverProfile {
+    Fast,      // 10 iterations, no order randomization
+    Balanced,  // 20 iterations
+    Accurate   // 50 iterations with randomized order (the original BulletWorld setup)
+};
+
+/**
+ * SolverSettings - Iteration and stabilization parameters of the constraint solver
+ * 
+ * The defaults reproduce the original BulletWorld setup (SolverProfile::Accurate).
+ */
+struct SolverSettings {
+    int iterations = 50;                              // Solver iterations per step
+    bool randomizeOrder = true;                       // SOLVER_RANDMIZE_ORDER
+    bool warmStarting = true;                         // SOLVER_USE_WARMSTARTING
+    bool splitImpulse = true;                         // Resolve penetration without adding momentum
+    float splitImpulsePenetrationThreshold = -0.002f; // Penetration depth above which split impulse kicks in
+    float erp = 0.2f;                                 // Error reduction parameter
+    float erp2 = 0.2f;                                // Error reduction parameter for contact constraints
+    
+    /**
+     * Get the settings of an iteration profile
+     * @param profile Iteration profile
+     * @return Solver settings for the profile
+     */
+    static SolverSettings FromProfile(SolverProfile profile);
+};
+
+/**
+ * BulletWorldConfig - Construction parameters for BulletWorld
+ * 
+ * The defaults reproduce the original BulletWorld setup (DBVT broadphase,
+ * Bullet's default DBVT stage tuning, Earth gravity).
+ */
+struct BulletWorldConfig {
+    // Gravity vector
+    glm::vec3 gravity = glm::vec3(0.0f, -9.81f, 0.0f);
+    
+    // Broadphase selection
+    BroadphaseType broadphase = BroadphaseType::Dbvt;
+    
+    // World bounds (required by the sweep and prune broadphases, ignored by DBVT)
+    glm::vec3 worldMin = glm::vec3(-1000.0f);
+    glm::vec3 worldMax = glm::vec3(1000.0f);
+    
+    // Maximum number of broadphase proxies (sweep and prune only)
+    int maxProxies = 16384;
+    
+    // DBVT stage tuning (percentages of the tree refitted/cleaned per step)
+    int dbvtDynamicUpdatePercent = 0;   // Dynamic set incremental optimization
+    int dbvtFixedUpdatePercent = 1;     // Fixed (sleeping/static) set incremental optimization
+    int dbvtCleanupPercent = 10;        // Pair cache cleanup
+    float dbvtVelocityPrediction = 0.0f; // AABB velocity prediction factor
+    bool dbvtDeferredCollide = false;   // Defer pair collection to the fixed set
+    
+    // Which collision layers collide with each other (bodies added with a layer)
+    CollisionLayerMatrix collisionLayers;
+    
+    // Constraint solver backend and iteration profile
+    SolverType solver = SolverType::SequentialImpulse;
+    SolverSettings solverSettings;
+    
+    // Print per-step and per-body debug output
+    bool debugLogging = true;
+};
+
+/**
+ * RaycastQuery - One ray of a batched raycast
+ */
+struct RaycastQuery {
+    glm::vec3 from;
+    glm::vec3 to;
+    int collisionFilterGroup = btBroadphaseProxy::DefaultFilter;
+    int collisionFilterMask = btBroadphaseProxy::AllFilter;
+};
+
+/**
+ * SphereSweepQuery - One sphere cast of a batched sweep
+ */
+struct SphereSweepQuery {
+    glm::vec3 from;
+    glm::vec3 to;
+    float radius = 0.5f;
+    int collisionFilterGroup = btBroadphaseProxy::DefaultFilter;
+    int collisionFilterMask = btBroadphaseProxy::AllFilter;
+};
+
+/**
+ * OverlapQuery - One sphere overlap test of a batched overlap query
+ */
+struct OverlapQuery {
+    glm::vec3 center;
+    float radius = 0.5f;
+    int collisionFilterGroup = btBroadphaseProxy::DefaultFilter;
+    int collisionFilterMask = btBroadphaseProxy::AllFilter;
+};
+
+/**
+ * QueryHit - Closest hit of a ray or sweep query
+ */
+struct QueryHit {
+    bool hasHit = false;
+    float fraction = 1.0f;                         // Hit position along from -> to, in [0, 1]
+    glm::vec3 point = glm::vec3(0.0f);             // World space hit point
+    glm::vec3 normal = glm::vec3(0.0f);            // World space surface normal
+    const btCollisionObject* object = nullptr;     // Object that was hit
+};
 
 /**
  * BulletWorld - Wrapper class for Bullet Physics world
@@ -21,20 +155,48 @@
  * - Multi-threading support
  */
 class BulletWorld {
+public:
+    /**
+     * Called once per fixed substep with the substep's time step
+     */
+    using TickCallback = std::function<void(BulletWorld& world, float timeStep)>;
+    
 private:
     // Core Bullet Physics components
     btDiscreteDynamicsWorld* m_dynamicsWorld;
     btCollisionDispatcher* m_dispatcher;
     btBroadphaseInterface* m_broadphase;
     btSequentialImpulseConstraintSolver* m_solver;
+    btConstraintSolverPoolMt* m_solverPool;  // Per-thread solvers of the Mt backend, nullptr otherwise
     btDefaultCollisionConfiguration* m_collisionConfig;
+    CollisionLayerFilter* m_layerFilter;
     
     // Collision callback
     std::function<void(btRigidBody*, btRigidBody*)> m_collisionCallback;
     
+    // Substep hooks (see SetPreTickCallback/SetPostTickCallback)
+    TickCallback m_preTickCallback;
+    TickCallback m_postTickCallback;
+    
+    // Force and torque the pre-tick hook added on the last substep, withdrawn before the next
+    struct TickForce {
+        btRigidBody* body;
+        btVector3 force;
+        btVector3 torque;
+    };
+    std::vector<TickForce> m_tickForces;
+    std::vector<TickForce> m_tickScratch;
+    
     // Debug drawing
     bool m_debugDrawEnabled;
     
+    // Construction parameters
+    BulletWorldConfig m_config;
+    int m_updateCount;
+    
+    // Arena serving this world's Bullet allocations
+    BulletMemoryArena* m_memoryArena;
+    
 public:
     /**
      * Constructor
@@ -42,6 +204,12 @@ public:
      */
     explicit BulletWorld(const glm::vec3& gravity = glm::vec3(0.0f, -9.81f, 0.0f));
     
+    /**
+     * Constructor
+     * @param config Broadphase selection, world bounds and tuning parameters
+     */
+    explicit BulletWorld(const BulletWorldConfig& config);
+    
     /**
      * Destructor
      */
@@ -65,6 +233,16 @@ public:
      */
     void AddRigidBody(btRigidBody* body);
     
+    /**
+     * Add a rigid body to the world in a collision layer
+     * 
+     * The body's filter group and mask are taken from the world's layer matrix,
+     * so the broadphase never creates pairs between layers that do not interact.
+     * @param body Bullet rigid body to add
+     * @param layer Collision layer of the body
+     */
+    void AddRigidBody(btRigidBody* body, CollisionLayer layer);
+    
     /**
      * Remove a rigid body from the world
      * @param body Bullet rigid body to remove
@@ -89,6 +267,27 @@ public:
      */
     void SetCollisionCallback(std::function<void(btRigidBody*, btRigidBody*)> callback);
     
+    /**
+     * Set a function to run before every internal substep
+     * 
+     * Update() may run 0 to maxSubSteps fixed substeps; this hook runs once per
+     * substep right before Bullet integrates it. Forces applied here act for exactly
+     * one fixed step; forces applied outside the callback keep Bullet's usual
+     * behaviour and act on every substep of the next Update(). Runs on the thread
+     * calling Update().
+     * @param callback Function to call, or nullptr to remove it
+     */
+    void SetPreTickCallback(TickCallback callback);
+    
+    /**
+     * Set a function to run after every internal substep
+     * 
+     * Runs after the substep's contacts have been solved and bodies integrated,
+     * so contact manifolds and velocities reflect that substep (sensors, event draining).
+     * @param callback Function to call, or nullptr to remove it
+     */
+    void SetPostTickCallback(TickCallback callback);
+    
     /**
      * Enable or disable debug drawing
      * @param enabled True to enable debug drawing
@@ -103,10 +302,27 @@ public:
     
     /**
      * Set number of threads for multi-threading
+     * 
+     * Sets the number of threads the Bullet task scheduler uses. Only the
+     * SequentialImpulseMt backend runs work on the task scheduler, and only
+     * when Bullet is built with BT_THREADSAFE.
      * @param numThreads Number of threads to use
      */
     void SetNumTasks(int numThreads);
     
+    /**
+     * Apply solver iteration and stabilization settings
+     * @param settings New solver settings
+     */
+    void SetSolverSettings(const SolverSettings& settings);
+    
+    /**
+     * Get a human readable name for a solver type
+     * @param type Solver type
+     * @return Name of the solver
+     */
+    static const char* GetSolverName(SolverType type);
+    
     /**
      * Get the Bullet dynamics world (for advanced usage)
      * @return Pointer to btDiscreteDynamicsWorld
@@ -125,6 +341,120 @@ public:
      */
     btBroadphaseInterface* GetBroadphase() const { return m_broadphase; }
     
+    /**
+     * Get the memory arena backing this world
+     * 
+     * Create bodies and shapes inside a BulletMemory::ScopedArena on this arena to
+     * allocate them next to the world's internals.
+     * @return Arena for use with BulletMemory
+     */
+    BulletMemoryArena* GetMemoryArena() const { return m_memoryArena; }
+    
+    /**
+     * Get the configuration this world was created with
+     * @return World configuration
+     */
+    const BulletWorldConfig& GetConfig() const { return m_config; }
+    
+    /**
+     * Enable or disable collisions between two layers
+     * 
+     * Bodies already in the world in either layer are re-added with the new
+     * filter mask, which changes their index in the world (take new snapshots).
+     * @param a First layer
+     * @param b Second layer
+     * @param enabled True if bodies in the two layers should collide
+     */
+    void SetLayerInteraction(CollisionLayer a, CollisionLayer b, bool enabled);
+    
+    /**
+     * Get the layer interaction matrix
+     * @return Current collision layer matrix
+     */
+    const CollisionLayerMatrix& GetCollisionLayers() const { return m_config.collisionLayers; }
+    
+    /**
+     * Get broadphase filter statistics of a layer pair
+     * @param a First layer
+     * @param b Second layer
+     * @return Accepted and rejected AABB overlaps since creation or the last reset
+     */
+    CollisionLayerPairStats GetLayerPairStats(CollisionLayer a, CollisionLayer b) const;
+    
+    /**
+     * Reset the per layer pair statistics
+     */
+    void ResetLayerPairStats();
+    
+    /**
+     * Print per layer pair statistics (active pairs, accepted and rejected overlaps)
+     */
+    void PrintLayerStatistics() const;
+    
+    /**
+     * Get a human readable name for a broadphase type
+     * @param type Broadphase type
+     * @return Name of the broadphase
+     */
+    static const char* GetBroadphaseName(BroadphaseType type);
+    
+    /**
+     * Cast many rays against the world in parallel
+     * 
+     * Queries read the state left by the last Update() and must not run
+     * concurrently with it. With the DBVT broadphase the queries are spread
+     * across the ThreadPool workers; other broadphases run them serially.
+     * @param queries Array of rays
+     * @param count Number of queries
+     * @param results Preallocated array of count hits, receives the closest hit per ray
+     */
+    void RaycastBatch(const RaycastQuery* queries, int count, QueryHit* results) const;
+    
+    /**
+     * Sweep many spheres through the world in parallel
+     * @param queries Array of sphere casts
+     * @param count Number of queries
+     * @param results Preallocated array of count hits, receives the closest hit per sweep
+     */
+    void SphereSweepBatch(const SphereSweepQuery* queries, int count, QueryHit* results) const;
+    
+    /**
+     * Find the objects overlapping many spheres in parallel
+     * @param queries Array of spheres
+     * @param count Number of queries
+     * @param hitObjects Preallocated array of count * maxHitsPerQuery entries; query i writes
+     *                   its hits to hitObjects[i * maxHitsPerQuery]
+     * @param maxHitsPerQuery Maximum number of hits stored per query (extra hits are dropped)
+     * @param hitCounts Preallocated array of count entries, receives the number of hits stored per query
+     */
+    void OverlapBatch(const OverlapQuery* queries, int count,
+                      const btCollisionObject** hitObjects, int maxHitsPerQuery, int* hitCounts) const;
+    
+    /**
+     * Capture the simulation state into a compact binary blob
+     * 
+     * Stores every collision object's transform, velocities and activation state,
+     * the contact points of all persistent manifolds (including the applied
+     * impulses used for warm starting) and the solver's random seed. Objects are
+     * identified by their index in the world, so the blob can only be restored
+     * into this world while no objects have been added or removed.
+     * @param blob Output buffer, resized to fit (reuse it to avoid reallocations)
+     */
+    void Snapshot(std::vector<uint8_t>& blob) const;
+    
+    /**
+     * Restore a state captured by Snapshot() in place, without reallocating bodies
+     * 
+     * Manifolds are matched by body pair, and by order within a pair that has several
+     * (e.g. compound children). Contacts of pairs that have no manifold
+     * anymore are dropped and rebuilt by the next step without warm starting.
+     * The fixed-step time accumulator is not part of the snapshot, so deterministic
+     * re-simulation requires stepping with deltaTime equal to fixedTimeStep.
+     * @param blob Buffer filled by Snapshot()
+     * @return True if the snapshot was restored, false if it does not match this world
+     */
+    bool Restore(const std::vector<uint8_t>& blob);
+    
 private:
     /**
      * Initialize Bullet Physics components
@@ -136,6 +466,28 @@ private:
      */
     void CleanupBulletComponents();
     
+    /**
+     * Create the broadphase selected in the configuration
+     * @return Newly allocated broadphase
+     */
+    btBroadphaseInterface* CreateBroadphase() const;
+    
+    /**
+     * Create the constraint solver (and for the Mt backend the solver pool) selected in the configuration
+     */
+    void CreateSolver();
+    
+    /**
+     * Bullet internal tick callbacks forwarding to the pre/post tick hooks
+     */
+    static void PreTickTrampoline(btDynamicsWorld* world, btScalar timeStep);
+    static void PostTickTrampoline(btDynamicsWorld* world, btScalar timeStep);
+    
+    /**
+     * Run the pre-tick hook, limiting the forces it applies to the coming substep
+     */
+    void RunPreTickCallback(float timeStep);
+    
     /**
      * Handle collision detection and callbacks
      */
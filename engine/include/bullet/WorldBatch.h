@@ -0,0 +1,165 @@
+#pragma once
+
+#include "bullet/BulletWorld.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+/**
+ * Channels of the WorldBatch observation buffer
+ */
+enum class ObservationChannel {
+    PositionX,
+    PositionY,
+    PositionZ,
+    LinearVelocityX,
+    LinearVelocityY,
+    LinearVelocityZ,
+    AngularVelocityX,
+    AngularVelocityY,
+    AngularVelocityZ,
+    Count
+};
+
+/**
+ * WorldBatch - Many independent BulletWorlds stepped in parallel
+ * 
+ * Meant for parameter sweeps and training workloads that run thousands of small
+ * scenes. The batch owns its worlds, the bodies added through it and a pool of
+ * shapes shared by all worlds. Step() advances every world on the ThreadPool
+ * (each world is stepped by one thread; worlds do not interact) and then exports
+ * the state of every body into one contiguous structure-of-arrays buffer:
+ * 
+ *   [PositionX of all bodies][PositionY of all bodies]...[AngularVelocityZ of all bodies]
+ * 
+ * Bodies are ordered by world, then by the order they were added; body i of
+ * world w is at index GetBodyOffset(w) + i in every channel.
+ * 
+ * Worlds use the SequentialImpulse solver (parallelism comes from stepping
+ * worlds concurrently) and have debug logging disabled.
+ */
+class WorldBatch {
+public:
+    /**
+     * Constructor
+     * @param worldCount Number of worlds to create
+     * @param config Configuration used for every world
+     */
+    explicit WorldBatch(int worldCount, const BulletWorldConfig& config = BulletWorldConfig());
+    
+    /**
+     * Destructor - removes and deletes all bodies, then the worlds and shared shapes
+     */
+    ~WorldBatch();
+    
+    // Disable copy constructor and assignment operator
+    WorldBatch(const WorldBatch&) = delete;
+    WorldBatch& operator=(const WorldBatch&) = delete;
+    
+    /**
+     * Hand a shape to the batch so all worlds can share it
+     * @param shape Shape created by BulletCollisionShapes, deleted with the batch
+     * @return The same shape, for chaining
+     */
+    btCollisionShape* AddSharedShape(btCollisionShape* shape);
+    
+    /**
+     * Add a rigid body to one world
+     * 
+     * Must not be called while Step() is running.
+     * @param worldIndex World to add the body to
+     * @param shape Shape of the body (usually a shared shape)
+     * @param mass Mass of the body (0 for static bodies)
+     * @param position Initial position
+     * @param velocity Initial linear velocity
+     * @param layer Collision layer of the body
+     * @return Index of the body within its world, -1 on invalid parameters
+     */
+    int AddBody(int worldIndex, btCollisionShape* shape, float mass, const glm::vec3& position,
+                const glm::vec3& velocity = glm::vec3(0.0f), CollisionLayer layer = CollisionLayer::Default);
+    
+    /**
+     * Step every world and refresh the observation buffer
+     * @param deltaTime Time step in seconds
+     * @param maxSubSteps Maximum number of sub-steps
+     * @param fixedTimeStep Fixed time step for sub-steps
+     */
+    void Step(float deltaTime, int maxSubSteps = 1, float fixedTimeStep = 1.0f / 60.0f);
+    
+    /**
+     * Get the number of worlds
+     * @return World count
+     */
+    int GetWorldCount() const { return static_cast<int>(m_worlds.size()); }
+    
+    /**
+     * Get a world (for scene-specific setup)
+     * @param index World index
+     * @return World at the index
+     */
+    BulletWorld& GetWorld(int index) { return *m_worlds[index]; }
+    
+    /**
+     * Get a body added with AddBody
+     * @param worldIndex World index
+     * @param bodyIndex Body index returned by AddBody
+     * @return Bullet rigid body
+     */
+    btRigidBody* GetBody(int worldIndex, int bodyIndex) const { return m_bodies[worldIndex][bodyIndex]; }
+    
+    /**
+     * Get the number of bodies in all worlds (length of each observation channel)
+     * @return Total body count
+     */
+    int GetTotalBodyCount() const { return m_totalBodies; }
+    
+    /**
+     * Get the index of a world's first body in the observation channels
+     * @param worldIndex World index
+     * @return Offset of the world's bodies
+     */
+    int GetBodyOffset(int worldIndex) const { return m_bodyOffsets[worldIndex]; }
+    
+    /**
+     * Get the observation buffer (ObservationChannel::Count channels of GetTotalBodyCount() floats)
+     * @return Pointer to the start of the buffer, valid until bodies are added
+     */
+    const float* GetObservations() const { return m_observations.data(); }
+    
+    /**
+     * Get one channel of the observation buffer
+     * @param channel Observation channel
+     * @return Pointer to GetTotalBodyCount() floats
+     */
+    const float* GetObservationChannel(ObservationChannel channel) const {
+        return m_observations.data() + static_cast<size_t>(channel) * m_totalBodies;
+    }
+    
+    /**
+     * Write the current state of all bodies into the observation buffer
+     * (Step() does this already; call it after changing bodies between steps)
+     */
+    void UpdateObservations();
+    
+private:
+    /**
+     * Recompute body offsets and resize the observation buffer after bodies were added
+     */
+    void RebuildLayout();
+    
+    /**
+     * Export the state of one world's bodies
+     * @param worldIndex World index
+     */
+    void WriteObservations(int worldIndex);
+    
+    std::vector<std::unique_ptr<BulletWorld>> m_worlds;
+    std::vector<std::vector<btRigidBody*>> m_bodies;  // Per world, in AddBody order
+    std::vector<btCollisionShape*> m_sharedShapes;
+    
+    // Observation layout
+    std::vector<int> m_bodyOffsets;
+    int m_totalBodies;
+    bool m_layoutDirty;
+    std::vector<float> m_observations;
+};
@@ -7,12 +7,17 @@
 #include "../src/rendering/Mesh.h"
 #include "../src/rendering/MeshCache.h"
 #include "../src/rendering/FPSRenderer.h"
+#include "../src/rendering/InstancedRenderer.h"
+#include "../src/rendering/FrameConstants.h"
 #include "../src/core/RigidBody3D.h"
 #include "../src/shapes/Box.h"
 #include "../src/shapes/Sphere.h"
 #include "../src/shapes/Plane.h"
 #include "../src/utils/MeshGenerator.h"
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <tuple>
 
 BaseScene::BaseScene() {
     // Initialize common components
@@ -41,12 +46,19 @@ bool BaseScene::initialize(GLFWwindow* window) {
 }
 
 void BaseScene::setupCommonComponents(GLFWwindow* window) {
-    // Create Bullet Physics world
-    m_bulletWorld = std::make_unique<BulletWorld>(glm::vec3(0.0f, -9.81f, 0.0f));
+    // Create Bullet Physics world with the scene's configuration
+    m_bulletWorld = std::make_unique<BulletWorld>(getWorldConfig());
+    
+    // Forward physics substeps to the scene's fixed-rate hooks
+    m_bulletWorld->SetPreTickCallback([this](BulletWorld&, float timeStep) { prePhysicsStep(timeStep); });
+    m_bulletWorld->SetPostTickCallback([this](BulletWorld&, float timeStep) { postPhysicsStep(timeStep); });
     
     // Create camera
     m_camera = std::make_unique<Camera>();
     
+    // Create the per-frame constant buffer before any program links against it
+    FrameConstants::getInstance().initialize();
+    
     // Create shader
     m_shader = std::make_unique<Shader>();
     
@@ -57,8 +69,6 @@ void BaseScene::setupCommonComponents(GLFWwindow* window) {
         layout (location = 1) in vec3 aNormal;
         
         uniform mat4 model;
-        uniform mat4 view;
-        uniform mat4 projection;
         
         out vec3 FragPos;
         out vec3 Normal;
@@ -79,8 +89,6 @@ void BaseScene::setupCommonComponents(GLFWwindow* window) {
         in vec3 Normal;
         
         uniform vec3 uColor;
-        uniform vec3 lightPos;
-        uniform vec3 lightColor;
         
         void main() {
             // Ambient lighting
@@ -88,18 +96,21 @@ void BaseScene::setupCommonComponents(GLFWwindow* window) {
             
             // Diffuse lighting
             vec3 norm = normalize(Normal);
-            vec3 lightDir = normalize(lightPos - FragPos);
+            vec3 lightDir = normalize(lightPosition.xyz - FragPos);
             float diff = max(dot(norm, lightDir), 0.0);
             
-            vec3 result = (ambient + diff) * lightColor * uColor;
+            vec3 result = (ambient + diff) * lightColor.rgb * uColor;
             FragColor = vec4(result, 1.0);
         }
     )";
     
-    if (!m_shader->loadFromSource(vertexShaderSource, fragmentShaderSource)) {
+    if (!m_shader->loadFromSource(FrameConstants::withBlock(vertexShaderSource),
+                                  FrameConstants::withBlock(fragmentShaderSource))) {
         std::cerr << "Failed to load shader!" << std::endl;
         return;
     }
+    m_modelUniform = m_shader->getUniformHandle("model");
+    m_colorUniform = m_shader->getUniformHandle("uColor");
     std::cout << "Shader loaded successfully!" << std::endl;
     
     // Enable OpenGL depth testing for proper 3D rendering
@@ -110,26 +121,41 @@ void BaseScene::setupCommonComponents(GLFWwindow* window) {
     m_fpsRenderer = std::make_unique<FPSRenderer>();
     m_fpsRenderer->initialize();
     
+    // Create render queue backend
+    m_renderBackend = std::make_unique<GLRenderBackend>();
+    
+    // Create instanced renderer; objects fall back to one draw each without it
+    m_instancedRenderer = std::make_unique<InstancedRenderer>();
+    if (!m_instancedRenderer->initialize()) {
+        std::cerr << "Failed to initialize instanced renderer!" << std::endl;
+        m_instancedRenderer.reset();
+    }
+    
     std::cout << "Common components setup complete" << std::endl;
 }
 
+BulletWorldConfig BaseScene::getWorldConfig() const {
+    // Earth gravity, DBVT broadphase, sequential impulse solver with the accurate profile
+    BulletWorldConfig config;
+    config.gravity = glm::vec3(0.0f, -9.81f, 0.0f);
+    return config;
+}
+
 void BaseScene::loadCommonMeshes() {
     std::cout << "Loading common meshes..." << std::endl;
     
-    // First, preload all common meshes
-    MeshCache::getInstance().preloadCommonMeshes();
-    
-    // Then, get the meshes from cache
-    m_boxMesh = MeshCache::getInstance().getMesh(MeshCache::CUBE_KEY);
-    m_sphereMesh = MeshCache::getInstance().getMesh(MeshCache::SPHERE_KEY);
-    m_planeMesh = MeshCache::getInstance().getMesh(MeshCache::GROUND_PLANE_KEY);
+    // Vertices are generated on worker threads; the meshes draw once render() has uploaded them
+    MeshCache& meshCache = MeshCache::getInstance();
+    m_boxMesh = meshCache.getOrCreate(MeshDesc::box(glm::vec3(1.0f))).getMesh();
+    m_sphereMesh = meshCache.getOrCreate(MeshDesc::sphere(1.0f, 32, 16)).getMesh();
+    m_planeMesh = meshCache.getOrCreate(MeshDesc::plane(1.0f, 1.0f, -1.0f)).getMesh();
     
     // Verify meshes are loaded
     if (!m_boxMesh || !m_sphereMesh || !m_planeMesh) {
         std::cerr << "Error: Failed to load one or more meshes!" << std::endl;
     }
     
-    std::cout << "Common meshes loaded" << std::endl;
+    std::cout << "Common meshes requested (" << meshCache.getPendingCount() << " generating)" << std::endl;
 }
 
 void BaseScene::setupGLFWCallbacks(GLFWwindow* window) {
@@ -147,7 +173,11 @@ void BaseScene::createBox(glm::vec3 position,
                          glm::vec3 rotation,
                          glm::vec3 color,
                          bool enablePhysics,
-                         float mass) {
+                         float mass,
+                         CollisionLayer layer) {
+    // Allocate the object from the world's arena
+    BulletMemory::ScopedArena arenaScope(m_bulletWorld ? m_bulletWorld->GetMemoryArena() : nullptr);
+    
     // Create Bullet collision shape
     btBoxShape* boxShape = BulletCollisionShapes::CreateBox(scale * 0.5f);
     
@@ -172,7 +202,10 @@ void BaseScene::createBox(glm::vec3 position,
     
     // Add to Bullet world if physics enabled
     if (enablePhysics && m_bulletWorld) {
-        m_bulletWorld->AddRigidBody(objInfo.physicsBody->getBulletRigidBody());
+        if (mass <= 0.0f && layer == CollisionLayer::Default) {
+            layer = CollisionLayer::Static;
+        }
+        m_bulletWorld->AddRigidBody(objInfo.physicsBody->getBulletRigidBody(), layer);
         m_physicsObjects.push_back(objInfo.physicsBody.get());
     }
     
@@ -188,7 +221,11 @@ void BaseScene::createSphere(glm::vec3 position,
                             glm::vec3 color,
                             bool enablePhysics,
                             float mass,
-                            glm::vec3 initialVelocity) {
+                            glm::vec3 initialVelocity,
+                            CollisionLayer layer) {
+    // Allocate the object from the world's arena
+    BulletMemory::ScopedArena arenaScope(m_bulletWorld ? m_bulletWorld->GetMemoryArena() : nullptr);
+    
     // Create Bullet collision shape
     btSphereShape* sphereShape = BulletCollisionShapes::CreateSphere(radius);
     
@@ -215,7 +252,10 @@ void BaseScene::createSphere(glm::vec3 position,
     
     // Add to Bullet world if physics enabled
     if (enablePhysics && m_bulletWorld) {
-        m_bulletWorld->AddRigidBody(objInfo.physicsBody->getBulletRigidBody());
+        if (mass <= 0.0f && layer == CollisionLayer::Default) {
+            layer = CollisionLayer::Static;
+        }
+        m_bulletWorld->AddRigidBody(objInfo.physicsBody->getBulletRigidBody(), layer);
         m_physicsObjects.push_back(objInfo.physicsBody.get());
         std::cout << "DEBUG: Sphere added to physics world, total physics objects: " << m_physicsObjects.size() << std::endl;
     } else {
@@ -232,7 +272,11 @@ void BaseScene::createPlane(glm::vec3 position,
                            glm::vec2 size,
                            glm::vec3 rotation,
                            glm::vec3 color,
-                           bool enablePhysics) {
+                           bool enablePhysics,
+                           CollisionLayer layer) {
+    // Allocate the object from the world's arena
+    BulletMemory::ScopedArena arenaScope(m_bulletWorld ? m_bulletWorld->GetMemoryArena() : nullptr);
+    
     // Create Bullet collision shape (proper static plane)
     btStaticPlaneShape* planeShape = BulletCollisionShapes::CreatePlane(
         glm::vec3(0.0f, 1.0f, 0.0f), // Normal pointing up
@@ -261,7 +305,7 @@ void BaseScene::createPlane(glm::vec3 position,
     
     // Add to Bullet world if physics enabled
     if (enablePhysics && m_bulletWorld) {
-        m_bulletWorld->AddRigidBody(objInfo.physicsBody->getBulletRigidBody());
+        m_bulletWorld->AddRigidBody(objInfo.physicsBody->getBulletRigidBody(), layer);
         m_physicsObjects.push_back(objInfo.physicsBody.get());
     }
     
@@ -272,9 +316,124 @@ void BaseScene::createPlane(glm::vec3 position,
               << ", physics: " << (enablePhysics ? "enabled" : "disabled") << std::endl;
 }
 
-void BaseScene::renderObject(const BulletRigidBody& body, glm::vec3 color) {
+void BaseScene::bakeStaticGeometry() {
+    if (!m_bulletWorld) {
+        std::cerr << "BaseScene::bakeStaticGeometry: Physics world not initialized!" << std::endl;
+        return;
+    }
+    
+    // Bodies with the same collision layer and surface material share one compound
+    using MaterialKey = std::tuple<int, float, float, float>;
+    std::map<MaterialKey, btCompoundShape*> compounds;
+    
+    // World space vertices grouped by color, so each color is one contiguous draw range
+    auto colorLess = [](const glm::vec3& a, const glm::vec3& b) {
+        return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+    };
+    std::map<glm::vec3, std::vector<float>, decltype(colorLess)> verticesByColor(colorLess);
+    
+    std::vector<float> unitCube = MeshGenerator::generateCube();
+    std::vector<float> unitSphere = MeshGenerator::generateSphere(32, 16, 1.0f);
+    
+    std::vector<ObjectInfo> remaining;
+    size_t bakedCount = 0;
+    for (auto& obj : m_objects) {
+        BulletRigidBody* physicsBody = obj.physicsBody.get();
+        btRigidBody* body = physicsBody ? physicsBody->getBulletRigidBody() : nullptr;
+        btCollisionShape* shape = physicsBody ? physicsBody->getCollisionShape() : nullptr;
+        
+        // Planes are infinite and stay separate; only static boxes and spheres are merged
+        bool bakeable = body && shape && physicsBody->isStatic() &&
+                        (shape->getShapeType() == BOX_SHAPE_PROXYTYPE || shape->getShapeType() == SPHERE_SHAPE_PROXYTYPE);
+        if (!bakeable) {
+            remaining.push_back(std::move(obj));
+            continue;
+        }
+        
+        const btTransform& transform = body->getWorldTransform();
+        
+        // Collision: only bodies that were simulated before become compound children
+        if (body->isInWorld()) {
+            CollisionLayer layer = CollisionLayerMatrix::GetLayerFromGroup(body->getBroadphaseHandle()->m_collisionFilterGroup);
+            MaterialKey key(static_cast<int>(layer), body->getFriction(), body->getRestitution(), body->getRollingFriction());
+            
+            btCompoundShape*& compound = compounds[key];
+            if (!compound) {
+                compound = BulletCollisionShapes::CreateCompoundShape();
+                m_staticShapes.push_back(compound);
+            }
+            compound->addChildShape(transform, shape);
+            m_bulletWorld->RemoveRigidBody(body);
+        }
+        m_staticShapes.push_back(shape);
+        
+        // Rendering: transform the unit mesh the same way renderObject() would
+        glm::mat4 model(1.0f);
+        transform.getOpenGLMatrix(&model[0][0]);
+        const std::vector<float>* unitMesh = &unitCube;
+        if (shape->getShapeType() == BOX_SHAPE_PROXYTYPE) {
+            btVector3 halfExtents = static_cast<btBoxShape*>(shape)->getHalfExtentsWithMargin();
+            model = glm::scale(model, glm::vec3(halfExtents.x(), halfExtents.y(), halfExtents.z()) * 2.0f);
+        } else {
+            model = glm::scale(model, glm::vec3(static_cast<btSphereShape*>(shape)->getRadius()));
+            unitMesh = &unitSphere;
+        }
+        
+        std::vector<float>& vertices = verticesByColor[obj.color];
+        for (size_t i = 0; i + 2 < unitMesh->size(); i += 3) {
+            glm::vec4 position = model * glm::vec4((*unitMesh)[i], (*unitMesh)[i + 1], (*unitMesh)[i + 2], 1.0f);
+            vertices.push_back(position.x);
+            vertices.push_back(position.y);
+            vertices.push_back(position.z);
+        }
+        
+        // The shape is kept alive by m_staticShapes; only the body goes away
+        m_physicsObjects.erase(std::remove(m_physicsObjects.begin(), m_physicsObjects.end(), physicsBody), m_physicsObjects.end());
+        bakedCount++;
+    }
+    
+    if (bakedCount == 0) {
+        return;
+    }
+    m_objects = std::move(remaining);
+    
+    // One static body per compound, carrying over the surface material of its children
+    for (auto& entry : compounds) {
+        btCompoundShape* compound = entry.second;
+        float friction = std::get<1>(entry.first);
+        float restitution = std::get<2>(entry.first);
+        float rollingFriction = std::get<3>(entry.first);
+        
+        auto staticBody = std::make_unique<BulletRigidBody>(compound, 0.0f);
+        staticBody->setStatic(true);
+        btRigidBody* body = staticBody->getBulletRigidBody();
+        body->setFriction(friction);
+        body->setRestitution(restitution);
+        body->setRollingFriction(rollingFriction);
+        m_bulletWorld->AddRigidBody(body, static_cast<CollisionLayer>(std::get<0>(entry.first)));
+        m_staticBodies.push_back(std::move(staticBody));
+    }
+    
+    // One vertex buffer for all baked objects, drawn with one call per color
+    std::vector<float> allVertices;
+    for (auto& entry : verticesByColor) {
+        StaticBatch batch;
+        batch.color = entry.first;
+        batch.firstVertex = allVertices.size() / 3;
+        batch.vertexCount = entry.second.size() / 3;
+        allVertices.insert(allVertices.end(), entry.second.begin(), entry.second.end());
+        m_staticBatches.push_back(batch);
+    }
+    m_staticMesh = std::make_shared<Mesh>();
+    m_staticMesh->loadVertices(allVertices);
+    
+    std::cout << "Baked " << bakedCount << " static objects into " << compounds.size() << " compound bodies and "
+              << m_staticBatches.size() << " draw batches (" << allVertices.size() / 3 << " vertices)" << std::endl;
+}
+
+std::shared_ptr<Mesh> BaseScene::getRenderMesh(const BulletRigidBody& body, glm::mat4& model) const {
     // Create model matrix
-    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::mat4(1.0f);
     model = glm::translate(model, body.getPosition());
     
     // Apply rotation
@@ -310,8 +469,6 @@ void BaseScene::renderObject(const BulletRigidBody& body, glm::vec3 color) {
                 float radiusWithMargin = sphereShape->getRadius();
                 scale = glm::vec3(radiusWithMargin);
                 meshToRender = m_sphereMesh;
-                std::cout << "DEBUG: Rendering sphere with radiusWithMargin=" << radiusWithMargin
-                          << " margin=" << sphereShape->getMargin() << ", renderScale=" << scale.x << std::endl;
                 break;
             }
             case STATIC_PLANE_PROXYTYPE: {
@@ -338,26 +495,117 @@ void BaseScene::renderObject(const BulletRigidBody& body, glm::vec3 color) {
     // Apply scale
     model = glm::scale(model, scale);
     
-    // Set uniforms
-    m_shader->setUniform("model", model);
-    m_shader->setUniform("uColor", color);
-    m_shader->setUniform("lightPos", glm::vec3(10.0f, 10.0f, 10.0f));
-    m_shader->setUniform("lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
-    
-    // Render the appropriate mesh
+    // Quantized meshes carry the transform back to model space
     if (meshToRender) {
-        meshToRender->draw();
-    } else {
+        model = model * meshToRender->getPositionTransform();
+    }
+    
+    return meshToRender;
+}
+
+void BaseScene::renderObject(const BulletRigidBody& body, glm::vec3 color) {
+    glm::mat4 model;
+    std::shared_ptr<Mesh> meshToRender = getRenderMesh(body, model);
+    
+    if (!meshToRender) {
         std::cout << "Warning: No mesh found for object type" << std::endl;
+        return;
+    }
+    if (!meshToRender->isLoaded()) {
+        return;
     }
+    
+    // Queue the draw; depth sorts it front to back among objects sharing the mesh
+    RenderCommand command = RenderQueue::makeMeshCommand(*meshToRender, m_shader->getProgramID());
+    command.modelLocation = m_modelUniform.location;
+    command.model = model;
+    command.colorLocation = m_colorUniform.location;
+    command.color = color;
+    
+    glm::vec3 cameraPosition = m_camera ? m_camera->getPosition() : glm::vec3(0.0f);
+    m_renderQueue.submit(command, glm::length(glm::vec3(model[3]) - cameraPosition));
 }
 
 void BaseScene::renderAllObjects() {
-    // Render all objects (both static and physics)
-    for (const auto& obj : m_objects) {
+    // Queue baked static geometry
+    renderStaticGeometry();
+    
+    // Skip objects outside the camera's view
+    cullObjects();
+    
+    if (!m_instancedRenderer) {
+        for (uint32_t index : m_visibleObjects) {
+            const ObjectInfo& obj = m_objects[index];
+            if (obj.physicsBody) {
+                renderObject(*obj.physicsBody, obj.color);
+            }
+        }
+        return;
+    }
+    
+    // Render visible objects (both static and physics), grouped into one draw per mesh
+    for (uint32_t index : m_visibleObjects) {
+        const ObjectInfo& obj = m_objects[index];
         if (obj.physicsBody) {
-            renderObject(*obj.physicsBody, obj.color);
+            glm::mat4 model;
+            std::shared_ptr<Mesh> mesh = getRenderMesh(*obj.physicsBody, model);
+            m_instancedRenderer->submit(mesh, model, obj.color);
+        }
+    }
+    m_instancedRenderer->flush();
+    m_drawCalls += static_cast<int>(m_instancedRenderer->getDrawCalls());
+    m_trianglesRendered += static_cast<int>(m_instancedRenderer->getTrianglesRendered());
+    
+    // Scene-specific rendering continues with the scene shader
+    m_shader->use();
+}
+
+void BaseScene::cullObjects() {
+    m_visibleObjects.clear();
+    if (!m_frustumCulling) {
+        for (size_t i = 0; i < m_objects.size(); ++i) {
+            m_visibleObjects.push_back(static_cast<uint32_t>(i));
         }
+        return;
+    }
+    
+    // World-space bounding sphere per object; objects without a body keep a slot so
+    // indices line up, and are skipped when drawing
+    m_cullBounds.clear();
+    m_cullBounds.reserve(m_objects.size());
+    for (const auto& obj : m_objects) {
+        btCollisionShape* shape = obj.physicsBody ? obj.physicsBody->getCollisionShape() : nullptr;
+        if (!shape) {
+            m_cullBounds.add(glm::vec3(0.0f), 0.0f);
+            continue;
+        }
+        
+        btVector3 center;
+        btScalar radius;
+        shape->getBoundingSphere(center, radius);
+        btVector3 worldCenter = obj.physicsBody->getBulletRigidBody()->getWorldTransform() * center;
+        m_cullBounds.add(glm::vec3(worldCenter.x(), worldCenter.y(), worldCenter.z()), radius);
+    }
+    
+    Frustum frustum = Frustum::fromCamera(getViewMatrix(), getProjectionMatrix());
+    FrustumCuller::cullSpheres(frustum, m_cullBounds, m_visibleObjects);
+}
+
+void BaseScene::renderStaticGeometry() {
+    if (!m_staticMesh || m_staticBatches.empty()) {
+        return;
+    }
+    
+    // Baked vertices are already in world space
+    RenderCommand command = RenderQueue::makeMeshCommand(*m_staticMesh, m_shader->getProgramID());
+    command.modelLocation = m_modelUniform.location;
+    command.colorLocation = m_colorUniform.location;
+    
+    for (const StaticBatch& batch : m_staticBatches) {
+        command.first = batch.firstVertex;
+        command.count = batch.vertexCount;
+        command.color = batch.color;
+        m_renderQueue.submit(command);
     }
 }
 
@@ -408,13 +656,25 @@ void BaseScene::update(float deltaTime) {
         // Estimate collision checks (simple approximation)
         int collisionChecks = objectCount * objectCount / 2; // N*(N-1)/2 for all pairs
         
-        // Estimate draw calls (objects + 1 for each mesh type used)
-        int drawCalls = static_cast<int>(m_objects.size());
+        // Draw calls and triangles BaseScene issued in the last frame
+        MeshCache::Statistics meshStats = MeshCache::getInstance().getStatistics();
+        m_fpsRenderer->update(deltaTime, objectCount, collisionChecks, m_drawCalls, m_trianglesRendered, meshStats.cachedMeshes);
+        m_fpsRenderer->updateMeshCache(meshStats.memoryUsage, meshStats.memoryBudget,
+                                       meshStats.hits, meshStats.misses, meshStats.evictions);
         
-        // Estimate triangles (rough approximation)
-        int trianglesRendered = objectCount * 12; // Assuming ~12 triangles per object on average
-        
-        m_fpsRenderer->update(deltaTime, objectCount, collisionChecks, drawCalls, trianglesRendered);
+        // Overlaps accepted/rejected by the collision layer matrix, summed over all layer pairs
+        if (m_bulletWorld) {
+            uint64_t acceptedOverlaps = 0;
+            uint64_t rejectedOverlaps = 0;
+            for (int a = 0; a < MAX_COLLISION_LAYERS; ++a) {
+                for (int b = a; b < MAX_COLLISION_LAYERS; ++b) {
+                    CollisionLayerPairStats layerStats = m_bulletWorld->GetLayerPairStats(static_cast<CollisionLayer>(a), static_cast<CollisionLayer>(b));
+                    acceptedOverlaps += layerStats.acceptedOverlaps;
+                    rejectedOverlaps += layerStats.rejectedOverlaps;
+                }
+            }
+            m_fpsRenderer->updateCollisionLayers(acceptedOverlaps, rejectedOverlaps);
+        }
     }
     
     // Update scene-specific logic
@@ -426,22 +686,43 @@ void BaseScene::render() {
     glClearColor(0.5f, 0.8f, 1.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
-    // Use shader
-    m_shader->use();
+    // Upload meshes whose background generation has finished
+    MeshCache::getInstance().processUploads();
     
-    // Set view and projection matrices
-    glm::mat4 view = getViewMatrix();
-    glm::mat4 projection = getProjectionMatrix();
+    // Upload camera and light once for every program that reads FrameConstants
+    FrameConstantsData frame;
+    frame.view = getViewMatrix();
+    frame.projection = getProjectionMatrix();
+    frame.viewProjection = frame.projection * frame.view;
+    frame.cameraPosition = glm::vec4(m_camera ? m_camera->getPosition() : glm::vec3(0.0f), 1.0f);
+    frame.lightPosition = glm::vec4(m_lightPosition, 1.0f);
+    frame.lightDirection = glm::vec4(m_lightDirection, 0.0f);
+    frame.lightColor = glm::vec4(m_lightColor, 1.0f);
+    FrameConstants::getInstance().update(frame);
     
-    m_shader->setUniform("view", view);
-    m_shader->setUniform("projection", projection);
+    // Use shader
+    m_shader->use();
     
     // Render all objects
+    m_drawCalls = 0;
+    m_trianglesRendered = 0;
     renderAllObjects();
     
     // Render scene-specific objects
     renderScene();
     
+    // Draw everything submitted to the render queue, sorted by state
+    if (m_renderBackend) {
+        m_renderQueue.execute(*m_renderBackend);
+        m_drawCalls += static_cast<int>(m_renderQueue.getStatistics().drawCalls);
+        m_trianglesRendered += static_cast<int>(m_renderQueue.getStatistics().trianglesRendered);
+    } else {
+        m_renderQueue.clear();
+    }
+    
+    // Immediate-mode overlays go on top of the queued geometry
+    renderOverlay();
+    
     // Render FPS
     renderFPS();
 }
@@ -449,15 +730,51 @@ void BaseScene::render() {
 void BaseScene::cleanup() {
     std::cout << "Cleaning up " << getName() << "..." << std::endl;
     
+    // Detach bodies from the world before destroying them, then free the
+    // per-object shapes so the world's memory arena can be released in bulk
+    std::vector<btCollisionShape*> shapes;
+    shapes.reserve(m_objects.size());
+    for (auto& obj : m_objects) {
+        if (!obj.physicsBody) {
+            continue;
+        }
+        btRigidBody* body = obj.physicsBody->getBulletRigidBody();
+        if (m_bulletWorld && body && body->isInWorld()) {
+            m_bulletWorld->RemoveRigidBody(body);
+        }
+        shapes.push_back(obj.physicsBody->getCollisionShape());
+    }
+    
+    // Baked static bodies, then the compounds and the child shapes they reference
+    for (auto& staticBody : m_staticBodies) {
+        btRigidBody* body = staticBody->getBulletRigidBody();
+        if (m_bulletWorld && body && body->isInWorld()) {
+            m_bulletWorld->RemoveRigidBody(body);
+        }
+    }
+    m_staticBodies.clear();
+    shapes.insert(shapes.end(), m_staticShapes.begin(), m_staticShapes.end());
+    m_staticShapes.clear();
+    m_staticMesh.reset();
+    m_staticBatches.clear();
+    
     // Clear objects
     m_objects.clear();
     m_physicsObjects.clear();
     
+    for (btCollisionShape* shape : shapes) {
+        BulletCollisionShapes::DeleteShape(shape);
+    }
+    
     // Reset components
     m_bulletWorld.reset();
     m_camera.reset();
     m_shader.reset();
     m_fpsRenderer.reset();
+    m_instancedRenderer.reset();
+    m_renderQueue.clear();
+    m_renderBackend.reset();
+    FrameConstants::getInstance().cleanup();
     
     std::cout << getName() << " cleanup complete" << std::endl;
 }
@@ -0,0 +1,100 @@
+#include "bullet/BulletCollisionLayers.h"
+#include <algorithm>
+
+namespace {
+    int LayerIndex(CollisionLayer layer) {
+        return std::min(static_cast<int>(layer), MAX_COLLISION_LAYERS - 1);
+    }
+}
+
+CollisionLayerMatrix::CollisionLayerMatrix() {
+    for (int i = 0; i < MAX_COLLISION_LAYERS; ++i) {
+        m_masks[i] = 0xFFFF;
+    }
+    
+    SetInteraction(CollisionLayer::Static, CollisionLayer::Static, false);
+    SetInteraction(CollisionLayer::Debris, CollisionLayer::Debris, false);
+    SetInteraction(CollisionLayer::Sensor, CollisionLayer::Static, false);
+    SetInteraction(CollisionLayer::Sensor, CollisionLayer::Sensor, false);
+}
+
+void CollisionLayerMatrix::SetInteraction(CollisionLayer a, CollisionLayer b, bool enabled) {
+    int indexA = LayerIndex(a);
+    int indexB = LayerIndex(b);
+    
+    if (enabled) {
+        m_masks[indexA] |= static_cast<uint16_t>(1u << indexB);
+        m_masks[indexB] |= static_cast<uint16_t>(1u << indexA);
+    } else {
+        m_masks[indexA] &= static_cast<uint16_t>(~(1u << indexB));
+        m_masks[indexB] &= static_cast<uint16_t>(~(1u << indexA));
+    }
+}
+
+bool CollisionLayerMatrix::Interacts(CollisionLayer a, CollisionLayer b) const {
+    return (m_masks[LayerIndex(a)] & (1u << LayerIndex(b))) != 0;
+}
+
+int CollisionLayerMatrix::GetGroup(CollisionLayer layer) {
+    return 1 << LayerIndex(layer);
+}
+
+int CollisionLayerMatrix::GetMask(CollisionLayer layer) const {
+    return m_masks[LayerIndex(layer)];
+}
+
+CollisionLayer CollisionLayerMatrix::GetLayerFromGroup(int group) {
+    for (int i = 0; i < MAX_COLLISION_LAYERS; ++i) {
+        if (group & (1 << i)) {
+            return static_cast<CollisionLayer>(i);
+        }
+    }
+    return CollisionLayer::Default;
+}
+
+const char* CollisionLayerMatrix::GetLayerName(CollisionLayer layer) {
+    switch (layer) {
+        case CollisionLayer::Default: return "Default";
+        case CollisionLayer::Static: return "Static";
+        case CollisionLayer::Kinematic: return "Kinematic";
+        case CollisionLayer::Debris: return "Debris";
+        case CollisionLayer::Sensor: return "Sensor";
+        case CollisionLayer::Character: return "Character";
+        default: return "Custom";
+    }
+}
+
+CollisionLayerFilter::CollisionLayerFilter() {
+    Reset();
+}
+
+bool CollisionLayerFilter::needBroadphaseCollision(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1) const {
+    // Same test as btHashedOverlappingPairCache's default filter
+    bool collides = (proxy0->m_collisionFilterGroup & proxy1->m_collisionFilterMask) != 0 &&
+                    (proxy1->m_collisionFilterGroup & proxy0->m_collisionFilterMask) != 0;
+    
+    int layerA = LayerIndex(CollisionLayerMatrix::GetLayerFromGroup(proxy0->m_collisionFilterGroup));
+    int layerB = LayerIndex(CollisionLayerMatrix::GetLayerFromGroup(proxy1->m_collisionFilterGroup));
+    CollisionLayerPairStats& stats = m_stats[std::min(layerA, layerB)][std::max(layerA, layerB)];
+    if (collides) {
+        stats.acceptedOverlaps++;
+    } else {
+        stats.rejectedOverlaps++;
+    }
+    
+    return collides;
+}
+
+CollisionLayerPairStats CollisionLayerFilter::GetStats(CollisionLayer a, CollisionLayer b) const {
+    int layerA = LayerIndex(a);
+    int layerB = LayerIndex(b);
+    return m_stats[std::min(layerA, layerB)][std::max(layerA, layerB)];
+}
+
+void CollisionLayerFilter::Reset() {
+    for (auto& row : m_stats) {
+        for (auto& stats : row) {
+            stats = CollisionLayerPairStats();
+        }
+    }
+}
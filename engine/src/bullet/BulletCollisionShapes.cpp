@@ -1,30 +1,204 @@
 #include "bullet/BulletCollisionShapes.h"
+#include "bullet/BulletMemory.h"
+#include "../rendering/Terrain.h"
+#include "../utils/ContentHash.h"
+#include "../utils/MappedFile.h"
+#include "../utils/MassProperties.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <LinearMath/btConvexHullComputer.h>
+
+namespace {
+
+// Layout of a BVH cache file: header followed by btOptimizedBvh::serializeInPlace output.
+// The header is 64 bytes so the serialized data stays 16-byte aligned in the mapping.
+struct BvhCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t bulletVersion;
+    uint32_t scalarSize;
+    uint32_t pointerSize;
+    uint64_t contentHash;
+    uint64_t dataSize;
+    uint8_t reserved[24];
+};
+static_assert(sizeof(BvhCacheHeader) == 64, "BvhCacheHeader must keep the BVH data 16-byte aligned");
+
+const char BVH_CACHE_MAGIC[8] = {'R', 'C', 'B', 'V', 'H', '0', '1', '\0'};
+const uint32_t BVH_CACHE_VERSION = 1;
+
+// Resources that belong to triangle mesh shapes but are not deleted by Bullet
+struct TriangleMeshResources {
+    btStridingMeshInterface* meshInterface = nullptr;
+    std::unique_ptr<MappedFile> bvhMapping;  // Backs the shape's BVH when it was loaded from the cache
+};
+
+std::mutex s_cacheMutex;
+std::string s_bvhCacheDirectory;
+std::unordered_map<const btCollisionShape*, TriangleMeshResources> s_triangleMeshResources;
+std::unordered_map<const btCollisionShape*, MassProperties> s_massProperties;
+
+void RegisterMassProperties(const btCollisionShape* shape, const MassProperties& properties) {
+    if (!properties.valid) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    s_massProperties[shape] = properties;
+}
+
+bool FindMassProperties(const btCollisionShape* shape, MassProperties& properties) {
+    // Cached properties are for the unscaled shape
+    if (!shape || !(shape->getLocalScaling() == btVector3(1, 1, 1))) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    auto it = s_massProperties.find(shape);
+    if (it == s_massProperties.end()) {
+        return false;
+    }
+    properties = it->second;
+    return true;
+}
+
+// Surface of the convex hull of a point cloud, with each hull face fan-triangulated
+void TriangulateHull(const std::vector<glm::vec3>& points, std::vector<glm::vec3>& vertices,
+                     std::vector<glm::ivec3>& triangles) {
+    btConvexHullComputer computer;
+    computer.compute(&points[0].x, sizeof(glm::vec3), static_cast<int>(points.size()), 0.0f, 0.0f);
+    
+    vertices.reserve(computer.vertices.size());
+    for (int i = 0; i < computer.vertices.size(); ++i) {
+        const btVector3& vertex = computer.vertices[i];
+        vertices.emplace_back(vertex.x(), vertex.y(), vertex.z());
+    }
+    
+    for (int i = 0; i < computer.faces.size(); ++i) {
+        const btConvexHullComputer::Edge* first = &computer.edges[computer.faces[i]];
+        const btConvexHullComputer::Edge* edge = first->getNextEdgeOfFace();
+        int root = first->getSourceVertex();
+        while (edge->getTargetVertex() != root) {
+            triangles.emplace_back(root, edge->getSourceVertex(), edge->getTargetVertex());
+            edge = edge->getNextEdgeOfFace();
+        }
+    }
+}
+
+uint64_t HashTriangleMesh(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles) {
+    ContentHash hash;
+    hash.updateVector(vertices);
+    hash.updateVector(triangles);
+    hash.updateValue(static_cast<uint8_t>(1));  // Quantized AABB compression
+    return hash.finish();
+}
+
+std::string GetBvhCachePath(const std::string& directory, uint64_t contentHash) {
+    return (std::filesystem::path(directory) / ("bvh_" + ContentHash::toHex(contentHash) + ".bin")).string();
+}
+
+void FillBvhCacheHeader(BvhCacheHeader& header, uint64_t contentHash, uint64_t dataSize) {
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BVH_CACHE_MAGIC, sizeof(header.magic));
+    header.version = BVH_CACHE_VERSION;
+    header.bulletVersion = BT_BULLET_VERSION;
+    header.scalarSize = sizeof(btScalar);
+    header.pointerSize = sizeof(void*);
+    header.contentHash = contentHash;
+    header.dataSize = dataSize;
+}
+
+// Map a cached BVH and fix it up in place. Returns nullptr if there is no usable cache entry.
+btOptimizedBvh* LoadCachedBvh(const std::string& path, uint64_t contentHash, std::unique_ptr<MappedFile>& mapping) {
+    auto file = std::make_unique<MappedFile>();
+    // deSerializeInPlace patches pointers inside the buffer, so the pages must be writable
+    if (!file->open(path, MappedFile::Access::CopyOnWrite) || file->size() < sizeof(BvhCacheHeader)) {
+        return nullptr;
+    }
+    
+    BvhCacheHeader expected;
+    BvhCacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    FillBvhCacheHeader(expected, contentHash, header.dataSize);
+    if (std::memcmp(&header, &expected, sizeof(header)) != 0 ||
+        header.dataSize > file->size() - sizeof(BvhCacheHeader)) {
+        std::cerr << "BulletCollisionShapes::CreateTriangleMesh: Ignoring stale BVH cache " << path << std::endl;
+        return nullptr;
+    }
+    
+    btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(file->data() + sizeof(BvhCacheHeader),
+                                                             static_cast<unsigned int>(header.dataSize), false);
+    if (bvh) {
+        mapping = std::move(file);
+    }
+    return bvh;
+}
+
+void StoreCachedBvh(const std::string& directory, const std::string& path, uint64_t contentHash, const btOptimizedBvh* bvh) {
+    unsigned int dataSize = bvh->calculateSerializeBufferSize();
+    void* buffer = btAlignedAlloc(dataSize, 16);
+    if (!bvh->serializeInPlace(buffer, dataSize, false)) {
+        btAlignedFree(buffer);
+        return;
+    }
+    
+    BvhCacheHeader header;
+    FillBvhCacheHeader(header, contentHash, dataSize);
+    
+    // Write to a temporary file and rename, so a concurrent reader never maps a partial file
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(buffer), dataSize);
+        if (!file) {
+            std::cerr << "BulletCollisionShapes::CreateTriangleMesh: Failed to write BVH cache " << tempPath << std::endl;
+        }
+    }
+    btAlignedFree(buffer);
+    
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+    }
+}
+
+} // namespace
 
 btBoxShape* BulletCollisionShapes::CreateBox(const glm::vec3& halfExtents) {
+    BulletMemory::ScopedObjectBlock objectBlock;
     btBoxShape* shape = new btBoxShape(glmToBullet(halfExtents));
     shape->setMargin(0.01f); // Increased collision margin for better contact resolution
     return shape;
 }
 
 btSphereShape* BulletCollisionShapes::CreateSphere(float radius) {
+    BulletMemory::ScopedObjectBlock objectBlock;
     btSphereShape* shape = new btSphereShape(radius);
     // Don't override margin for spheres - let Bullet handle it naturally
     return shape;
 }
 
 btCylinderShape* BulletCollisionShapes::CreateCylinder(const glm::vec3& halfExtents) {
+    BulletMemory::ScopedObjectBlock objectBlock;
     return new btCylinderShape(glmToBullet(halfExtents));
 }
 
 btCapsuleShape* BulletCollisionShapes::CreateCapsule(float radius, float height) {
+    BulletMemory::ScopedObjectBlock objectBlock;
     return new btCapsuleShape(radius, height);
 }
 
 btStaticPlaneShape* BulletCollisionShapes::CreatePlane(const glm::vec3& normal, float constant) {
+    BulletMemory::ScopedObjectBlock objectBlock;
     btStaticPlaneShape* shape = new btStaticPlaneShape(glmToBullet(normal), constant);
     shape->setMargin(0.01f); // Set collision margin
     return shape;
@@ -36,6 +210,7 @@ btConvexHullShape* BulletCollisionShapes::CreateConvexHull(const std::vector<glm
         return nullptr;
     }
     
+    BulletMemory::ScopedObjectBlock objectBlock;
     btConvexHullShape* hull = new btConvexHullShape();
     
     for (const auto& vertex : vertices) {
@@ -45,6 +220,11 @@ btConvexHullShape* BulletCollisionShapes::CreateConvexHull(const std::vector<glm
     // Optimize the hull
     hull->optimizeConvexHull();
     
+    std::vector<glm::vec3> hullVertices;
+    std::vector<glm::ivec3> hullTriangles;
+    TriangulateHull(vertices, hullVertices, hullTriangles);
+    RegisterMassProperties(hull, MassPropertiesCache::getInstance().get(hullVertices, hullTriangles));
+    
     return hull;
 }
 
@@ -55,7 +235,11 @@ btBvhTriangleMeshShape* BulletCollisionShapes::CreateTriangleMesh(const std::vec
         return nullptr;
     }
     
+    BulletMemory::ScopedCategory category(BulletMemoryCategory::Shape);
     btTriangleMesh* mesh = new btTriangleMesh();
+    // addTriangle appends three vertices and three indices per triangle
+    mesh->preallocateVertices(static_cast<int>(triangles.size() * 3));
+    mesh->preallocateIndices(static_cast<int>(triangles.size() * 3));
     
     for (const auto& triangle : triangles) {
         if (triangle.x >= 0 && triangle.x < vertices.size() &&
@@ -70,10 +254,92 @@ btBvhTriangleMeshShape* BulletCollisionShapes::CreateTriangleMesh(const std::vec
         }
     }
     
-    return new btBvhTriangleMeshShape(mesh, true);
+    std::string cacheDirectory = GetBvhCacheDirectory();
+    uint64_t contentHash = 0;
+    std::string cachePath;
+    TriangleMeshResources resources;
+    resources.meshInterface = mesh;
+    
+    btBvhTriangleMeshShape* shape = nullptr;
+    if (!cacheDirectory.empty()) {
+        contentHash = HashTriangleMesh(vertices, triangles);
+        cachePath = GetBvhCachePath(cacheDirectory, contentHash);
+        
+        btOptimizedBvh* bvh = LoadCachedBvh(cachePath, contentHash, resources.bvhMapping);
+        if (bvh) {
+            // The shape does not own a BVH set this way; the mapping is released in DeleteShape
+            BulletMemory::ScopedObjectBlock objectBlock;
+            shape = new btBvhTriangleMeshShape(mesh, true, false);
+            shape->setOptimizedBvh(bvh);
+        }
+    }
+    
+    if (!shape) {
+        {
+            BulletMemory::ScopedObjectBlock objectBlock;
+            shape = new btBvhTriangleMeshShape(mesh, true);
+        }
+        if (!cacheDirectory.empty()) {
+            StoreCachedBvh(cacheDirectory, cachePath, contentHash, shape->getOptimizedBvh());
+        }
+    }
+    
+    RegisterMassProperties(shape, MassPropertiesCache::getInstance().get(vertices, triangles));
+    
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    s_triangleMeshResources.emplace(shape, std::move(resources));
+    return shape;
+}
+
+void BulletCollisionShapes::SetBvhCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    s_bvhCacheDirectory = directory;
+}
+
+std::string BulletCollisionShapes::GetBvhCacheDirectory() {
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    return s_bvhCacheDirectory;
+}
+
+btHeightfieldTerrainShape* BulletCollisionShapes::CreateHeightfield(const Terrain& terrain) {
+    const std::vector<float>& heights = terrain.getHeightData();
+    if (heights.empty()) {
+        std::cerr << "BulletCollisionShapes::CreateHeightfield: Terrain has no height data!" << std::endl;
+        return nullptr;
+    }
+    
+    glm::vec2 heightRange = terrain.getHeightRange();
+    return CreateHeightfield(heights.data(), terrain.getGridWidth(), terrain.getGridLength(),
+                             terrain.getGridScale(), heightRange.x, heightRange.y);
+}
+
+btHeightfieldTerrainShape* BulletCollisionShapes::CreateHeightfield(const float* heights, int width, int length,
+                                                                    float gridSpacing, float minHeight, float maxHeight) {
+    if (!heights || width < 2 || length < 2 || gridSpacing <= 0.0f || minHeight > maxHeight) {
+        std::cerr << "BulletCollisionShapes::CreateHeightfield: Invalid input data!" << std::endl;
+        return nullptr;
+    }
+    
+    // Y up; the default quad split (diagonal from (x, z+1) to (x+1, z)) matches TerrainGenerator's triangles
+    BulletMemory::ScopedObjectBlock objectBlock;
+    btHeightfieldTerrainShape* shape = new btHeightfieldTerrainShape(width, length, heights, minHeight, maxHeight, 1, false);
+    shape->setLocalScaling(btVector3(gridSpacing, 1.0f, gridSpacing));
+    
+    // Per-chunk height ranges let raycasts skip empty regions
+    shape->buildAccelerator();
+    return shape;
+}
+
+glm::vec3 BulletCollisionShapes::GetHeightfieldOrigin(const Terrain& terrain) {
+    // Terrain vertices start at -(samples / 2) * scale while Bullet's grid starts at
+    // -(samples - 1) / 2 * scale, and Bullet centers the height range on the origin
+    float scale = terrain.getGridScale();
+    glm::vec2 heightRange = terrain.getHeightRange();
+    return glm::vec3(-0.5f * scale, 0.5f * (heightRange.x + heightRange.y), -0.5f * scale);
 }
 
 btCompoundShape* BulletCollisionShapes::CreateCompoundShape() {
+    BulletMemory::ScopedObjectBlock objectBlock;
     return new btCompoundShape();
 }
 
@@ -96,9 +362,27 @@ void BulletCollisionShapes::AddChildShape(btCompoundShape* compound, btCollision
 }
 
 void BulletCollisionShapes::DeleteShape(btCollisionShape* shape) {
-    if (shape) {
-        delete shape;
+    if (!shape) {
+        return;
+    }
+    
+    TriangleMeshResources resources;
+    if (shape->getShapeType() == CONVEX_HULL_SHAPE_PROXYTYPE) {
+        std::lock_guard<std::mutex> lock(s_cacheMutex);
+        s_massProperties.erase(shape);
+    } else if (shape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+        std::lock_guard<std::mutex> lock(s_cacheMutex);
+        s_massProperties.erase(shape);
+        auto it = s_triangleMeshResources.find(shape);
+        if (it != s_triangleMeshResources.end()) {
+            resources = std::move(it->second);
+            s_triangleMeshResources.erase(it);
+        }
     }
+    
+    // The shape references the mesh interface and the mapped BVH, so it goes first
+    delete shape;
+    delete resources.meshInterface;
 }
 
 float BulletCollisionShapes::CalculateVolume(btCollisionShape* shape) {
@@ -133,6 +417,11 @@ float BulletCollisionShapes::CalculateVolume(btCollisionShape* shape) {
             float cylinderVolume = 3.14159f * radius * radius * height;
             return sphereVolume + cylinderVolume;
         }
+        case CONVEX_HULL_SHAPE_PROXYTYPE:
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+            MassProperties properties;
+            return FindMassProperties(shape, properties) ? properties.volume : 0.0f;
+        }
         default:
             return 0.0f;
     }
@@ -143,12 +432,42 @@ glm::vec3 BulletCollisionShapes::CalculateInertia(btCollisionShape* shape, float
         return glm::vec3(0.0f);
     }
     
+    // Bullet approximates hulls and meshes by their bounding box; use the integrated
+    // tensor instead. Bodies rotate about the shape origin, so the tensor is moved there;
+    // Bullet keeps only the diagonal, i.e. the moments about the shape's own axes.
+    MassProperties properties;
+    if (FindMassProperties(shape, properties)) {
+        glm::mat3 tensor = properties.getInertiaAboutOrigin(mass);
+        return glm::vec3(tensor[0][0], tensor[1][1], tensor[2][2]);
+    }
+    
     btVector3 inertia(0, 0, 0);
     shape->calculateLocalInertia(mass, inertia);
     
     return bulletToGlm(inertia);
 }
 
+bool BulletCollisionShapes::GetMassProperties(btCollisionShape* shape, float& volume, glm::vec3& centerOfMass,
+                                              glm::mat3& inertia) {
+    MassProperties properties;
+    if (!FindMassProperties(shape, properties)) {
+        return false;
+    }
+    
+    volume = properties.volume;
+    centerOfMass = properties.centerOfMass;
+    inertia = properties.inertia;
+    return true;
+}
+
+void BulletCollisionShapes::SetMassPropertiesCacheDirectory(const std::string& directory) {
+    MassPropertiesCache::getInstance().setCacheDirectory(directory);
+}
+
+std::string BulletCollisionShapes::GetMassPropertiesCacheDirectory() {
+    return MassPropertiesCache::getInstance().getCacheDirectory();
+}
+
 bool BulletCollisionShapes::IsValidShape(btCollisionShape* shape) {
     if (!shape) {
         return false;
@@ -0,0 +1,641 @@
+#include "bullet/BulletMemory.h"
+#include <btBulletDynamicsCommon.h>
+#include <LinearMath/btAlignedAllocator.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+    constexpr int CATEGORY_COUNT = static_cast<int>(BulletMemoryCategory::Count);
+
+    // Every block starts with a 16 byte header so user pointers keep Bullet's 16 byte alignment
+    constexpr size_t HEADER_SIZE = 16;
+    constexpr size_t BLOCK_ALIGNMENT = 16;
+    constexpr size_t CHUNK_SIZE = 64 * 1024;   // Also the alignment of chunks and large blocks
+    constexpr size_t MIN_SLOTS_PER_CHUNK = 8;
+
+    // Pooled block capacities; larger or over-aligned requests go to malloc
+    constexpr size_t SIZE_CLASSES[] = {
+        32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096
+    };
+    constexpr int NUM_SIZE_CLASSES = static_cast<int>(sizeof(SIZE_CLASSES) / sizeof(SIZE_CLASSES[0]));
+    static_assert((HEADER_SIZE + SIZE_CLASSES[NUM_SIZE_CLASSES - 1]) * MIN_SLOTS_PER_CHUNK <= CHUNK_SIZE,
+                  "Every size class must fit MIN_SLOTS_PER_CHUNK slots in a chunk");
+
+    constexpr uint32_t BLOCK_MAGIC = 0xB17A11C0;
+    constexpr uint8_t LARGE_BLOCK = 0xFF;
+    constexpr uint8_t FLAG_OBJECT_BLOCK = 0x01;
+
+    struct alignas(16) BlockHeader {
+        uint32_t magic;            // BLOCK_MAGIC mixed with the user pointer
+        uint8_t sizeClass;         // Index into SIZE_CLASSES or LARGE_BLOCK
+        uint8_t category;          // BulletMemoryCategory
+        uint8_t flags;
+        uint8_t trailerOffset16;   // Object blocks: offset of the trailer in 16 byte units
+        BulletMemoryArena* arena;
+    };
+    static_assert(sizeof(BlockHeader) == HEADER_SIZE, "BlockHeader must keep 16 byte alignment");
+
+    // Stored in front of the header of large blocks
+    struct alignas(16) LargePrefix {
+        void* raw;
+        size_t size;
+    };
+    static_assert(sizeof(LargePrefix) % BLOCK_ALIGNMENT == 0, "LargePrefix must keep 16 byte alignment");
+
+    // Lives between the shape and the body/motion state storage of an object block
+    struct ObjectBlockTrailer {
+        std::atomic<int> residents;    // Shape + claimed slots still alive
+        std::atomic<bool> claimed;
+    };
+
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    constexpr size_t TRAILER_SIZE = (sizeof(ObjectBlockTrailer) + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+    constexpr size_t MOTION_STATE_SIZE = (sizeof(btDefaultMotionState) + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+    constexpr size_t BODY_SIZE = (sizeof(btRigidBody) + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+    constexpr size_t OBJECT_SLOTS_SIZE = TRAILER_SIZE + MOTION_STATE_SIZE + BODY_SIZE;
+
+    uint32_t MakeMagic(const void* user) {
+        return BLOCK_MAGIC ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(user) >> 4);
+    }
+
+    BlockHeader* GetHeader(void* user) {
+        return reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(user) - HEADER_SIZE);
+    }
+
+    // CHUNK_SIZE aligned memory, so masking any pointer into it gives its chunk
+    void* AllocateChunks(size_t size, size_t alignment) {
+#ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+#else
+        void* memory = nullptr;
+        return posix_memalign(&memory, alignment, size) == 0 ? memory : nullptr;
+#endif
+    }
+
+    void FreeChunks(void* memory) {
+#ifdef _WIN32
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+
+    uintptr_t GetChunkIndex(const void* address) {
+        return reinterpret_cast<uintptr_t>(address) / CHUNK_SIZE;
+    }
+
+    // Which chunks of the address space the arenas own, one byte per chunk in a two level
+    // map covering 48 bit addresses. Chunks are wholly owned (large blocks are rounded up
+    // to whole chunks), so a pointer's header is only read once its chunk is known to be
+    // ours and memory in front of foreign pointers (Bullet's default allocator, shapes not
+    // created through btAlignedAlloc) is never touched. Lookups are two atomic loads;
+    // leaves are created on first use and never freed.
+    class ChunkMap {
+    public:
+        bool add(const void* chunk) {
+            return store(chunk, 1);
+        }
+
+        void remove(const void* chunk) {
+            store(chunk, 0);
+        }
+
+        bool contains(const void* address) const {
+            uintptr_t index = GetChunkIndex(address);
+            if ((index >> LEAF_BITS) >= ROOT_SIZE) {
+                return false;
+            }
+            Leaf* leaf = m_root[index >> LEAF_BITS].load(std::memory_order_acquire);
+            return leaf && leaf->owned[index & (LEAF_SIZE - 1)].load(std::memory_order_acquire) != 0;
+        }
+
+    private:
+        static constexpr int LEAF_BITS = 16;
+        static constexpr size_t LEAF_SIZE = size_t(1) << LEAF_BITS;
+        static constexpr size_t ROOT_SIZE = size_t(1) << 16;
+
+        struct Leaf {
+            std::atomic<uint8_t> owned[LEAF_SIZE];
+        };
+
+        bool store(const void* chunk, uint8_t owned) {
+            uintptr_t index = GetChunkIndex(chunk);
+            if ((index >> LEAF_BITS) >= ROOT_SIZE) {
+                return false;
+            }
+
+            std::atomic<Leaf*>& slot = m_root[index >> LEAF_BITS];
+            Leaf* leaf = slot.load(std::memory_order_acquire);
+            if (!leaf) {
+                Leaf* created = new (std::nothrow) Leaf();
+                if (!created) {
+                    return false;
+                }
+                if (slot.compare_exchange_strong(leaf, created, std::memory_order_acq_rel)) {
+                    leaf = created;
+                } else {
+                    delete created;
+                }
+            }
+            leaf->owned[index & (LEAF_SIZE - 1)].store(owned, std::memory_order_release);
+            return true;
+        }
+
+        std::atomic<Leaf*> m_root[ROOT_SIZE];
+    };
+
+    // Zero initialized before any dynamic initialization and never destroyed, so
+    // allocations from other static constructors and frees during static destruction work
+    ChunkMap g_chunkMap;
+
+    // Start of a live block of some arena (not merely a pointer into one)
+    bool IsOwnBlock(void* user) {
+        return g_chunkMap.contains(user) && GetHeader(user)->magic == MakeMagic(user);
+    }
+
+    ObjectBlockTrailer* GetTrailer(void* user) {
+        return reinterpret_cast<ObjectBlockTrailer*>(static_cast<uint8_t*>(user) + GetHeader(user)->trailerOffset16 * BLOCK_ALIGNMENT);
+    }
+
+    int FindSizeClass(size_t size) {
+        for (int i = 0; i < NUM_SIZE_CLASSES; ++i) {
+            if (size <= SIZE_CLASSES[i]) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    struct CategoryCounters {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+        std::atomic<uint64_t> liveBytes{0};
+        std::atomic<uint64_t> peakBytes{0};
+
+        void addBytes(uint64_t bytes) {
+            uint64_t live = liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            uint64_t peak = peakBytes.load(std::memory_order_relaxed);
+            while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+            }
+        }
+
+        void removeBytes(uint64_t bytes) {
+            liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+
+        BulletMemoryStats snapshot() const {
+            BulletMemoryStats stats;
+            stats.allocations = allocations.load(std::memory_order_relaxed);
+            stats.frees = frees.load(std::memory_order_relaxed);
+            stats.liveBytes = liveBytes.load(std::memory_order_relaxed);
+            stats.peakBytes = peakBytes.load(std::memory_order_relaxed);
+            return stats;
+        }
+    };
+
+    CategoryCounters g_totals[CATEGORY_COUNT];
+    std::atomic<bool> g_installed{false};
+
+    thread_local BulletMemoryArena* t_currentArena = nullptr;
+    thread_local BulletMemoryCategory t_category = BulletMemoryCategory::Other;
+    thread_local bool t_objectBlockPending = false;
+}
+
+/**
+ * BulletMemoryArena - Size-class pools backing one world's allocations
+ */
+class BulletMemoryArena {
+public:
+    explicit BulletMemoryArena(const char* name)
+        : m_name(name ? name : "Arena")
+    {
+    }
+
+    ~BulletMemoryArena() {
+        // Bulk release: every chunk goes back at once
+        for (void* chunk : m_chunks) {
+            g_chunkMap.remove(chunk);
+            FreeChunks(chunk);
+        }
+    }
+
+    BulletMemoryArena(const BulletMemoryArena&) = delete;
+    BulletMemoryArena& operator=(const BulletMemoryArena&) = delete;
+
+    const std::string& getName() const { return m_name; }
+
+    void* allocate(size_t size, size_t alignment) {
+        int sizeClass = alignment <= BLOCK_ALIGNMENT ? FindSizeClass(size) : -1;
+        if (sizeClass < 0) {
+            return allocateLarge(size, alignment);
+        }
+
+        FreeSlot* slot = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_freeLists[sizeClass] && !refill(sizeClass)) {
+                return nullptr;
+            }
+            slot = m_freeLists[sizeClass];
+            m_freeLists[sizeClass] = slot->next;
+            ++m_liveBlocks;
+        }
+
+        void* user = reinterpret_cast<uint8_t*>(slot) + HEADER_SIZE;
+        BlockHeader* header = GetHeader(user);
+        header->magic = MakeMagic(user);
+        header->sizeClass = static_cast<uint8_t>(sizeClass);
+        header->category = static_cast<uint8_t>(BulletMemoryCategory::Other);
+        header->flags = 0;
+        header->trailerOffset16 = 0;
+        header->arena = this;
+        return user;
+    }
+
+    // Returns true if this was the last block of a released arena (caller deletes it)
+    bool deallocate(void* user) {
+        BlockHeader* header = GetHeader(user);
+        uint8_t sizeClass = header->sizeClass;
+        header->magic = 0;
+
+        if (sizeClass == LARGE_BLOCK) {
+            LargePrefix* prefix = reinterpret_cast<LargePrefix*>(reinterpret_cast<uint8_t*>(header) - sizeof(LargePrefix));
+            g_chunkMap.remove(user);
+            FreeChunks(prefix->raw);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (sizeClass != LARGE_BLOCK) {
+            FreeSlot* slot = reinterpret_cast<FreeSlot*>(header);
+            slot->next = m_freeLists[sizeClass];
+            m_freeLists[sizeClass] = slot;
+        }
+        --m_liveBlocks;
+        return m_ownerReleased && m_liveBlocks == 0;
+    }
+
+    // Returns true if the arena has no blocks left (caller deletes it)
+    bool release() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ownerReleased = true;
+        return m_liveBlocks == 0;
+    }
+
+    static uint64_t getBlockBytes(void* user) {
+        BlockHeader* header = GetHeader(user);
+        if (header->sizeClass == LARGE_BLOCK) {
+            return reinterpret_cast<LargePrefix*>(reinterpret_cast<uint8_t*>(header) - sizeof(LargePrefix))->size;
+        }
+        return SIZE_CLASSES[header->sizeClass];
+    }
+
+    CategoryCounters m_stats[CATEGORY_COUNT];
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    bool refill(int sizeClass) {
+        size_t slotSize = HEADER_SIZE + SIZE_CLASSES[sizeClass];
+        size_t slotCount = CHUNK_SIZE / slotSize;
+
+        uint8_t* chunk = static_cast<uint8_t*>(AllocateChunks(CHUNK_SIZE, CHUNK_SIZE));
+        if (!chunk) {
+            std::cerr << "BulletMemoryArena::refill: Out of memory!" << std::endl;
+            return false;
+        }
+        if (!g_chunkMap.add(chunk)) {
+            std::cerr << "BulletMemoryArena::refill: Chunk address out of range!" << std::endl;
+            FreeChunks(chunk);
+            return false;
+        }
+        m_chunks.push_back(chunk);
+
+        for (size_t i = slotCount; i-- > 0;) {
+            FreeSlot* slot = reinterpret_cast<FreeSlot*>(chunk + i * slotSize);
+            slot->next = m_freeLists[sizeClass];
+            m_freeLists[sizeClass] = slot;
+        }
+        return true;
+    }
+
+    void* allocateLarge(size_t size, size_t alignment) {
+        alignment = std::max(alignment, BLOCK_ALIGNMENT);
+
+        // Whole chunks, so no foreign allocation shares the chunk the block is found by
+        size_t total = AlignUp(size + alignment + HEADER_SIZE + sizeof(LargePrefix), CHUNK_SIZE);
+        void* raw = AllocateChunks(total, std::max(alignment, CHUNK_SIZE));
+        if (!raw) {
+            return nullptr;
+        }
+
+        uintptr_t first = reinterpret_cast<uintptr_t>(raw) + HEADER_SIZE + sizeof(LargePrefix);
+        void* user = reinterpret_cast<void*>(AlignUp(first, alignment));
+        if (!g_chunkMap.add(user)) {
+            std::cerr << "BulletMemoryArena::allocateLarge: Block address out of range!" << std::endl;
+            FreeChunks(raw);
+            return nullptr;
+        }
+
+        BlockHeader* header = GetHeader(user);
+        header->magic = MakeMagic(user);
+        header->sizeClass = LARGE_BLOCK;
+        header->category = static_cast<uint8_t>(BulletMemoryCategory::Other);
+        header->flags = 0;
+        header->trailerOffset16 = 0;
+        header->arena = this;
+
+        LargePrefix* prefix = reinterpret_cast<LargePrefix*>(reinterpret_cast<uint8_t*>(header) - sizeof(LargePrefix));
+        prefix->raw = raw;
+        prefix->size = size;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_liveBlocks;
+        return user;
+    }
+
+    std::string m_name;
+    FreeSlot* m_freeLists[NUM_SIZE_CLASSES] = {};
+    std::vector<void*> m_chunks;
+    size_t m_liveBlocks = 0;
+    bool m_ownerReleased = false;
+
+    // Thread safety (blocks may be freed from any thread)
+    std::mutex m_mutex;
+};
+
+namespace {
+    // Process-wide fallback arena, intentionally never destroyed so blocks freed
+    // during static destruction stay valid
+    BulletMemoryArena* DefaultArena() {
+        static BulletMemoryArena* arena = new BulletMemoryArena("Default");
+        return arena;
+    }
+
+    void RecordAllocation(BulletMemoryArena* arena, BulletMemoryCategory category, uint64_t bytes) {
+        int index = static_cast<int>(category);
+        g_totals[index].allocations.fetch_add(1, std::memory_order_relaxed);
+        g_totals[index].addBytes(bytes);
+        arena->m_stats[index].allocations.fetch_add(1, std::memory_order_relaxed);
+        arena->m_stats[index].addBytes(bytes);
+    }
+
+    void RecordFree(BulletMemoryArena* arena, BulletMemoryCategory category, uint64_t bytes) {
+        int index = static_cast<int>(category);
+        g_totals[index].frees.fetch_add(1, std::memory_order_relaxed);
+        g_totals[index].removeBytes(bytes);
+        arena->m_stats[index].frees.fetch_add(1, std::memory_order_relaxed);
+        arena->m_stats[index].removeBytes(bytes);
+    }
+
+    // Moves live bytes between categories without counting an allocation
+    void TransferBytes(BulletMemoryArena* arena, BulletMemoryCategory from, BulletMemoryCategory to, uint64_t bytes) {
+        g_totals[static_cast<int>(from)].removeBytes(bytes);
+        g_totals[static_cast<int>(to)].addBytes(bytes);
+        arena->m_stats[static_cast<int>(from)].removeBytes(bytes);
+        arena->m_stats[static_cast<int>(to)].addBytes(bytes);
+    }
+
+    void ReleaseBlock(void* user) {
+        BlockHeader* header = GetHeader(user);
+        BulletMemoryArena* arena = header->arena;
+        RecordFree(arena, static_cast<BulletMemoryCategory>(header->category), BulletMemoryArena::getBlockBytes(user));
+        if (arena->deallocate(user)) {
+            delete arena;
+        }
+    }
+
+    void* AlignedAllocate(size_t size, int alignment) {
+        BulletMemoryArena* arena = t_currentArena ? t_currentArena : DefaultArena();
+        size_t blockAlignment = alignment > 0 ? static_cast<size_t>(alignment) : BLOCK_ALIGNMENT;
+
+        // The first allocation inside a ScopedObjectBlock is the shape itself
+        size_t trailerOffset = 0;
+        bool objectBlock = false;
+        if (t_objectBlockPending) {
+            t_objectBlockPending = false;
+            trailerOffset = AlignUp(size, BLOCK_ALIGNMENT);
+            if (blockAlignment <= BLOCK_ALIGNMENT && trailerOffset / BLOCK_ALIGNMENT <= 0xFF) {
+                objectBlock = true;
+                size = trailerOffset + OBJECT_SLOTS_SIZE;
+            }
+        }
+
+        void* user = arena->allocate(size, blockAlignment);
+        if (!user) {
+            return nullptr;
+        }
+
+        BlockHeader* header = GetHeader(user);
+        header->category = static_cast<uint8_t>(t_category);
+        if (objectBlock) {
+            header->flags |= FLAG_OBJECT_BLOCK;
+            header->trailerOffset16 = static_cast<uint8_t>(trailerOffset / BLOCK_ALIGNMENT);
+            ObjectBlockTrailer* trailer = new (static_cast<uint8_t*>(user) + trailerOffset) ObjectBlockTrailer;
+            trailer->residents.store(1);
+            trailer->claimed.store(false);
+        }
+
+        RecordAllocation(arena, t_category, BulletMemoryArena::getBlockBytes(user));
+        return user;
+    }
+
+    void AlignedFree(void* user) {
+        if (!user) {
+            return;
+        }
+
+        if (!g_chunkMap.contains(user)) {
+            // Allocated by Bullet's default allocator before BulletMemory was installed
+            std::free(static_cast<void**>(user)[-1]);
+            return;
+        }
+
+        BlockHeader* header = GetHeader(user);
+        if (header->flags & FLAG_OBJECT_BLOCK) {
+            // The shape is gone, but a body may still live in the block
+            if (GetTrailer(user)->residents.fetch_sub(1) != 1) {
+                return;
+            }
+        }
+        ReleaseBlock(user);
+    }
+
+    void* Allocate(size_t size) {
+        return AlignedAllocate(size, static_cast<int>(BLOCK_ALIGNMENT));
+    }
+
+    // Installs the allocators before any Bullet object is created
+    struct AutoInstall {
+        AutoInstall() { BulletMemory::Install(); }
+    };
+    AutoInstall g_autoInstall;
+}
+
+void BulletMemory::Install() {
+    bool expected = false;
+    if (g_installed.compare_exchange_strong(expected, true)) {
+        btAlignedAllocSetCustom(Allocate, AlignedFree);
+        btAlignedAllocSetCustomAligned(AlignedAllocate, AlignedFree);
+    }
+}
+
+bool BulletMemory::IsInstalled() {
+    return g_installed.load();
+}
+
+BulletMemoryArena* BulletMemory::CreateArena(const char* name) {
+    return new BulletMemoryArena(name);
+}
+
+void BulletMemory::ReleaseArena(BulletMemoryArena* arena) {
+    if (!arena || arena == DefaultArena()) {
+        return;
+    }
+    if (t_currentArena == arena) {
+        t_currentArena = nullptr;
+    }
+    if (arena->release()) {
+        delete arena;
+    }
+}
+
+BulletMemoryArena* BulletMemory::GetCurrentArena() {
+    return t_currentArena;
+}
+
+void BulletMemory::SetCurrentArena(BulletMemoryArena* arena) {
+    t_currentArena = arena;
+}
+
+BulletMemory::ObjectSlots BulletMemory::ClaimObjectSlots(btCollisionShape* shape) {
+    ObjectSlots slots;
+    if (!shape || !IsInstalled() || !IsOwnBlock(shape)) {
+        return slots;
+    }
+
+    BlockHeader* header = GetHeader(shape);
+    if (!(header->flags & FLAG_OBJECT_BLOCK)) {
+        return slots;
+    }
+
+    ObjectBlockTrailer* trailer = GetTrailer(shape);
+    bool expected = false;
+    if (!trailer->claimed.compare_exchange_strong(expected, true)) {
+        return slots;
+    }
+    trailer->residents.fetch_add(1);
+
+    // Attribute the reserved storage to the objects placed in it
+    BulletMemoryCategory blockCategory = static_cast<BulletMemoryCategory>(header->category);
+    TransferBytes(header->arena, blockCategory, BulletMemoryCategory::MotionState, MOTION_STATE_SIZE);
+    TransferBytes(header->arena, blockCategory, BulletMemoryCategory::Body, BODY_SIZE);
+    header->arena->m_stats[static_cast<int>(BulletMemoryCategory::MotionState)].allocations.fetch_add(1, std::memory_order_relaxed);
+    header->arena->m_stats[static_cast<int>(BulletMemoryCategory::Body)].allocations.fetch_add(1, std::memory_order_relaxed);
+    g_totals[static_cast<int>(BulletMemoryCategory::MotionState)].allocations.fetch_add(1, std::memory_order_relaxed);
+    g_totals[static_cast<int>(BulletMemoryCategory::Body)].allocations.fetch_add(1, std::memory_order_relaxed);
+
+    uint8_t* base = reinterpret_cast<uint8_t*>(trailer);
+    slots.block = shape;
+    slots.motionState = base + TRAILER_SIZE;
+    slots.body = base + TRAILER_SIZE + MOTION_STATE_SIZE;
+    return slots;
+}
+
+void BulletMemory::ReleaseObjectSlots(void* block) {
+    if (!block) {
+        return;
+    }
+
+    BlockHeader* header = GetHeader(block);
+    BulletMemoryCategory blockCategory = static_cast<BulletMemoryCategory>(header->category);
+    TransferBytes(header->arena, BulletMemoryCategory::MotionState, blockCategory, MOTION_STATE_SIZE);
+    TransferBytes(header->arena, BulletMemoryCategory::Body, blockCategory, BODY_SIZE);
+    header->arena->m_stats[static_cast<int>(BulletMemoryCategory::MotionState)].frees.fetch_add(1, std::memory_order_relaxed);
+    header->arena->m_stats[static_cast<int>(BulletMemoryCategory::Body)].frees.fetch_add(1, std::memory_order_relaxed);
+    g_totals[static_cast<int>(BulletMemoryCategory::MotionState)].frees.fetch_add(1, std::memory_order_relaxed);
+    g_totals[static_cast<int>(BulletMemoryCategory::Body)].frees.fetch_add(1, std::memory_order_relaxed);
+
+    ObjectBlockTrailer* trailer = GetTrailer(block);
+    trailer->claimed.store(false);
+    if (trailer->residents.fetch_sub(1) == 1) {
+        // The shape was deleted first
+        ReleaseBlock(block);
+    }
+}
+
+BulletMemoryStats BulletMemory::GetStats(BulletMemoryCategory category, const BulletMemoryArena* arena) {
+    int index = static_cast<int>(category);
+    if (index < 0 || index >= CATEGORY_COUNT) {
+        return BulletMemoryStats();
+    }
+    return arena ? arena->m_stats[index].snapshot() : g_totals[index].snapshot();
+}
+
+void BulletMemory::PrintStatistics(const BulletMemoryArena* arena) {
+    std::cout << "=== Bullet Memory Statistics (" << (arena ? arena->getName() : std::string("all arenas")) << ") ===" << std::endl;
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        BulletMemoryCategory category = static_cast<BulletMemoryCategory>(i);
+        BulletMemoryStats stats = GetStats(category, arena);
+        std::cout << std::left << std::setw(12) << GetCategoryName(category) << std::right
+                  << " allocations: " << std::setw(8) << stats.allocations
+                  << " frees: " << std::setw(8) << stats.frees
+                  << " live: " << std::setw(10) << stats.liveBytes << " B"
+                  << " peak: " << std::setw(10) << stats.peakBytes << " B" << std::endl;
+    }
+}
+
+const char* BulletMemory::GetCategoryName(BulletMemoryCategory category) {
+    switch (category) {
+        case BulletMemoryCategory::Body: return "Body";
+        case BulletMemoryCategory::MotionState: return "MotionState";
+        case BulletMemoryCategory::Shape: return "Shape";
+        case BulletMemoryCategory::Other: return "Other";
+        case BulletMemoryCategory::Count: break;
+    }
+    return "unknown";
+}
+
+BulletMemory::ScopedArena::ScopedArena(BulletMemoryArena* arena)
+    : m_previous(t_currentArena)
+{
+    t_currentArena = arena;
+}
+
+BulletMemory::ScopedArena::~ScopedArena() {
+    t_currentArena = m_previous;
+}
+
+BulletMemory::ScopedCategory::ScopedCategory(BulletMemoryCategory category)
+    : m_previous(t_category)
+{
+    t_category = category;
+}
+
+BulletMemory::ScopedCategory::~ScopedCategory() {
+    t_category = m_previous;
+}
+
+BulletMemory::ScopedObjectBlock::ScopedObjectBlock()
+    : m_category(BulletMemoryCategory::Shape)
+{
+    t_objectBlockPending = true;
+}
+
+BulletMemory::ScopedObjectBlock::~ScopedObjectBlock() {
+    t_objectBlockPending = false;
+}
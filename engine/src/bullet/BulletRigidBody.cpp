@@ -1,4 +1,6 @@
 #include "bullet/BulletRigidBody.h"
+#include "bullet/BulletMemory.h"
+#include "bullet/BulletCollisionShapes.h"
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -9,6 +11,7 @@ BulletRigidBody::BulletRigidBody(btCollisionShape* shape, float mass,
     : m_rigidBody(nullptr)
     , m_collisionShape(shape)
     , m_motionState(nullptr)
+    , m_objectBlock(nullptr)
     , m_mass(mass)
     , m_isStatic(mass == 0.0f)
 {
@@ -25,19 +28,31 @@ BulletRigidBody::BulletRigidBody(btCollisionShape* shape, float mass,
     glm::quat rotationQuat = glm::quat(glm::radians(rotation));
     m_transform.setRotation(glmToBullet(rotationQuat));
     
-    m_motionState = new btDefaultMotionState(m_transform);
+    // Place the body and motion state in the storage reserved behind the shape when available
+    BulletMemory::ObjectSlots slots = BulletMemory::ClaimObjectSlots(shape);
+    m_objectBlock = slots.block;
     
-    // Calculate inertia
-    btVector3 inertia(0, 0, 0);
-    if (mass > 0.0f) {
-        shape->calculateLocalInertia(mass, inertia);
+    if (slots.motionState) {
+        m_motionState = new (slots.motionState) btDefaultMotionState(m_transform);
+    } else {
+        BulletMemory::ScopedCategory category(BulletMemoryCategory::MotionState);
+        m_motionState = new btDefaultMotionState(m_transform);
     }
     
+    // Calculate inertia
+    glm::vec3 localInertia = BulletCollisionShapes::CalculateInertia(shape, mass);
+    btVector3 inertia(localInertia.x, localInertia.y, localInertia.z);
+    
     // Create rigid body construction info
     btRigidBody::btRigidBodyConstructionInfo rbInfo(mass, m_motionState, shape, inertia);
     
     // Create rigid body
-    m_rigidBody = new btRigidBody(rbInfo);
+    if (slots.body) {
+        m_rigidBody = new (slots.body) btRigidBody(rbInfo);
+    } else {
+        BulletMemory::ScopedCategory category(BulletMemoryCategory::Body);
+        m_rigidBody = new btRigidBody(rbInfo);
+    }
     
     // Set physics properties for better collision behavior
     m_rigidBody->setRestitution(0.1f); // Low bounciness
@@ -69,6 +84,21 @@ BulletRigidBody::BulletRigidBody(btCollisionShape* shape, float mass,
 }
 
 BulletRigidBody::~BulletRigidBody() {
+    if (m_objectBlock) {
+        // Objects placed in the shape's block are destroyed in place, the block is shared
+        if (m_rigidBody) {
+            m_rigidBody->~btRigidBody();
+            m_rigidBody = nullptr;
+        }
+        if (m_motionState) {
+            m_motionState->~btMotionState();
+            m_motionState = nullptr;
+        }
+        BulletMemory::ReleaseObjectSlots(m_objectBlock);
+        m_objectBlock = nullptr;
+        return;
+    }
+    
     if (m_rigidBody) {
         delete m_rigidBody;
         m_rigidBody = nullptr;
@@ -248,10 +278,8 @@ void BulletRigidBody::setMass(float mass) {
     m_isStatic = (mass == 0.0f);
     
     // Calculate new inertia
-    btVector3 inertia(0, 0, 0);
-    if (mass > 0.0f) {
-        m_collisionShape->calculateLocalInertia(mass, inertia);
-    }
+    glm::vec3 localInertia = BulletCollisionShapes::CalculateInertia(m_collisionShape, mass);
+    btVector3 inertia(localInertia.x, localInertia.y, localInertia.z);
     
     m_rigidBody->setMassProps(mass, inertia);
     
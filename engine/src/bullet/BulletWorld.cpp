@@ -1,66 +1,731 @@
 #include "bullet/BulletWorld.h"
+#include "../core/ThreadPool.h"
+#include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btPointCollector.h>
+#include <BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
+#include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btNNCGConstraintSolver.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <LinearMath/btThreads.h>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+namespace {
+    // btAxisSweep3 stores edge indices in 16 bits, two edges per proxy
+    constexpr int MAX_AXIS_SWEEP3_PROXIES = 32766;
+    
+    BulletWorldConfig MakeConfigWithGravity(const glm::vec3& gravity) {
+        BulletWorldConfig config;
+        config.gravity = gravity;
+        return config;
+    }
+    
+    // Number of queries handed to a worker at a time
+    constexpr int QUERY_GRAIN_SIZE = 64;
+    
+    // DBVT traversal stack; each batch call owns one per pool thread and reuses it across
+    // its queries, so no scratch memory outlives the call (or pins a world's arena)
+    using QueryStack = btAlignedObjectArray<const btDbvtNode*>;
+    
+    btVector3 ToBullet(const glm::vec3& v) {
+        return btVector3(v.x, v.y, v.z);
+    }
+    
+    glm::vec3 ToGlm(const btVector3& v) {
+        return glm::vec3(v.x(), v.y(), v.z());
+    }
+    
+    btTransform MakeTranslation(const btVector3& origin) {
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(origin);
+        return transform;
+    }
+    
+    btCollisionObject* GetProxyObject(const btDbvtNode* leaf) {
+        btBroadphaseProxy* proxy = static_cast<btDbvtProxy*>(leaf->data);
+        return static_cast<btCollisionObject*>(proxy->m_clientObject);
+    }
+    
+    // Walk both DBVT sets (dynamic and fixed) along a ray or swept box.
+    // Mirrors btDbvtBroadphase::rayTest but with the caller's stack.
+    void RayTestDbvt(const btDbvtBroadphase* dbvt, const btVector3& from, const btVector3& to,
+                     const btVector3& aabbMin, const btVector3& aabbMax, btDbvt::ICollide& policy,
+                     QueryStack& stack) {
+        btVector3 direction = to - from;
+        btScalar length = direction.length();
+        if (length < SIMD_EPSILON) {
+            return;
+        }
+        direction /= length;
+        
+        btVector3 directionInverse(
+            direction[0] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / direction[0],
+            direction[1] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / direction[1],
+            direction[2] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / direction[2]);
+        unsigned int signs[3] = {
+            directionInverse[0] < btScalar(0.0),
+            directionInverse[1] < btScalar(0.0),
+            directionInverse[2] < btScalar(0.0)
+        };
+        
+        for (const btDbvt& set : dbvt->m_sets) {
+            if (set.m_root) {
+                set.rayTestInternal(set.m_root, from, to, directionInverse, signs, length,
+                                    aabbMin, aabbMax, stack, policy);
+            }
+        }
+    }
+    
+    // Leaf callback for batched raycasts: broadphase filter, then exact ray test
+    struct RayLeafCallback : public btDbvt::ICollide {
+        btTransform from;
+        btTransform to;
+        btCollisionWorld::RayResultCallback* result = nullptr;
+        
+        void Process(const btDbvtNode* leaf) {
+            btCollisionObject* object = GetProxyObject(leaf);
+            if (!result->needsCollision(object->getBroadphaseHandle())) {
+                return;
+            }
+            btCollisionWorld::rayTestSingle(from, to, object, object->getCollisionShape(),
+                                            object->getWorldTransform(), *result);
+        }
+    };
+    
+    // Leaf callback for batched sphere sweeps
+    struct SweepLeafCallback : public btDbvt::ICollide {
+        const btConvexShape* castShape = nullptr;
+        btTransform from;
+        btTransform to;
+        btScalar allowedPenetration = 0.0f;
+        btCollisionWorld::ConvexResultCallback* result = nullptr;
+        
+        void Process(const btDbvtNode* leaf) {
+            btCollisionObject* object = GetProxyObject(leaf);
+            if (!result->needsCollision(object->getBroadphaseHandle())) {
+                return;
+            }
+            btCollisionWorld::objectQuerySingle(castShape, from, to, object, object->getCollisionShape(),
+                                                object->getWorldTransform(), *result, allowedPenetration);
+        }
+    };
+    
+    bool ConvexOverlap(const btConvexShape* a, const btTransform& transformA,
+                       const btConvexShape* b, const btTransform& transformB) {
+        btVoronoiSimplexSolver simplexSolver;
+        btGjkEpaPenetrationDepthSolver depthSolver;
+        btGjkPairDetector detector(a, b, &simplexSolver, &depthSolver);
+        
+        btGjkPairDetector::ClosestPointInput input;
+        input.m_transformA = transformA;
+        input.m_transformB = transformB;
+        
+        btPointCollector output;
+        detector.getClosestPoints(input, output, nullptr);
+        return output.m_hasResult && output.m_distance <= btScalar(0.0);
+    }
+    
+    // Tests a sphere (in the triangles' local space) against every triangle in its bounds
+    struct SphereTriangleCallback : public btTriangleCallback {
+        const btSphereShape* sphere = nullptr;
+        btTransform sphereTransform;
+        bool overlapping = false;
+        
+        void processTriangle(btVector3* triangle, int partId, int triangleIndex) override {
+            (void)partId;
+            (void)triangleIndex;
+            if (overlapping) {
+                return;
+            }
+            btTriangleShape triangleShape(triangle[0], triangle[1], triangle[2]);
+            triangleShape.setMargin(0.0f);
+            btTransform identity;
+            identity.setIdentity();
+            overlapping = ConvexOverlap(sphere, sphereTransform, &triangleShape, identity);
+        }
+    };
+    
+    // Exact sphere vs shape test. Uses GJK directly instead of the dispatcher,
+    // whose algorithm pools are not thread-safe.
+    bool SphereOverlapsShape(const btSphereShape& sphere, const btVector3& center,
+                             const btCollisionShape* shape, const btTransform& shapeTransform) {
+        if (shape->isConvex()) {
+            return ConvexOverlap(&sphere, MakeTranslation(center),
+                                 static_cast<const btConvexShape*>(shape), shapeTransform);
+        }
+        
+        if (shape->getShapeType() == STATIC_PLANE_PROXYTYPE) {
+            const btStaticPlaneShape* plane = static_cast<const btStaticPlaneShape*>(shape);
+            btVector3 normal = shapeTransform.getBasis() * plane->getPlaneNormal();
+            btScalar constant = plane->getPlaneConstant() + normal.dot(shapeTransform.getOrigin());
+            return normal.dot(center) - constant <= sphere.getRadius();
+        }
+        
+        if (shape->isCompound()) {
+            const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+            for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+                if (SphereOverlapsShape(sphere, center, compound->getChildShape(i),
+                                        shapeTransform * compound->getChildTransform(i))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        
+        if (shape->isConcave()) {
+            btVector3 localCenter = shapeTransform.invXform(center);
+            btVector3 extent(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
+            
+            SphereTriangleCallback callback;
+            callback.sphere = &sphere;
+            callback.sphereTransform = MakeTranslation(localCenter);
+            static_cast<const btConcaveShape*>(shape)->processAllTriangles(&callback, localCenter - extent, localCenter + extent);
+            return callback.overlapping;
+        }
+        
+        return false;
+    }
+    
+    // Collects the objects overlapping one sphere into a fixed-size output slice
+    class SphereOverlapCollector : public btDbvt::ICollide, public btBroadphaseAabbCallback {
+    public:
+        SphereOverlapCollector(const OverlapQuery& query, const btCollisionObject** hits, int maxHits)
+            : m_sphere(query.radius)
+            , m_center(ToBullet(query.center))
+            , m_group(query.collisionFilterGroup)
+            , m_mask(query.collisionFilterMask)
+            , m_hits(hits)
+            , m_maxHits(maxHits)
+            , m_count(0)
+        {
+        }
+        
+        int GetCount() const { return m_count; }
+        
+        // DBVT leaf
+        void Process(const btDbvtNode* leaf) {
+            Test(GetProxyObject(leaf));
+        }
+        
+        // Generic broadphase aabbTest
+        bool process(const btBroadphaseProxy* proxy) override {
+            Test(static_cast<const btCollisionObject*>(proxy->m_clientObject));
+            return true;
+        }
+        
+    private:
+        void Test(const btCollisionObject* object) {
+            if (m_count >= m_maxHits) {
+                return;
+            }
+            const btBroadphaseProxy* proxy = object->getBroadphaseHandle();
+            bool collides = (proxy->m_collisionFilterGroup & m_mask) != 0 &&
+                            (m_group & proxy->m_collisionFilterMask) != 0;
+            if (collides && SphereOverlapsShape(m_sphere, m_center, object->getCollisionShape(), object->getWorldTransform())) {
+                m_hits[m_count++] = object;
+            }
+        }
+        
+        btSphereShape m_sphere;
+        btVector3 m_center;
+        int m_group;
+        int m_mask;
+        const btCollisionObject** m_hits;
+        int m_maxHits;
+        int m_count;
+    };
+    
+    // Walk both DBVT sets with an AABB using the caller's stack
+    void AabbTestDbvt(const btDbvtBroadphase* dbvt, const btVector3& aabbMin, const btVector3& aabbMax,
+                      btDbvt::ICollide& policy, QueryStack& stack) {
+        const btDbvtVolume volume = btDbvtVolume::FromMM(aabbMin, aabbMax);
+        for (const btDbvt& set : dbvt->m_sets) {
+            if (!set.m_root) {
+                continue;
+            }
+            stack.resize(0);
+            stack.push_back(set.m_root);
+            while (stack.size() > 0) {
+                const btDbvtNode* node = stack[stack.size() - 1];
+                stack.pop_back();
+                if (!Intersect(node->volume, volume)) {
+                    continue;
+                }
+                if (node->isinternal()) {
+                    stack.push_back(node->childs[0]);
+                    stack.push_back(node->childs[1]);
+                } else {
+                    policy.Process(node);
+                }
+            }
+        }
+    }
+    
+    // Snapshot blob layout: header, one ObjectRecord per collision object, then per
+    // manifold a ManifoldRecord followed by its ContactRecords
+    constexpr uint32_t SNAPSHOT_MAGIC = 0x4E534352; // "RCSN"
+    constexpr uint32_t SNAPSHOT_VERSION = 1;
+    
+    struct SnapshotHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t objectCount;
+        uint32_t manifoldCount;
+        uint64_t solverSeed;
+    };
+    
+    struct ObjectRecord {
+        float basis[9];
+        float origin[3];
+        float linearVelocity[3];
+        float angularVelocity[3];
+        float deactivationTime;
+        int32_t activationState;
+    };
+    
+    struct ManifoldRecord {
+        uint32_t indexA;
+        uint32_t indexB;
+        int32_t numContacts;
+    };
+    
+    struct ContactRecord {
+        float localPointA[3];
+        float localPointB[3];
+        float positionWorldOnA[3];
+        float positionWorldOnB[3];
+        float normalWorldOnB[3];
+        float lateralFrictionDir1[3];
+        float lateralFrictionDir2[3];
+        float distance;
+        float combinedFriction;
+        float combinedRollingFriction;
+        float combinedSpinningFriction;
+        float combinedRestitution;
+        float appliedImpulse;
+        float appliedImpulseLateral1;
+        float appliedImpulseLateral2;
+        int32_t partId0;
+        int32_t partId1;
+        int32_t index0;
+        int32_t index1;
+        int32_t lifeTime;
+        int32_t contactPointFlags;
+    };
+    
+    void StoreVector(const btVector3& v, float* out) {
+        out[0] = v.x();
+        out[1] = v.y();
+        out[2] = v.z();
+    }
+    
+    btVector3 LoadVector(const float* in) {
+        return btVector3(in[0], in[1], in[2]);
+    }
+    
+    template <typename T>
+    void WriteRecord(uint8_t*& cursor, const T& record) {
+        std::memcpy(cursor, &record, sizeof(T));
+        cursor += sizeof(T);
+    }
+    
+    template <typename T>
+    bool ReadRecord(const uint8_t*& cursor, const uint8_t* end, T& record) {
+        if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&record, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+    
+    uint64_t MakePairKey(uint32_t indexA, uint32_t indexB) {
+        return (static_cast<uint64_t>(indexA) << 32) | indexB;
+    }
+    
+    void StoreContact(const btManifoldPoint& point, ContactRecord& record) {
+        StoreVector(point.m_localPointA, record.localPointA);
+        StoreVector(point.m_localPointB, record.localPointB);
+        StoreVector(point.m_positionWorldOnA, record.positionWorldOnA);
+        StoreVector(point.m_positionWorldOnB, record.positionWorldOnB);
+        StoreVector(point.m_normalWorldOnB, record.normalWorldOnB);
+        StoreVector(point.m_lateralFrictionDir1, record.lateralFrictionDir1);
+        StoreVector(point.m_lateralFrictionDir2, record.lateralFrictionDir2);
+        record.distance = point.m_distance1;
+        record.combinedFriction = point.m_combinedFriction;
+        record.combinedRollingFriction = point.m_combinedRollingFriction;
+        record.combinedSpinningFriction = point.m_combinedSpinningFriction;
+        record.combinedRestitution = point.m_combinedRestitution;
+        record.appliedImpulse = point.m_appliedImpulse;
+        record.appliedImpulseLateral1 = point.m_appliedImpulseLateral1;
+        record.appliedImpulseLateral2 = point.m_appliedImpulseLateral2;
+        record.partId0 = point.m_partId0;
+        record.partId1 = point.m_partId1;
+        record.index0 = point.m_index0;
+        record.index1 = point.m_index1;
+        record.lifeTime = point.m_lifeTime;
+        record.contactPointFlags = point.m_contactPointFlags;
+    }
+    
+    btManifoldPoint LoadContact(const ContactRecord& record) {
+        btManifoldPoint point(LoadVector(record.localPointA), LoadVector(record.localPointB),
+                              LoadVector(record.normalWorldOnB), record.distance);
+        point.m_positionWorldOnA = LoadVector(record.positionWorldOnA);
+        point.m_positionWorldOnB = LoadVector(record.positionWorldOnB);
+        point.m_lateralFrictionDir1 = LoadVector(record.lateralFrictionDir1);
+        point.m_lateralFrictionDir2 = LoadVector(record.lateralFrictionDir2);
+        point.m_combinedFriction = record.combinedFriction;
+        point.m_combinedRollingFriction = record.combinedRollingFriction;
+        point.m_combinedSpinningFriction = record.combinedSpinningFriction;
+        point.m_combinedRestitution = record.combinedRestitution;
+        point.m_appliedImpulse = record.appliedImpulse;
+        point.m_appliedImpulseLateral1 = record.appliedImpulseLateral1;
+        point.m_appliedImpulseLateral2 = record.appliedImpulseLateral2;
+        point.m_partId0 = record.partId0;
+        point.m_partId1 = record.partId1;
+        point.m_index0 = record.index0;
+        point.m_index1 = record.index1;
+        point.m_lifeTime = record.lifeTime;
+        point.m_contactPointFlags = record.contactPointFlags;
+        return point;
+    }
+    
+    void StoreRayHit(const btCollisionWorld::ClosestRayResultCallback& callback, QueryHit& hit) {
+        hit = QueryHit();
+        if (callback.hasHit()) {
+            hit.hasHit = true;
+            hit.fraction = callback.m_closestHitFraction;
+            hit.point = ToGlm(callback.m_hitPointWorld);
+            hit.normal = ToGlm(callback.m_hitNormalWorld);
+            hit.object = callback.m_collisionObject;
+        }
+    }
+    
+    void StoreSweepHit(const btCollisionWorld::ClosestConvexResultCallback& callback, QueryHit& hit) {
+        hit = QueryHit();
+        if (callback.hasHit()) {
+            hit.hasHit = true;
+            hit.fraction = callback.m_closestHitFraction;
+            hit.point = ToGlm(callback.m_hitPointWorld);
+            hit.normal = ToGlm(callback.m_hitNormalWorld);
+            hit.object = callback.m_hitCollisionObject;
+        }
+    }
+    
+    // Undo the linear/angular factor applyCentralForce and applyTorque multiply by, so the
+    // accumulated value can be applied back with the opposite sign
+    btVector3 Unscale(const btVector3& value, const btVector3& factor) {
+        return btVector3(factor.x() != btScalar(0.0) ? value.x() / factor.x() : btScalar(0.0),
+                         factor.y() != btScalar(0.0) ? value.y() / factor.y() : btScalar(0.0),
+                         factor.z() != btScalar(0.0) ? value.z() / factor.z() : btScalar(0.0));
+    }
+}
+
 BulletWorld::BulletWorld(const glm::vec3& gravity) 
+    : BulletWorld(MakeConfigWithGravity(gravity))
+{
+}
+
+BulletWorld::BulletWorld(const BulletWorldConfig& config) 
     : m_dynamicsWorld(nullptr)
     , m_dispatcher(nullptr)
     , m_broadphase(nullptr)
     , m_solver(nullptr)
+    , m_solverPool(nullptr)
     , m_collisionConfig(nullptr)
+    , m_layerFilter(nullptr)
     , m_debugDrawEnabled(false)
+    , m_config(config)
+    , m_updateCount(0)
+    , m_memoryArena(nullptr)
 {
-    InitializeBulletComponents();
-    SetGravity(gravity);
+    // Route this world's allocations to its own arena; the caller's arena is restored afterwards
+    BulletMemory::Install();
+    m_memoryArena = BulletMemory::CreateArena("BulletWorld");
+    {
+        BulletMemory::ScopedArena arenaScope(m_memoryArena);
+        InitializeBulletComponents();
+    }
+    SetGravity(config.gravity);
 }
 
 BulletWorld::~BulletWorld() {
-    CleanupBulletComponents();
+    {
+        BulletMemory::ScopedArena arenaScope(m_memoryArena);
+        CleanupBulletComponents();
+    }
+    
+    // The arena's chunks are released once the last object allocated from it is gone
+    BulletMemory::ReleaseArena(m_memoryArena);
+    m_memoryArena = nullptr;
 }
 
 void BulletWorld::InitializeBulletComponents() {
+    bool multithreaded = m_config.solver == SolverType::SequentialImpulseMt;
+    
     // Create collision configuration
     m_collisionConfig = new btDefaultCollisionConfiguration();
     
-    // Create collision dispatcher
-    m_dispatcher = new btCollisionDispatcher(m_collisionConfig);
+    // Create collision dispatcher (the Mt backend also runs the narrowphase on the task scheduler)
+    if (multithreaded) {
+        m_dispatcher = new btCollisionDispatcherMt(m_collisionConfig);
+    } else {
+        m_dispatcher = new btCollisionDispatcher(m_collisionConfig);
+    }
     
     // Create broadphase (spatial partitioning)
-    m_broadphase = new btDbvtBroadphase();
+    m_broadphase = CreateBroadphase();
     
     // Create constraint solver
-    m_solver = new btSequentialImpulseConstraintSolver();
+    CreateSolver();
     
     // Create dynamics world
-    m_dynamicsWorld = new btDiscreteDynamicsWorld(m_dispatcher, m_broadphase, m_solver, m_collisionConfig);
+    if (multithreaded) {
+        m_dynamicsWorld = new btDiscreteDynamicsWorldMt(m_dispatcher, m_broadphase, m_solverPool, m_solver, m_collisionConfig);
+    } else {
+        m_dynamicsWorld = new btDiscreteDynamicsWorld(m_dispatcher, m_broadphase, m_solver, m_collisionConfig);
+    }
+    
+    // Count broadphase overlaps per collision layer pair (same filtering as Bullet's default)
+    m_layerFilter = new CollisionLayerFilter();
+    m_dynamicsWorld->getPairCache()->setOverlapFilterCallback(m_layerFilter);
+    
+    // Substep hooks; both share this world as the user info
+    m_dynamicsWorld->setInternalTickCallback(&BulletWorld::PreTickTrampoline, this, true);
+    m_dynamicsWorld->setInternalTickCallback(&BulletWorld::PostTickTrampoline, this, false);
     
     // Set default parameters
     m_dynamicsWorld->setGravity(btVector3(0, -9.81, 0));
     
-    // Improve collision resolution with moderate settings
-    btContactSolverInfo& solverInfo = m_dynamicsWorld->getSolverInfo();
-    solverInfo.m_numIterations = 50; // Increased iterations for better resolution
-    solverInfo.m_solverMode = SOLVER_SIMD | SOLVER_RANDMIZE_ORDER | SOLVER_USE_WARMSTARTING; // Better solver mode
-    solverInfo.m_splitImpulse = true; // Enable split impulse for better contact resolution
-    solverInfo.m_splitImpulsePenetrationThreshold = -0.002f; // Slight negative threshold retains separation
-    solverInfo.m_erp = 0.2f; // Error reduction parameter
-    solverInfo.m_erp2 = 0.2f; // Error reduction parameter for contact constraints
-    solverInfo.m_globalCfm = 0.0f; // Default CFM
+    // Iterations and stabilization from the configured profile
+    SetSolverSettings(m_config.solverSettings);
     
     // Set collision margins for better contact detection
     m_dynamicsWorld->getDispatchInfo().m_allowedCcdPenetration = 0.0001f;
 }
 
+void BulletWorld::CreateSolver() {
+    switch (m_config.solver) {
+        case SolverType::NNCG:
+            m_solver = new btNNCGConstraintSolver();
+            break;
+        case SolverType::SequentialImpulseMt: {
+            // Bullet's default task scheduler is sequential; switch to the pooled one once per process
+            // (btCreateDefaultTaskScheduler returns nullptr when Bullet is built without BT_THREADSAFE)
+            static btITaskScheduler* s_taskScheduler = btCreateDefaultTaskScheduler();
+            if (s_taskScheduler && btGetTaskScheduler() != s_taskScheduler) {
+                btSetTaskScheduler(s_taskScheduler);
+            }
+            
+            int numThreads = btGetTaskScheduler() ? btGetTaskScheduler()->getNumThreads() : 1;
+            m_solverPool = new btConstraintSolverPoolMt(std::max(numThreads, 1));
+            m_solver = new btSequentialImpulseConstraintSolverMt();
+            break;
+        }
+        case SolverType::SequentialImpulse:
+        default:
+            m_solver = new btSequentialImpulseConstraintSolver();
+            break;
+    }
+}
+
+SolverSettings SolverSettings::FromProfile(SolverProfile profile) {
+    SolverSettings settings;
+    switch (profile) {
+        case SolverProfile::Fast:
+            settings.iterations = 10;
+            settings.randomizeOrder = false;
+            break;
+        case SolverProfile::Balanced:
+            settings.iterations = 20;
+            break;
+        case SolverProfile::Accurate:
+        default:
+            break;
+    }
+    return settings;
+}
+
+void BulletWorld::SetSolverSettings(const SolverSettings& settings) {
+    m_config.solverSettings = settings;
+    if (!m_dynamicsWorld) {
+        std::cerr << "BulletWorld::SetSolverSettings: Dynamics world not initialized!" << std::endl;
+        return;
+    }
+    
+    btContactSolverInfo& solverInfo = m_dynamicsWorld->getSolverInfo();
+    solverInfo.m_numIterations = std::max(settings.iterations, 1);
+    solverInfo.m_solverMode = SOLVER_SIMD;
+    if (settings.randomizeOrder) {
+        solverInfo.m_solverMode |= SOLVER_RANDMIZE_ORDER;
+    }
+    if (settings.warmStarting) {
+        solverInfo.m_solverMode |= SOLVER_USE_WARMSTARTING;
+    }
+    solverInfo.m_splitImpulse = settings.splitImpulse;
+    solverInfo.m_splitImpulsePenetrationThreshold = settings.splitImpulsePenetrationThreshold;
+    solverInfo.m_erp = settings.erp;
+    solverInfo.m_erp2 = settings.erp2;
+    solverInfo.m_globalCfm = 0.0f; // Default CFM
+}
+
+const char* BulletWorld::GetSolverName(SolverType type) {
+    switch (type) {
+        case SolverType::SequentialImpulse: return "btSequentialImpulseConstraintSolver";
+        case SolverType::NNCG: return "btNNCGConstraintSolver";
+        case SolverType::SequentialImpulseMt: return "btSequentialImpulseConstraintSolverMt";
+    }
+    return "unknown";
+}
+
+btBroadphaseInterface* BulletWorld::CreateBroadphase() const {
+    btVector3 worldMin(m_config.worldMin.x, m_config.worldMin.y, m_config.worldMin.z);
+    btVector3 worldMax(m_config.worldMax.x, m_config.worldMax.y, m_config.worldMax.z);
+    int maxProxies = std::max(m_config.maxProxies, 2);
+    
+    switch (m_config.broadphase) {
+        case BroadphaseType::AxisSweep3: {
+            if (maxProxies > MAX_AXIS_SWEEP3_PROXIES) {
+                std::cerr << "BulletWorld::CreateBroadphase: btAxisSweep3 supports at most " << MAX_AXIS_SWEEP3_PROXIES
+                          << " proxies (requested " << maxProxies << "), clamping. Use AxisSweep3_32Bit for larger worlds." << std::endl;
+                maxProxies = MAX_AXIS_SWEEP3_PROXIES;
+            }
+            return new btAxisSweep3(worldMin, worldMax, static_cast<unsigned short>(maxProxies));
+        }
+        case BroadphaseType::AxisSweep3_32Bit:
+            return new bt32BitAxisSweep3(worldMin, worldMax, static_cast<unsigned int>(maxProxies));
+        case BroadphaseType::Dbvt:
+        default: {
+            btDbvtBroadphase* dbvt = new btDbvtBroadphase();
+            dbvt->m_dupdates = m_config.dbvtDynamicUpdatePercent;
+            dbvt->m_fupdates = m_config.dbvtFixedUpdatePercent;
+            dbvt->m_cupdates = m_config.dbvtCleanupPercent;
+            dbvt->m_deferedcollide = m_config.dbvtDeferredCollide;
+            dbvt->setVelocityPrediction(m_config.dbvtVelocityPrediction);
+            return dbvt;
+        }
+    }
+}
+
+void BulletWorld::SetLayerInteraction(CollisionLayer a, CollisionLayer b, bool enabled) {
+    m_config.collisionLayers.SetInteraction(a, b, enabled);
+    if (!m_dynamicsWorld) {
+        return;
+    }
+    
+    // Existing pairs are not re-filtered by the broadphase, so re-add the affected bodies
+    int groupA = CollisionLayerMatrix::GetGroup(a);
+    int groupB = CollisionLayerMatrix::GetGroup(b);
+    std::vector<btRigidBody*> affected;
+    const btCollisionObjectArray& objects = m_dynamicsWorld->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i) {
+        btRigidBody* body = btRigidBody::upcast(objects[i]);
+        btBroadphaseProxy* proxy = body ? body->getBroadphaseHandle() : nullptr;
+        if (proxy && (proxy->m_collisionFilterGroup & (groupA | groupB))) {
+            affected.push_back(body);
+        }
+    }
+    
+    BulletMemory::ScopedArena arenaScope(m_memoryArena);
+    for (btRigidBody* body : affected) {
+        CollisionLayer layer = CollisionLayerMatrix::GetLayerFromGroup(body->getBroadphaseHandle()->m_collisionFilterGroup);
+        m_dynamicsWorld->removeRigidBody(body);
+        m_dynamicsWorld->addRigidBody(body, CollisionLayerMatrix::GetGroup(layer), m_config.collisionLayers.GetMask(layer));
+    }
+}
+
+CollisionLayerPairStats BulletWorld::GetLayerPairStats(CollisionLayer a, CollisionLayer b) const {
+    return m_layerFilter ? m_layerFilter->GetStats(a, b) : CollisionLayerPairStats();
+}
+
+void BulletWorld::ResetLayerPairStats() {
+    if (m_layerFilter) {
+        m_layerFilter->Reset();
+    }
+}
+
+void BulletWorld::PrintLayerStatistics() const {
+    if (!m_dynamicsWorld || !m_layerFilter) {
+        std::cerr << "BulletWorld::PrintLayerStatistics: Dynamics world not initialized!" << std::endl;
+        return;
+    }
+    
+    // Count the pairs currently in the pair cache per layer pair
+    int activePairs[MAX_COLLISION_LAYERS][MAX_COLLISION_LAYERS] = {};
+    btOverlappingPairCache* pairCache = m_dynamicsWorld->getPairCache();
+    const btBroadphasePairArray& pairs = pairCache->getOverlappingPairArray();
+    for (int i = 0; i < pairs.size(); ++i) {
+        int layerA = static_cast<int>(CollisionLayerMatrix::GetLayerFromGroup(pairs[i].m_pProxy0->m_collisionFilterGroup));
+        int layerB = static_cast<int>(CollisionLayerMatrix::GetLayerFromGroup(pairs[i].m_pProxy1->m_collisionFilterGroup));
+        activePairs[std::min(layerA, layerB)][std::max(layerA, layerB)]++;
+    }
+    
+    uint64_t totalAccepted = 0;
+    uint64_t totalRejected = 0;
+    std::cout << "Collision layer statistics (layer pair: active pairs, accepted / rejected overlaps):" << std::endl;
+    for (int a = 0; a < MAX_COLLISION_LAYERS; ++a) {
+        for (int b = a; b < MAX_COLLISION_LAYERS; ++b) {
+            CollisionLayer layerA = static_cast<CollisionLayer>(a);
+            CollisionLayer layerB = static_cast<CollisionLayer>(b);
+            CollisionLayerPairStats stats = m_layerFilter->GetStats(layerA, layerB);
+            if (activePairs[a][b] == 0 && stats.acceptedOverlaps == 0 && stats.rejectedOverlaps == 0) {
+                continue;
+            }
+            
+            std::cout << "  " << CollisionLayerMatrix::GetLayerName(layerA) << "(" << a << ") vs "
+                      << CollisionLayerMatrix::GetLayerName(layerB) << "(" << b << "): "
+                      << activePairs[a][b] << " active, " << stats.acceptedOverlaps << " accepted / "
+                      << stats.rejectedOverlaps << " rejected"
+                      << (m_config.collisionLayers.Interacts(layerA, layerB) ? "" : " (disabled)") << std::endl;
+            totalAccepted += stats.acceptedOverlaps;
+            totalRejected += stats.rejectedOverlaps;
+        }
+    }
+    
+    uint64_t total = totalAccepted + totalRejected;
+    std::cout << "  Total: " << pairs.size() << " active pairs, " << totalAccepted << " accepted / "
+              << totalRejected << " rejected overlaps";
+    if (total > 0) {
+        std::cout << " (" << (100.0 * totalRejected / total) << "% filtered)";
+    }
+    std::cout << std::endl;
+}
+
+const char* BulletWorld::GetBroadphaseName(BroadphaseType type) {
+    switch (type) {
+        case BroadphaseType::Dbvt: return "btDbvtBroadphase";
+        case BroadphaseType::AxisSweep3: return "btAxisSweep3";
+        case BroadphaseType::AxisSweep3_32Bit: return "bt32BitAxisSweep3";
+    }
+    return "unknown";
+}
+
 void BulletWorld::CleanupBulletComponents() {
     if (m_dynamicsWorld) {
         delete m_dynamicsWorld;
         m_dynamicsWorld = nullptr;
     }
     
+    if (m_layerFilter) {
+        delete m_layerFilter;
+        m_layerFilter = nullptr;
+    }
+    
     if (m_solver) {
         delete m_solver;
         m_solver = nullptr;
     }
     
+    if (m_solverPool) {
+        delete m_solverPool;
+        m_solverPool = nullptr;
+    }
+    
     if (m_broadphase) {
         delete m_broadphase;
         m_broadphase = nullptr;
@@ -83,10 +748,11 @@ void BulletWorld::Update(float deltaTime, int maxSubSteps, float fixedTimeStep)
         return;
     }
     
+    BulletMemory::ScopedArena arenaScope(m_memoryArena);
+    
     // Debug: Print deltaTime every 60 calls
-    static int updateCount = 0;
-    updateCount++;
-    if (updateCount % 60 == 0) {
+    m_updateCount++;
+    if (m_config.debugLogging && m_updateCount % 60 == 0) {
         std::cout << "DEBUG: BulletWorld::Update called with deltaTime=" << deltaTime 
                   << ", maxSubSteps=" << maxSubSteps << ", fixedTimeStep=" << fixedTimeStep << std::endl;
         
@@ -119,11 +785,16 @@ void BulletWorld::Update(float deltaTime, int maxSubSteps, float fixedTimeStep)
                 }
             }
         }
+        
+        PrintLayerStatistics();
     }
     
     // Step the simulation
     m_dynamicsWorld->stepSimulation(deltaTime, maxSubSteps, fixedTimeStep);
     
+    // stepSimulation cleared every force after the last substep
+    m_tickForces.clear();
+    
     // Handle collision callbacks
     HandleCollisions();
 }
@@ -134,8 +805,25 @@ void BulletWorld::AddRigidBody(btRigidBody* body) {
         return;
     }
     
+    BulletMemory::ScopedArena arenaScope(m_memoryArena);
     m_dynamicsWorld->addRigidBody(body);
-    std::cout << "DEBUG: RigidBody added to dynamics world. Total bodies: " << m_dynamicsWorld->getNumCollisionObjects() << std::endl;
+    if (m_config.debugLogging) {
+        std::cout << "DEBUG: RigidBody added to dynamics world. Total bodies: " << m_dynamicsWorld->getNumCollisionObjects() << std::endl;
+    }
+}
+
+void BulletWorld::AddRigidBody(btRigidBody* body, CollisionLayer layer) {
+    if (!m_dynamicsWorld || !body) {
+        std::cerr << "BulletWorld::AddRigidBody: Invalid parameters!" << std::endl;
+        return;
+    }
+    
+    BulletMemory::ScopedArena arenaScope(m_memoryArena);
+    m_dynamicsWorld->addRigidBody(body, CollisionLayerMatrix::GetGroup(layer), m_config.collisionLayers.GetMask(layer));
+    if (m_config.debugLogging) {
+        std::cout << "DEBUG: RigidBody added to dynamics world in layer " << CollisionLayerMatrix::GetLayerName(layer)
+                  << ". Total bodies: " << m_dynamicsWorld->getNumCollisionObjects() << std::endl;
+    }
 }
 
 void BulletWorld::RemoveRigidBody(btRigidBody* body) {
@@ -144,7 +832,13 @@ void BulletWorld::RemoveRigidBody(btRigidBody* body) {
         return;
     }
     
+    BulletMemory::ScopedArena arenaScope(m_memoryArena);
     m_dynamicsWorld->removeRigidBody(body);
+    
+    // A post-tick hook may remove (and delete) a body between substeps
+    m_tickForces.erase(std::remove_if(m_tickForces.begin(), m_tickForces.end(),
+                                      [body](const TickForce& entry) { return entry.body == body; }),
+                       m_tickForces.end());
 }
 
 void BulletWorld::SetGravity(const glm::vec3& gravity) {
@@ -169,6 +863,70 @@ void BulletWorld::SetCollisionCallback(std::function<void(btRigidBody*, btRigidB
     m_collisionCallback = callback;
 }
 
+void BulletWorld::SetPreTickCallback(TickCallback callback) {
+    m_preTickCallback = std::move(callback);
+}
+
+void BulletWorld::SetPostTickCallback(TickCallback callback) {
+    m_postTickCallback = std::move(callback);
+}
+
+void BulletWorld::PreTickTrampoline(btDynamicsWorld* world, btScalar timeStep) {
+    BulletWorld* self = static_cast<BulletWorld*>(world->getWorldUserInfo());
+    if (self && self->m_preTickCallback) {
+        self->RunPreTickCallback(static_cast<float>(timeStep));
+    }
+}
+
+void BulletWorld::RunPreTickCallback(float timeStep) {
+    // stepSimulation only clears forces after the last substep. Withdraw what the callback
+    // added on the previous substep so its forces act for one substep, while forces applied
+    // before Update() (and gravity) keep acting on every substep as usual.
+    for (const TickForce& entry : m_tickForces) {
+        entry.body->applyCentralForce(-Unscale(entry.force, entry.body->getLinearFactor()));
+        entry.body->applyTorque(-Unscale(entry.torque, entry.body->getAngularFactor()));
+    }
+    
+    btAlignedObjectArray<btRigidBody*>& bodies = m_dynamicsWorld->getNonStaticRigidBodies();
+    m_tickForces.resize(bodies.size());
+    for (int i = 0; i < bodies.size(); ++i) {
+        m_tickForces[i] = {bodies[i], bodies[i]->getTotalForce(), bodies[i]->getTotalTorque()};
+    }
+    
+    m_preTickCallback(*this, timeStep);
+    
+    // Keep what the callback changed; bodies it added to the world count in full
+    for (int i = 0; i < bodies.size(); ++i) {
+        btRigidBody* body = bodies[i];
+        btVector3 force = body->getTotalForce();
+        btVector3 torque = body->getTotalTorque();
+        
+        size_t before = static_cast<size_t>(i);
+        if (before >= m_tickForces.size() || m_tickForces[before].body != body) {
+            auto match = std::find_if(m_tickForces.begin(), m_tickForces.end(),
+                                      [body](const TickForce& entry) { return entry.body == body; });
+            before = static_cast<size_t>(match - m_tickForces.begin());
+        }
+        if (before < m_tickForces.size()) {
+            force -= m_tickForces[before].force;
+            torque -= m_tickForces[before].torque;
+        }
+        
+        if (!force.fuzzyZero() || !torque.fuzzyZero()) {
+            m_tickScratch.push_back({body, force, torque});
+        }
+    }
+    m_tickForces.swap(m_tickScratch);
+    m_tickScratch.clear();
+}
+
+void BulletWorld::PostTickTrampoline(btDynamicsWorld* world, btScalar timeStep) {
+    BulletWorld* self = static_cast<BulletWorld*>(world->getWorldUserInfo());
+    if (self && self->m_postTickCallback) {
+        self->m_postTickCallback(*self, static_cast<float>(timeStep));
+    }
+}
+
 void BulletWorld::SetDebugDrawEnabled(bool enabled) {
     m_debugDrawEnabled = enabled;
 }
@@ -183,7 +941,306 @@ void BulletWorld::SetNumTasks(int numThreads) {
         return;
     }
     
-    m_dynamicsWorld->setNumTasks(numThreads);
+    btITaskScheduler* scheduler = btGetTaskScheduler();
+    if (!scheduler) {
+        std::cerr << "BulletWorld::SetNumTasks: No task scheduler available!" << std::endl;
+        return;
+    }
+    
+    scheduler->setNumThreadsUsed(std::max(1, std::min(numThreads, scheduler->getMaxNumThreads())));
+}
+
+void BulletWorld::RaycastBatch(const RaycastQuery* queries, int count, QueryHit* results) const {
+    if (!m_dynamicsWorld || !queries || !results || count <= 0) {
+        return;
+    }
+    
+    const btDbvtBroadphase* dbvt = m_config.broadphase == BroadphaseType::Dbvt
+        ? static_cast<const btDbvtBroadphase*>(m_broadphase) : nullptr;
+    
+    std::vector<QueryStack> stacks(dbvt ? ThreadPool::getInstance().getThreadCount() : 1);
+    auto runQueries = [&](int begin, int end, int threadIndex) {
+        const btVector3 zero(0, 0, 0);
+        for (int i = begin; i < end; ++i) {
+            btVector3 from = ToBullet(queries[i].from);
+            btVector3 to = ToBullet(queries[i].to);
+            
+            btCollisionWorld::ClosestRayResultCallback callback(from, to);
+            callback.m_collisionFilterGroup = queries[i].collisionFilterGroup;
+            callback.m_collisionFilterMask = queries[i].collisionFilterMask;
+            
+            if (dbvt) {
+                RayLeafCallback leafCallback;
+                leafCallback.from = MakeTranslation(from);
+                leafCallback.to = MakeTranslation(to);
+                leafCallback.result = &callback;
+                RayTestDbvt(dbvt, from, to, zero, zero, leafCallback, stacks[threadIndex]);
+            } else {
+                m_dynamicsWorld->rayTest(from, to, callback);
+            }
+            StoreRayHit(callback, results[i]);
+        }
+    };
+    
+    // Sweep and prune broadphases share one ray traversal stack, so only DBVT runs in parallel
+    if (dbvt) {
+        ThreadPool::getInstance().parallelFor(count, QUERY_GRAIN_SIZE, runQueries);
+    } else {
+        runQueries(0, count, 0);
+    }
+}
+
+void BulletWorld::SphereSweepBatch(const SphereSweepQuery* queries, int count, QueryHit* results) const {
+    if (!m_dynamicsWorld || !queries || !results || count <= 0) {
+        return;
+    }
+    
+    const btDbvtBroadphase* dbvt = m_config.broadphase == BroadphaseType::Dbvt
+        ? static_cast<const btDbvtBroadphase*>(m_broadphase) : nullptr;
+    btScalar allowedPenetration = m_dynamicsWorld->getDispatchInfo().m_allowedCcdPenetration;
+    
+    std::vector<QueryStack> stacks(dbvt ? ThreadPool::getInstance().getThreadCount() : 1);
+    auto runQueries = [&](int begin, int end, int threadIndex) {
+        for (int i = begin; i < end; ++i) {
+            btSphereShape sphere(queries[i].radius);
+            btVector3 from = ToBullet(queries[i].from);
+            btVector3 to = ToBullet(queries[i].to);
+            
+            btCollisionWorld::ClosestConvexResultCallback callback(from, to);
+            callback.m_collisionFilterGroup = queries[i].collisionFilterGroup;
+            callback.m_collisionFilterMask = queries[i].collisionFilterMask;
+            
+            if (dbvt) {
+                SweepLeafCallback leafCallback;
+                leafCallback.castShape = &sphere;
+                leafCallback.from = MakeTranslation(from);
+                leafCallback.to = MakeTranslation(to);
+                leafCallback.allowedPenetration = allowedPenetration;
+                leafCallback.result = &callback;
+                
+                // Inflate the traversal by the sphere's bounds, as btCollisionWorld::convexSweepTest does
+                btVector3 extent(queries[i].radius, queries[i].radius, queries[i].radius);
+                RayTestDbvt(dbvt, from, to, -extent, extent, leafCallback, stacks[threadIndex]);
+            } else {
+                m_dynamicsWorld->convexSweepTest(&sphere, MakeTranslation(from), MakeTranslation(to),
+                                                 callback, allowedPenetration);
+            }
+            StoreSweepHit(callback, results[i]);
+        }
+    };
+    
+    if (dbvt) {
+        ThreadPool::getInstance().parallelFor(count, QUERY_GRAIN_SIZE, runQueries);
+    } else {
+        runQueries(0, count, 0);
+    }
+}
+
+void BulletWorld::OverlapBatch(const OverlapQuery* queries, int count,
+                               const btCollisionObject** hitObjects, int maxHitsPerQuery, int* hitCounts) const {
+    if (!m_dynamicsWorld || !queries || !hitObjects || !hitCounts || count <= 0 || maxHitsPerQuery <= 0) {
+        return;
+    }
+    
+    const btDbvtBroadphase* dbvt = m_config.broadphase == BroadphaseType::Dbvt
+        ? static_cast<const btDbvtBroadphase*>(m_broadphase) : nullptr;
+    
+    // aabbTest only reads the broadphase, so every backend can run in parallel
+    std::vector<QueryStack> stacks(dbvt ? ThreadPool::getInstance().getThreadCount() : 1);
+    ThreadPool::getInstance().parallelFor(count, QUERY_GRAIN_SIZE, [&](int begin, int end, int threadIndex) {
+        for (int i = begin; i < end; ++i) {
+            SphereOverlapCollector collector(queries[i], hitObjects + static_cast<size_t>(i) * maxHitsPerQuery, maxHitsPerQuery);
+            
+            btVector3 center = ToBullet(queries[i].center);
+            btVector3 extent(queries[i].radius, queries[i].radius, queries[i].radius);
+            if (dbvt) {
+                AabbTestDbvt(dbvt, center - extent, center + extent, collector, stacks[threadIndex]);
+            } else {
+                m_broadphase->aabbTest(center - extent, center + extent, collector);
+            }
+            hitCounts[i] = collector.GetCount();
+        }
+    });
+}
+
+void BulletWorld::Snapshot(std::vector<uint8_t>& blob) const {
+    if (!m_dynamicsWorld) {
+        std::cerr << "BulletWorld::Snapshot: Dynamics world not initialized!" << std::endl;
+        blob.clear();
+        return;
+    }
+    
+    const btCollisionObjectArray& objects = m_dynamicsWorld->getCollisionObjectArray();
+    int objectCount = objects.size();
+    int manifoldCount = m_dispatcher->getNumManifolds();
+    
+    size_t contactCount = 0;
+    for (int i = 0; i < manifoldCount; ++i) {
+        contactCount += m_dispatcher->getManifoldByIndexInternal(i)->getNumContacts();
+    }
+    
+    blob.resize(sizeof(SnapshotHeader) + objectCount * sizeof(ObjectRecord) +
+                manifoldCount * sizeof(ManifoldRecord) + contactCount * sizeof(ContactRecord));
+    uint8_t* cursor = blob.data();
+    
+    SnapshotHeader header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.objectCount = static_cast<uint32_t>(objectCount);
+    header.manifoldCount = static_cast<uint32_t>(manifoldCount);
+    header.solverSeed = m_solver->getRandSeed();
+    WriteRecord(cursor, header);
+    
+    for (int i = 0; i < objectCount; ++i) {
+        const btCollisionObject* object = objects[i];
+        const btTransform& transform = object->getWorldTransform();
+        
+        ObjectRecord record;
+        for (int row = 0; row < 3; ++row) {
+            StoreVector(transform.getBasis()[row], record.basis + row * 3);
+        }
+        StoreVector(transform.getOrigin(), record.origin);
+        
+        const btRigidBody* body = btRigidBody::upcast(object);
+        StoreVector(body ? body->getLinearVelocity() : btVector3(0, 0, 0), record.linearVelocity);
+        StoreVector(body ? body->getAngularVelocity() : btVector3(0, 0, 0), record.angularVelocity);
+        record.deactivationTime = object->getDeactivationTime();
+        record.activationState = object->getActivationState();
+        WriteRecord(cursor, record);
+    }
+    
+    for (int i = 0; i < manifoldCount; ++i) {
+        const btPersistentManifold* manifold = m_dispatcher->getManifoldByIndexInternal(i);
+        
+        ManifoldRecord record;
+        record.indexA = static_cast<uint32_t>(manifold->getBody0()->getWorldArrayIndex());
+        record.indexB = static_cast<uint32_t>(manifold->getBody1()->getWorldArrayIndex());
+        record.numContacts = manifold->getNumContacts();
+        WriteRecord(cursor, record);
+        
+        for (int j = 0; j < record.numContacts; ++j) {
+            ContactRecord contact;
+            StoreContact(manifold->getContactPoint(j), contact);
+            WriteRecord(cursor, contact);
+        }
+    }
+}
+
+bool BulletWorld::Restore(const std::vector<uint8_t>& blob) {
+    if (!m_dynamicsWorld) {
+        std::cerr << "BulletWorld::Restore: Dynamics world not initialized!" << std::endl;
+        return false;
+    }
+    
+    const uint8_t* cursor = blob.data();
+    const uint8_t* end = blob.data() + blob.size();
+    btCollisionObjectArray& objects = m_dynamicsWorld->getCollisionObjectArray();
+    
+    SnapshotHeader header;
+    if (!ReadRecord(cursor, end, header) || header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION) {
+        std::cerr << "BulletWorld::Restore: Invalid snapshot data!" << std::endl;
+        return false;
+    }
+    if (header.objectCount != static_cast<uint32_t>(objects.size())) {
+        std::cerr << "BulletWorld::Restore: Snapshot has " << header.objectCount << " objects, world has "
+                  << objects.size() << "!" << std::endl;
+        return false;
+    }
+    if (static_cast<size_t>(end - cursor) < header.objectCount * sizeof(ObjectRecord)) {
+        std::cerr << "BulletWorld::Restore: Truncated snapshot data!" << std::endl;
+        return false;
+    }
+    
+    for (int i = 0; i < objects.size(); ++i) {
+        ObjectRecord record;
+        ReadRecord(cursor, end, record);
+        
+        btTransform transform;
+        transform.setBasis(btMatrix3x3(record.basis[0], record.basis[1], record.basis[2],
+                                       record.basis[3], record.basis[4], record.basis[5],
+                                       record.basis[6], record.basis[7], record.basis[8]));
+        transform.setOrigin(LoadVector(record.origin));
+        
+        btCollisionObject* object = objects[i];
+        object->setWorldTransform(transform);
+        object->setInterpolationWorldTransform(transform);
+        object->forceActivationState(record.activationState);
+        object->setDeactivationTime(record.deactivationTime);
+        
+        btRigidBody* body = btRigidBody::upcast(object);
+        if (body) {
+            btVector3 linearVelocity = LoadVector(record.linearVelocity);
+            btVector3 angularVelocity = LoadVector(record.angularVelocity);
+            body->setLinearVelocity(linearVelocity);
+            body->setAngularVelocity(angularVelocity);
+            body->setInterpolationLinearVelocity(linearVelocity);
+            body->setInterpolationAngularVelocity(angularVelocity);
+            body->clearForces();
+            body->updateInertiaTensor();
+            if (body->getMotionState()) {
+                body->getMotionState()->setWorldTransform(transform);
+            }
+        }
+    }
+    
+    // Index the snapshot manifolds by body pair. A pair can own several manifolds
+    // (compound and mesh children), so the sort keeps their saved order.
+    std::vector<std::pair<uint64_t, const uint8_t*>> savedManifolds;
+    savedManifolds.reserve(header.manifoldCount);
+    for (uint32_t i = 0; i < header.manifoldCount; ++i) {
+        const uint8_t* recordStart = cursor;
+        ManifoldRecord record;
+        if (!ReadRecord(cursor, end, record) || record.numContacts < 0 ||
+            static_cast<size_t>(end - cursor) < record.numContacts * sizeof(ContactRecord)) {
+            std::cerr << "BulletWorld::Restore: Truncated snapshot data!" << std::endl;
+            return false;
+        }
+        cursor += record.numContacts * sizeof(ContactRecord);
+        savedManifolds.emplace_back(MakePairKey(record.indexA, record.indexB), recordStart);
+    }
+    std::stable_sort(savedManifolds.begin(), savedManifolds.end(),
+                     [](const std::pair<uint64_t, const uint8_t*>& a, const std::pair<uint64_t, const uint8_t*>& b) {
+                         return a.first < b.first;
+                     });
+    
+    // Refill the live manifolds in place. The n-th live manifold of a pair takes the pair's
+    // n-th saved manifold; manifolds without a saved counterpart lose their contacts.
+    std::vector<uint32_t> matchedPerPair(savedManifolds.size(), 0);
+    for (int i = 0; i < m_dispatcher->getNumManifolds(); ++i) {
+        btPersistentManifold* manifold = m_dispatcher->getManifoldByIndexInternal(i);
+        manifold->clearManifold();
+        
+        uint64_t key = MakePairKey(static_cast<uint32_t>(manifold->getBody0()->getWorldArrayIndex()),
+                                   static_cast<uint32_t>(manifold->getBody1()->getWorldArrayIndex()));
+        auto it = std::lower_bound(savedManifolds.begin(), savedManifolds.end(), key,
+                                   [](const std::pair<uint64_t, const uint8_t*>& entry, uint64_t value) {
+                                       return entry.first < value;
+                                   });
+        if (it == savedManifolds.end() || it->first != key) {
+            continue;
+        }
+        uint32_t& matched = matchedPerPair[it - savedManifolds.begin()];
+        it += matched;
+        if (it == savedManifolds.end() || it->first != key) {
+            continue;
+        }
+        ++matched;
+        
+        const uint8_t* saved = it->second;
+        ManifoldRecord record;
+        ReadRecord(saved, end, record);
+        for (int j = 0; j < record.numContacts; ++j) {
+            ContactRecord contact;
+            ReadRecord(saved, end, contact);
+            manifold->addManifoldPoint(LoadContact(contact));
+        }
+    }
+    
+    m_solver->setRandSeed(static_cast<unsigned long>(header.solverSeed));
+    
+    // Move the broadphase proxies to the restored positions
+    m_dynamicsWorld->updateAabbs();
+    return true;
 }
 
 void BulletWorld::HandleCollisions() {
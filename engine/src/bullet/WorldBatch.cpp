@@ -0,0 +1,150 @@
+#include "bullet/WorldBatch.h"
+#include "bullet/BulletCollisionShapes.h"
+#include "../core/ThreadPool.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // Small worlds step in microseconds; hand out a few per task to amortize scheduling
+    constexpr int WORLD_GRAIN_SIZE = 4;
+}
+
+WorldBatch::WorldBatch(int worldCount, const BulletWorldConfig& config)
+    : m_totalBodies(0)
+    , m_layoutDirty(true)
+{
+    BulletWorldConfig worldConfig = config;
+    worldConfig.debugLogging = false;
+    if (worldConfig.solver == SolverType::SequentialImpulseMt) {
+        std::cerr << "WorldBatch::WorldBatch: Worlds are stepped in parallel, using the sequential impulse solver instead of the Mt solver" << std::endl;
+        worldConfig.solver = SolverType::SequentialImpulse;
+    }
+    
+    int count = std::max(worldCount, 0);
+    m_worlds.reserve(count);
+    m_bodies.resize(count);
+    for (int i = 0; i < count; ++i) {
+        m_worlds.push_back(std::make_unique<BulletWorld>(worldConfig));
+    }
+}
+
+WorldBatch::~WorldBatch() {
+    for (size_t i = 0; i < m_worlds.size(); ++i) {
+        BulletMemory::ScopedArena arenaScope(m_worlds[i]->GetMemoryArena());
+        for (btRigidBody* body : m_bodies[i]) {
+            m_worlds[i]->RemoveRigidBody(body);
+            delete body;
+        }
+    }
+    m_bodies.clear();
+    
+    // Worlds first: their pair caches and manifolds reference the shared shapes
+    m_worlds.clear();
+    
+    for (btCollisionShape* shape : m_sharedShapes) {
+        BulletCollisionShapes::DeleteShape(shape);
+    }
+}
+
+btCollisionShape* WorldBatch::AddSharedShape(btCollisionShape* shape) {
+    if (shape) {
+        m_sharedShapes.push_back(shape);
+    }
+    return shape;
+}
+
+int WorldBatch::AddBody(int worldIndex, btCollisionShape* shape, float mass, const glm::vec3& position,
+                        const glm::vec3& velocity, CollisionLayer layer) {
+    if (worldIndex < 0 || worldIndex >= GetWorldCount() || !shape) {
+        std::cerr << "WorldBatch::AddBody: Invalid parameters!" << std::endl;
+        return -1;
+    }
+    
+    BulletWorld& world = *m_worlds[worldIndex];
+    BulletMemory::ScopedArena arenaScope(world.GetMemoryArena());
+    
+    glm::vec3 localInertia = BulletCollisionShapes::CalculateInertia(shape, mass);
+    btVector3 inertia(localInertia.x, localInertia.y, localInertia.z);
+    
+    // No motion state: observations read the body transform directly and nothing is interpolated
+    btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape, inertia);
+    info.m_startWorldTransform.setIdentity();
+    info.m_startWorldTransform.setOrigin(btVector3(position.x, position.y, position.z));
+    
+    // Same material defaults as BulletRigidBody
+    info.m_restitution = 0.1f;
+    info.m_friction = 0.8f;
+    info.m_rollingFriction = 0.05f;
+    info.m_spinningFriction = 0.05f;
+    
+    btRigidBody* body = new btRigidBody(info);
+    body->setLinearVelocity(btVector3(velocity.x, velocity.y, velocity.z));
+    
+    world.AddRigidBody(body, layer);
+    m_bodies[worldIndex].push_back(body);
+    m_layoutDirty = true;
+    return static_cast<int>(m_bodies[worldIndex].size()) - 1;
+}
+
+void WorldBatch::Step(float deltaTime, int maxSubSteps, float fixedTimeStep) {
+    if (m_layoutDirty) {
+        RebuildLayout();
+    }
+    
+    auto stepWorlds = [&](int begin, int end, int /*threadIndex*/) {
+        for (int i = begin; i < end; ++i) {
+            m_worlds[i]->Update(deltaTime, maxSubSteps, fixedTimeStep);
+            WriteObservations(i);
+        }
+    };
+    ThreadPool::getInstance().parallelFor(GetWorldCount(), WORLD_GRAIN_SIZE, stepWorlds);
+}
+
+void WorldBatch::UpdateObservations() {
+    if (m_layoutDirty) {
+        RebuildLayout();
+    }
+    
+    for (int i = 0; i < GetWorldCount(); ++i) {
+        WriteObservations(i);
+    }
+}
+
+void WorldBatch::RebuildLayout() {
+    m_bodyOffsets.resize(m_worlds.size() + 1);
+    int offset = 0;
+    for (size_t i = 0; i < m_worlds.size(); ++i) {
+        m_bodyOffsets[i] = offset;
+        offset += static_cast<int>(m_bodies[i].size());
+    }
+    m_bodyOffsets[m_worlds.size()] = offset;
+    
+    m_totalBodies = offset;
+    m_observations.assign(static_cast<size_t>(ObservationChannel::Count) * m_totalBodies, 0.0f);
+    m_layoutDirty = false;
+}
+
+void WorldBatch::WriteObservations(int worldIndex) {
+    // Each world owns a disjoint range of every channel, so worlds can write concurrently
+    const std::vector<btRigidBody*>& bodies = m_bodies[worldIndex];
+    size_t stride = static_cast<size_t>(m_totalBodies);
+    float* base = m_observations.data() + m_bodyOffsets[worldIndex];
+    
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        const btRigidBody* body = bodies[i];
+        const btVector3& position = body->getWorldTransform().getOrigin();
+        const btVector3& linearVelocity = body->getLinearVelocity();
+        const btVector3& angularVelocity = body->getAngularVelocity();
+        
+        float* out = base + i;
+        out[0 * stride] = position.x();
+        out[1 * stride] = position.y();
+        out[2 * stride] = position.z();
+        out[3 * stride] = linearVelocity.x();
+        out[4 * stride] = linearVelocity.y();
+        out[5 * stride] = linearVelocity.z();
+        out[6 * stride] = angularVelocity.x();
+        out[7 * stride] = angularVelocity.y();
+        out[8 * stride] = angularVelocity.z();
+    }
+}
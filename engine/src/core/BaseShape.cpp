@@ -0,0 +1,47 @@
+#include "BaseShape.h"
+#include "SlabAllocator.h"
+#include "ShapeGeometry.h"
+#include "../shapes/Box.h"
+#include "../shapes/Sphere.h"
+#include "../shapes/Cylinder.h"
+#include "../shapes/Plane.h"
+#include <algorithm>
+
+namespace {
+    constexpr size_t SHAPE_BLOCK_SIZE = std::max({sizeof(Box), sizeof(Sphere), sizeof(Cylinder), sizeof(Plane)});
+}
+
+SlabAllocator& BaseShape::getAllocator() {
+    // Never destroyed: shapes may still be released by other singletons during shutdown
+    static SlabAllocator* allocator = new SlabAllocator(SHAPE_BLOCK_SIZE);
+    return *allocator;
+}
+
+void* BaseShape::operator new(size_t size) {
+    // Shape types added later may not fit a block
+    if (size > SHAPE_BLOCK_SIZE) {
+        return ::operator new(size);
+    }
+    return getAllocator().allocate();
+}
+
+void BaseShape::operator delete(void* block, size_t size) {
+    // size is the dynamic type's size (the destructor is virtual)
+    if (size > SHAPE_BLOCK_SIZE) {
+        ::operator delete(block);
+        return;
+    }
+    getAllocator().deallocate(block);
+}
+
+const std::vector<float>& BaseShape::getVertices() const {
+    return getGeometry().vertices;
+}
+
+const std::vector<float>& BaseShape::getNormals() const {
+    return getGeometry().normals;
+}
+
+const std::vector<unsigned int>& BaseShape::getIndices() const {
+    return getGeometry().indices;
+}
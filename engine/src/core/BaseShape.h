@@ -1,26 +1,50 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
 
+// Shape type tag, lets pools and caches key shapes without dynamic_cast
+enum class ShapeType : uint8_t {
+    Box,
+    Sphere,
+    Cylinder,
+    Plane
+};
+
+class SlabAllocator;
+struct ShapeGeometry;
+
 class BaseShape {
 public:
     virtual ~BaseShape() = default;
     
+    // Shapes of all types share one slab sized for the largest shape (see BaseShape.cpp)
+    static void* operator new(size_t size);
+    static void operator delete(void* block, size_t size);
+    static SlabAllocator& getAllocator();
+    
     // Geometric properties
     virtual float getVolume() const = 0;
     virtual glm::mat3 getInertiaTensor(float mass) const = 0;
     virtual glm::vec3 getBoundingBoxMin() const = 0;
     virtual glm::vec3 getBoundingBoxMax() const = 0;
     
-    // Rendering data
-    virtual const std::vector<float>& getVertices() const = 0;
-    virtual const std::vector<float>& getNormals() const = 0;
-    virtual const std::vector<unsigned int>& getIndices() const = 0;
+    // Rendering data, shared between shapes with the same parameters (see ShapeGeometry.h).
+    // Vertices are unscaled: apply getScale() through the transform.
+    virtual const ShapeGeometry& getGeometry() const = 0;
+    const std::vector<float>& getVertices() const;
+    const std::vector<float>& getNormals() const;
+    const std::vector<unsigned int>& getIndices() const;
     
     // Shape type
     virtual const char* getTypeName() const = 0;
+    virtual ShapeType getType() const = 0;
+    
+    // Dimensions that define the shape, unused components are 0
+    // (Box: width/height/depth, Sphere: radius, Cylinder: radius/height, Plane: width/depth)
+    virtual glm::vec3 getParameters() const = 0;
     
     // Utility
     virtual glm::vec3 getCenter() const = 0;
@@ -1,33 +1,174 @@
 #include "PhysicsObjectPool.h"
 #include "RigidBody3D.h"
 #include "BaseShape.h"
+#include "SlabAllocator.h"
 #include "../shapes/Box.h"
 #include "../shapes/Sphere.h"
+#include "../shapes/Cylinder.h"
+#include "../shapes/Plane.h"
+#include <algorithm>
+#include <fstream>
 #include <sstream>
-#include <iomanip>
+
+namespace {
+    // Set once the singleton is gone; threads exiting later must not touch its pools
+    std::atomic<bool> s_poolDestroyed{false};
+    
+    const char* const PROFILE_HEADER = "# RealityCore physics pool usage profile v1";
+    
+    // Shape matching a key (dimensions at key precision)
+    std::unique_ptr<BaseShape> createShapeForKey(const ShapeKey& key) {
+        float a = ShapeKey::dequantize(key.parameters[0]);
+        float b = ShapeKey::dequantize(key.parameters[1]);
+        float c = ShapeKey::dequantize(key.parameters[2]);
+        
+        switch (static_cast<ShapeType>(key.type)) {
+            case ShapeType::Box: return std::make_unique<Box>(a, b, c);
+            case ShapeType::Sphere: return std::make_unique<Sphere>(a);
+            case ShapeType::Cylinder: return std::make_unique<Cylinder>(a, b);
+            case ShapeType::Plane: return std::make_unique<Plane>(a, b);
+        }
+        return nullptr;
+    }
+}
+
+// Free bodies of the last few shapes this thread used, handed back to the shared pools
+// when the thread exits
+struct PhysicsObjectPool::ThreadCache {
+    struct Entry {
+        ShapePool* pool = nullptr;
+        std::unique_ptr<RigidBody3D> bodies[THREAD_CACHE_SIZE];
+        size_t count = 0;
+    };
+    
+    Entry entries[THREAD_CACHE_POOLS];
+    size_t nextVictim = 0;
+    uint32_t generation = 0;
+    
+    ~ThreadCache() {
+        if (s_poolDestroyed.load(std::memory_order_acquire) ||
+            generation != PhysicsObjectPool::getInstance().m_generation.load(std::memory_order_acquire)) {
+            drop();
+            return;
+        }
+        for (Entry& entry : entries) {
+            flush(entry);
+        }
+    }
+    
+    Entry* find(const ShapePool* pool) {
+        for (Entry& entry : entries) {
+            if (entry.pool == pool) return &entry;
+        }
+        return nullptr;
+    }
+    
+    // Entry for a pool, evicting the oldest shape if all entries are taken
+    Entry& claim(ShapePool* pool) {
+        if (Entry* entry = find(pool)) return *entry;
+        
+        for (Entry& entry : entries) {
+            if (!entry.pool) {
+                entry.pool = pool;
+                return entry;
+            }
+        }
+        
+        Entry& victim = entries[nextVictim];
+        nextVictim = (nextVictim + 1) % THREAD_CACHE_POOLS;
+        flush(victim);
+        victim.pool = pool;
+        return victim;
+    }
+    
+    void flush(Entry& entry) {
+        while (entry.count > 0) {
+            returnToPool(entry.pool, std::move(entry.bodies[--entry.count]));
+        }
+        entry.pool = nullptr;
+    }
+    
+    // Destroy cached bodies without touching the shared pools
+    void drop() {
+        for (Entry& entry : entries) {
+            while (entry.count > 0) {
+                entry.bodies[--entry.count].reset();
+            }
+            entry.pool = nullptr;
+        }
+    }
+};
 
 PhysicsObjectPool& PhysicsObjectPool::getInstance() {
     static PhysicsObjectPool instance;
     return instance;
 }
 
+PhysicsObjectPool::~PhysicsObjectPool() {
+    waitForPrewarm();
+    if (!m_profilePath.empty()) {
+        saveUsageProfile(m_profilePath);
+    }
+    s_poolDestroyed.store(true, std::memory_order_release);
+}
+
+PhysicsObjectPool::ThreadCache& PhysicsObjectPool::getThreadCache() {
+    thread_local ThreadCache cache;
+    
+    // Bodies cached before clear() belong to the old pool contents
+    uint32_t generation = m_generation.load(std::memory_order_acquire);
+    if (cache.generation != generation) {
+        cache.drop();
+        cache.generation = generation;
+    }
+    return cache;
+}
+
 std::unique_ptr<RigidBody3D> PhysicsObjectPool::acquireRigidBody(std::unique_ptr<BaseShape> shape, float mass) {
     if (!shape) {
         return nullptr;
     }
     
-    std::string key = generateShapeKey(shape.get(), mass);
+    ShapePool* pool = findOrCreatePool(ShapeKey::fromShape(*shape, mass));
+    if (!pool) {
+        // Table full, fall back to the allocator
+        return std::make_unique<RigidBody3D>(std::move(shape), mass);
+    }
+    
+    // Usage profile
+    pool->totalAcquired.fetch_add(1, std::memory_order_relaxed);
+    int64_t inUse = pool->inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+    int64_t peak = pool->peakInUse.load(std::memory_order_relaxed);
+    while (inUse > peak && !pool->peakInUse.compare_exchange_weak(peak, inUse, std::memory_order_relaxed)) {
+    }
     
-    std::lock_guard<std::mutex> globalLock(m_globalMutex);
-    auto& pool = m_shapePools[key];
+    std::unique_ptr<RigidBody3D> body;
+    ThreadCache& cache = getThreadCache();
+    ThreadCache::Entry* entry = cache.find(pool);
     
-    std::lock_guard<std::mutex> poolLock(pool.mutex);
+    if (entry && entry->count > 0) {
+        // Fast path: this thread released a body of the same shape recently
+        body = std::move(entry->bodies[--entry->count]);
+    } else {
+        // Claim before locking: evicting another shape locks that shape's pool
+        ThreadCache::Entry& refill = cache.claim(pool);
+        
+        std::lock_guard<std::mutex> poolLock(pool->mutex);
+        if (!pool->available.empty()) {
+            body = std::move(pool->available.back());
+            pool->available.pop_back();
+            
+            // Take up to half a cache worth along, spawn bursts then stay off the lock
+            while (!pool->available.empty() && refill.count < THREAD_CACHE_SIZE / 2) {
+                refill.bodies[refill.count++] = std::move(pool->available.back());
+                pool->available.pop_back();
+            }
+        }
+    }
     
-    if (!pool.available.empty()) {
+    if (body) {
         // Reuse existing body
-        std::unique_ptr<RigidBody3D> body = std::move(pool.available.front());
-        pool.available.pop();
-        pool.totalReused++;
+        pool->totalReused.fetch_add(1, std::memory_order_relaxed);
         
         // Reset the body
         resetRigidBody(body.get());
@@ -37,11 +178,11 @@ std::unique_ptr<RigidBody3D> PhysicsObjectPool::acquireRigidBody(std::unique_ptr
         body->setMass(mass);
         
         return body;
-    } else {
-        // Create new body
-        pool.totalCreated++;
-        return std::make_unique<RigidBody3D>(std::move(shape), mass);
     }
+    
+    // Create new body
+    pool->totalCreated.fetch_add(1, std::memory_order_relaxed);
+    return std::make_unique<RigidBody3D>(std::move(shape), mass);
 }
 
 void PhysicsObjectPool::releaseRigidBody(std::unique_ptr<RigidBody3D> body) {
@@ -55,89 +196,81 @@ void PhysicsObjectPool::releaseRigidBody(std::unique_ptr<RigidBody3D> body) {
         return;
     }
     
-    float mass = body->getMass();
-    std::string key = generateShapeKey(shape, mass);
-    
-    std::lock_guard<std::mutex> globalLock(m_globalMutex);
-    auto& pool = m_shapePools[key];
+    ShapePool* pool = findOrCreatePool(ShapeKey::fromShape(*shape, body->getMass()));
+    if (!pool) {
+        body.reset();
+        return;
+    }
     
-    std::lock_guard<std::mutex> poolLock(pool.mutex);
+    pool->inUse.fetch_sub(1, std::memory_order_relaxed);
     
     // Reset the body
     resetRigidBody(body.get());
     
-    // Add to pool (limit pool size to prevent memory bloat)
-    if (pool.available.size() < 50) { // Max 50 bodies per shape type
-        pool.available.push(std::move(body));
-    } else {
-        // Pool is full, destroy the body
-        body.reset();
+    ThreadCache::Entry& entry = getThreadCache().claim(pool);
+    if (entry.count == THREAD_CACHE_SIZE) {
+        // Cache full, move half of it to the shared pool in one lock
+        std::lock_guard<std::mutex> poolLock(pool->mutex);
+        while (entry.count > THREAD_CACHE_SIZE / 2) {
+            std::unique_ptr<RigidBody3D> spilled = std::move(entry.bodies[--entry.count]);
+            
+            // Limit pool size to prevent memory bloat (extra bodies are destroyed)
+            if (pool->available.size() < pool->capacity) {
+                pool->available.push_back(std::move(spilled));
+            }
+        }
     }
+    entry.bodies[entry.count++] = std::move(body);
 }
 
 void PhysicsObjectPool::preallocateBodies() {
-    std::lock_guard<std::mutex> lock(m_globalMutex);
-    
     std::cout << "Pre-allocating physics bodies..." << std::endl;
     
     // Pre-allocate common shapes and masses
     const size_t preallocCount = 20;
+    const size_t preallocShapes = 4;
+    
+    // One slab each, so the prewarmed bodies and their shapes are contiguous
+    RigidBody3D::getAllocator().reserve(preallocCount * preallocShapes);
+    BaseShape::getAllocator().reserve(preallocCount * preallocShapes);
+    
+    auto preallocate = [this, preallocCount](auto makeShape, float mass) {
+        for (size_t i = 0; i < preallocCount; ++i) {
+            auto body = std::make_unique<RigidBody3D>(makeShape(), mass);
+            resetRigidBody(body.get());
+            
+            ShapePool* pool = findOrCreatePool(ShapeKey::fromShape(*body->getShape(), mass));
+            if (!pool) return;
+            
+            std::lock_guard<std::mutex> poolLock(pool->mutex);
+            if (pool->available.size() >= pool->capacity) return;
+            pool->available.push_back(std::move(body));
+            pool->totalCreated.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
     
     // Box bodies
-    for (size_t i = 0; i < preallocCount; ++i) {
-        auto boxShape = std::make_unique<Box>(1.0f, 1.0f, 1.0f);
-        auto body = std::make_unique<RigidBody3D>(std::move(boxShape), 10.0f);
-        resetRigidBody(body.get());
-        
-        std::string key = generateShapeKey(body->getShape(), 10.0f);
-        m_shapePools[key].available.push(std::move(body));
-        m_shapePools[key].totalCreated++;
-    }
+    preallocate([] { return std::make_unique<Box>(1.0f, 1.0f, 1.0f); }, 10.0f);
     
     // Small box bodies (for performance test)
-    for (size_t i = 0; i < preallocCount; ++i) {
-        auto boxShape = std::make_unique<Box>(0.4f, 0.4f, 0.4f);
-        auto body = std::make_unique<RigidBody3D>(std::move(boxShape), 1.0f);
-        resetRigidBody(body.get());
-        
-        std::string key = generateShapeKey(body->getShape(), 1.0f);
-        m_shapePools[key].available.push(std::move(body));
-        m_shapePools[key].totalCreated++;
-    }
+    preallocate([] { return std::make_unique<Box>(0.4f, 0.4f, 0.4f); }, 1.0f);
     
     // Sphere bodies
-    for (size_t i = 0; i < preallocCount; ++i) {
-        auto sphereShape = std::make_unique<Sphere>(0.5f, 32);
-        auto body = std::make_unique<RigidBody3D>(std::move(sphereShape), 5.0f);
-        resetRigidBody(body.get());
-        
-        std::string key = generateShapeKey(body->getShape(), 5.0f);
-        m_shapePools[key].available.push(std::move(body));
-        m_shapePools[key].totalCreated++;
-    }
+    preallocate([] { return std::make_unique<Sphere>(0.5f, 32); }, 5.0f);
     
     // Small sphere bodies (for performance test)
-    for (size_t i = 0; i < preallocCount; ++i) {
-        auto sphereShape = std::make_unique<Sphere>(0.3f, 32);
-        auto body = std::make_unique<RigidBody3D>(std::move(sphereShape), 1.0f);
-        resetRigidBody(body.get());
-        
-        std::string key = generateShapeKey(body->getShape(), 1.0f);
-        m_shapePools[key].available.push(std::move(body));
-        m_shapePools[key].totalCreated++;
-    }
+    preallocate([] { return std::make_unique<Sphere>(0.3f, 32); }, 1.0f);
     
     std::cout << "Physics object pool pre-allocation complete" << std::endl;
-    // printStatistics(); // Temporarily disabled to debug freezing issue
 }
 
 size_t PhysicsObjectPool::getTotalAvailable() const {
     std::lock_guard<std::mutex> lock(m_globalMutex);
     
     size_t total = 0;
-    for (const auto& pair : m_shapePools) {
-        std::lock_guard<std::mutex> poolLock(pair.second.mutex);
-        total += pair.second.available.size();
+    for (const auto& pool : m_pools) {
+        std::lock_guard<std::mutex> poolLock(pool->mutex);
+        total += pool->available.size();
     }
     return total;
 }
@@ -146,9 +279,8 @@ size_t PhysicsObjectPool::getTotalCreated() const {
     std::lock_guard<std::mutex> lock(m_globalMutex);
     
     size_t total = 0;
-    for (const auto& pair : m_shapePools) {
-        std::lock_guard<std::mutex> poolLock(pair.second.mutex);
-        total += pair.second.totalCreated;
+    for (const auto& pool : m_pools) {
+        total += pool->totalCreated.load(std::memory_order_relaxed);
     }
     return total;
 }
@@ -157,51 +289,251 @@ size_t PhysicsObjectPool::getTotalReused() const {
     std::lock_guard<std::mutex> lock(m_globalMutex);
     
     size_t total = 0;
-    for (const auto& pair : m_shapePools) {
-        std::lock_guard<std::mutex> poolLock(pair.second.mutex);
-        total += pair.second.totalReused;
+    for (const auto& pool : m_pools) {
+        total += pool->totalReused.load(std::memory_order_relaxed);
     }
     return total;
 }
 
 void PhysicsObjectPool::printStatistics() const {
-    // Don't use global mutex to avoid deadlock - just print basic info
+    // Counters are atomics, so this only needs the global mutex to walk the pool list
+    std::lock_guard<std::mutex> lock(m_globalMutex);
+    
+    size_t created = 0;
+    size_t reused = 0;
+    for (const auto& pool : m_pools) {
+        created += pool->totalCreated.load(std::memory_order_relaxed);
+        reused += pool->totalReused.load(std::memory_order_relaxed);
+    }
+    
     std::cout << "\n=== Physics Object Pool Statistics ===" << std::endl;
-    std::cout << "Total pools: " << m_shapePools.size() << std::endl;
+    std::cout << "Total pools: " << m_pools.size() << " / " << MAX_SHAPE_POOLS << std::endl;
+    std::cout << "Bodies created: " << created << ", reused: " << reused << std::endl;
+    std::cout << "Body slabs: " << RigidBody3D::getAllocator().getSlabCount()
+              << " (" << RigidBody3D::getAllocator().getBlocksInUse() << " / "
+              << RigidBody3D::getAllocator().getCapacity() << " blocks in use)" << std::endl;
+    std::cout << "Shape slabs: " << BaseShape::getAllocator().getSlabCount()
+              << " (" << BaseShape::getAllocator().getBlocksInUse() << " / "
+              << BaseShape::getAllocator().getCapacity() << " blocks in use)" << std::endl;
     std::cout << "=====================================" << std::endl;
 }
 
 void PhysicsObjectPool::clear() {
+    waitForPrewarm();
+    
+    // Usage profile counters are kept, bodies handed out are still in use
     std::lock_guard<std::mutex> lock(m_globalMutex);
     
-    for (auto& pair : m_shapePools) {
-        std::lock_guard<std::mutex> poolLock(pair.second.mutex);
+    for (auto& pool : m_pools) {
+        std::lock_guard<std::mutex> poolLock(pool->mutex);
         
-        while (!pair.second.available.empty()) {
-            pair.second.available.pop();
-        }
-        pair.second.totalCreated = 0;
-        pair.second.totalReused = 0;
+        // clear() keeps the reserved capacity
+        pool->available.clear();
+        pool->totalCreated.store(0, std::memory_order_relaxed);
+        pool->totalReused.store(0, std::memory_order_relaxed);
     }
+    m_generation.fetch_add(1, std::memory_order_acq_rel);
     
     std::cout << "Physics object pool cleared" << std::endl;
 }
 
-std::string PhysicsObjectPool::generateShapeKey(const BaseShape* shape, float mass) {
-    if (!shape) return "unknown_0.0";
+void PhysicsObjectPool::enableUsageProfile(const std::string& path) {
+    waitForPrewarm();
+    
+    m_profilePath = path;
+    m_profileStart = std::chrono::steady_clock::now();
+    m_loadedProfile.clear();
     
-    std::ostringstream oss;
-    oss << shape->getTypeName() << "_" << std::fixed << std::setprecision(2) << mass;
+    std::ifstream file(path);
+    if (!file) {
+        std::cout << "PhysicsObjectPool: No usage profile at " << path << ", recording a new one" << std::endl;
+        return;
+    }
     
-    // Add specific shape parameters
-    if (const Box* box = dynamic_cast<const Box*>(shape)) {
-        glm::vec3 dims = box->getDimensions();
-        oss << "_" << dims.x << "x" << dims.y << "x" << dims.z;
-    } else if (const Sphere* sphere = dynamic_cast<const Sphere*>(shape)) {
-        oss << "_r" << sphere->getRadius();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        
+        // type parameter0 parameter1 parameter2 mass peakInUse acquiresPerSecond (quantized key fields)
+        std::istringstream fields(line);
+        int type = 0;
+        UsageRecord record;
+        if (!(fields >> type >> record.key.parameters[0] >> record.key.parameters[1] >> record.key.parameters[2]
+                     >> record.key.mass >> record.peakInUse >> record.acquiresPerSecond)) {
+            std::cerr << "PhysicsObjectPool::enableUsageProfile: Malformed line in " << path << "!" << std::endl;
+            continue;
+        }
+        if (type < 0 || type > static_cast<int>(ShapeType::Plane) || record.peakInUse == 0) continue;
+        
+        record.key.type = static_cast<uint8_t>(type);
+        m_loadedProfile.push_back(record);
     }
     
-    return oss.str();
+    if (m_loadedProfile.empty()) return;
+    
+    // Hottest shapes first, so spawn bursts right after startup find them ready
+    std::vector<UsageRecord> records = m_loadedProfile;
+    std::sort(records.begin(), records.end(), [](const UsageRecord& a, const UsageRecord& b) {
+        return a.acquiresPerSecond > b.acquiresPerSecond;
+    });
+    
+    std::cout << "PhysicsObjectPool: Prewarming " << records.size() << " shapes from " << path << std::endl;
+    m_prewarmThread = std::thread(&PhysicsObjectPool::prewarm, this, std::move(records));
+}
+
+void PhysicsObjectPool::waitForPrewarm() {
+    if (m_prewarmThread.joinable()) {
+        m_prewarmThread.join();
+    }
+}
+
+void PhysicsObjectPool::prewarm(std::vector<UsageRecord> records) {
+    // One slab for everything, so prewarmed bodies and shapes are contiguous
+    size_t total = 0;
+    for (const UsageRecord& record : records) {
+        total += record.peakInUse;
+    }
+    RigidBody3D::getAllocator().reserve(total);
+    BaseShape::getAllocator().reserve(total);
+    
+    for (const UsageRecord& record : records) {
+        ShapePool* pool = findOrCreatePool(record.key);
+        if (!pool) break;
+        
+        {
+            // Keep every body of the profiled peak when it is released again
+            std::lock_guard<std::mutex> poolLock(pool->mutex);
+            pool->capacity = std::max(pool->capacity, record.peakInUse);
+            pool->available.reserve(pool->capacity);
+        }
+        
+        float mass = ShapeKey::dequantize(record.key.mass);
+        for (size_t i = 0; i < record.peakInUse; ++i) {
+            // Construct outside the lock, threads acquiring meanwhile are not blocked
+            auto body = std::make_unique<RigidBody3D>(createShapeForKey(record.key), mass);
+            resetRigidBody(body.get());
+            
+            std::lock_guard<std::mutex> poolLock(pool->mutex);
+            if (pool->available.size() >= record.peakInUse) break;
+            pool->available.push_back(std::move(body));
+            pool->totalCreated.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::vector<PhysicsObjectPool::UsageRecord> PhysicsObjectPool::collectUsageProfile() const {
+    std::lock_guard<std::mutex> lock(m_globalMutex);
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_profileStart).count();
+    std::vector<UsageRecord> records;
+    for (const auto& pool : m_pools) {
+        size_t acquired = pool->totalAcquired.load(std::memory_order_relaxed);
+        int64_t peak = pool->peakInUse.load(std::memory_order_relaxed);
+        if (acquired == 0 || peak <= 0) continue;
+        
+        UsageRecord record;
+        record.key = pool->key;
+        record.peakInUse = static_cast<size_t>(peak);
+        record.acquiresPerSecond = seconds > 0.0 ? acquired / seconds : 0.0;
+        records.push_back(record);
+    }
+    
+    // Shapes the previous run used but this one did not are carried over
+    for (const UsageRecord& loaded : m_loadedProfile) {
+        bool used = std::any_of(records.begin(), records.end(), [&](const UsageRecord& record) {
+            return record.key == loaded.key;
+        });
+        if (!used) {
+            records.push_back(loaded);
+        }
+    }
+    return records;
+}
+
+bool PhysicsObjectPool::saveUsageProfile(const std::string& path) const {
+    std::vector<UsageRecord> records = collectUsageProfile();
+    
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "PhysicsObjectPool::saveUsageProfile: Failed to open " << path << "!" << std::endl;
+        return false;
+    }
+    
+    file << PROFILE_HEADER << "\n";
+    file << "# type parameter0 parameter1 parameter2 mass peakInUse acquiresPerSecond\n";
+    for (const UsageRecord& record : records) {
+        file << static_cast<int>(record.key.type) << " " << record.key.parameters[0] << " "
+             << record.key.parameters[1] << " " << record.key.parameters[2] << " " << record.key.mass << " "
+             << record.peakInUse << " " << record.acquiresPerSecond << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+void PhysicsObjectPool::printUsageProfile() const {
+    std::vector<UsageRecord> records = collectUsageProfile();
+    
+    std::cout << "\n=== Physics Object Pool Usage Profile ===" << std::endl;
+    for (const UsageRecord& record : records) {
+        std::cout << static_cast<int>(record.key.type) << " ["
+                  << ShapeKey::dequantize(record.key.parameters[0]) << ", "
+                  << ShapeKey::dequantize(record.key.parameters[1]) << ", "
+                  << ShapeKey::dequantize(record.key.parameters[2]) << "] mass "
+                  << ShapeKey::dequantize(record.key.mass) << ": peak " << record.peakInUse
+                  << ", " << record.acquiresPerSecond << " acquires/s" << std::endl;
+    }
+    std::cout << "=========================================" << std::endl;
+}
+
+PhysicsObjectPool::ShapePool* PhysicsObjectPool::findPool(const ShapeKey& key) const {
+    // Linear probing; pools are published with a release store after their key is set
+    size_t index = static_cast<size_t>(key.hash()) & (MAX_SHAPE_POOLS - 1);
+    for (size_t probe = 0; probe < MAX_SHAPE_POOLS; ++probe) {
+        ShapePool* pool = m_slots[index].load(std::memory_order_acquire);
+        if (!pool) return nullptr;
+        if (pool->key == key) return pool;
+        index = (index + 1) & (MAX_SHAPE_POOLS - 1);
+    }
+    return nullptr;
+}
+
+PhysicsObjectPool::ShapePool* PhysicsObjectPool::findOrCreatePool(const ShapeKey& key) {
+    if (ShapePool* pool = findPool(key)) {
+        return pool;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_globalMutex);
+    
+    // Another thread may have inserted it meanwhile
+    if (ShapePool* pool = findPool(key)) {
+        return pool;
+    }
+    
+    // Keep the table at most 3/4 full so probe sequences stay short
+    if (m_pools.size() >= MAX_SHAPE_POOLS * 3 / 4) {
+        return nullptr;
+    }
+    
+    auto pool = std::make_unique<ShapePool>();
+    pool->key = key;
+    pool->available.reserve(MAX_POOLED_PER_SHAPE);
+    
+    size_t index = static_cast<size_t>(key.hash()) & (MAX_SHAPE_POOLS - 1);
+    while (m_slots[index].load(std::memory_order_relaxed)) {
+        index = (index + 1) & (MAX_SHAPE_POOLS - 1);
+    }
+    m_slots[index].store(pool.get(), std::memory_order_release);
+    
+    m_pools.push_back(std::move(pool));
+    return m_pools.back().get();
+}
+
+void PhysicsObjectPool::returnToPool(ShapePool* pool, std::unique_ptr<RigidBody3D> body) {
+    std::lock_guard<std::mutex> poolLock(pool->mutex);
+    
+    // Limit pool size to prevent memory bloat (extra bodies are destroyed)
+    if (pool->available.size() < pool->capacity) {
+        pool->available.push_back(std::move(body));
+    }
 }
 
 void PhysicsObjectPool::resetRigidBody(RigidBody3D* body) {
@@ -1,12 +1,14 @@
 #pragma once
 
-#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
-#include <queue>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <iostream>
+#include "ShapeKey.h"
 
 // Forward declarations
 class RigidBody3D;
@@ -15,6 +17,11 @@ class Box;
 class Sphere;
 
 // Specialized object pool for physics bodies with different shapes
+// Pools are keyed by ShapeKey in a fixed open addressing table that is read without locks,
+// and every thread keeps a small cache of free bodies in front of the shared pools, so
+// acquire/release of a recently used shape takes no lock and does not allocate.
+// Bodies and shapes themselves come from slabs (see SlabAllocator), so pooled bodies
+// are also packed together in memory
 class PhysicsObjectPool {
 public:
     // Singleton pattern
@@ -29,35 +36,79 @@ public:
     // Pre-allocate bodies for common shapes
     void preallocateBodies();
     
-    // Get pool statistics
+    // Record a usage profile (peak concurrent bodies and acquire rate per shape) that is
+    // saved to path at shutdown; if path holds a profile from an earlier run, prewarm
+    // exactly its peak counts on a background thread
+    void enableUsageProfile(const std::string& path);
+    bool saveUsageProfile(const std::string& path) const;
+    void waitForPrewarm();
+    void printUsageProfile() const;
+    
+    // Get pool statistics (bodies held in per-thread caches are not counted as available)
     size_t getTotalAvailable() const;
     size_t getTotalCreated() const;
     size_t getTotalReused() const;
     void printStatistics() const;
     
-    // Clear all pools
+    // Clear all pools (per-thread caches are dropped the next time their thread uses the pool)
     void clear();
 
 private:
     PhysicsObjectPool() = default;
-    ~PhysicsObjectPool() = default;
+    ~PhysicsObjectPool();
     
     // Disable copy constructor and assignment operator
     PhysicsObjectPool(const PhysicsObjectPool&) = delete;
     PhysicsObjectPool& operator=(const PhysicsObjectPool&) = delete;
     
-    // Pool for different shape types
+    static constexpr size_t MAX_SHAPE_POOLS = 256;       // Table slots (power of two)
+    static constexpr size_t MAX_POOLED_PER_SHAPE = 50;   // Shared free bodies per shape (unless profiled higher)
+    static constexpr size_t THREAD_CACHE_POOLS = 4;      // Shapes cached per thread
+    static constexpr size_t THREAD_CACHE_SIZE = 8;       // Free bodies cached per shape and thread
+    
+    // Shared pool for one shape/mass combination
     struct ShapePool {
-        std::queue<std::unique_ptr<RigidBody3D>> available;
-        size_t totalCreated = 0;
-        size_t totalReused = 0;
+        ShapeKey key;
+        std::vector<std::unique_ptr<RigidBody3D>> available; // Reserved to capacity
+        size_t capacity = MAX_POOLED_PER_SHAPE;              // Guarded by mutex
+        std::atomic<size_t> totalCreated{0};
+        std::atomic<size_t> totalReused{0};
+        
+        // Usage profile
+        std::atomic<size_t> totalAcquired{0};
+        std::atomic<int64_t> inUse{0};
+        std::atomic<int64_t> peakInUse{0};
         mutable std::mutex mutex;
     };
     
-    std::unordered_map<std::string, ShapePool> m_shapePools;
-    mutable std::mutex m_globalMutex;
+    // One line of a persisted usage profile
+    struct UsageRecord {
+        ShapeKey key;
+        size_t peakInUse = 0;
+        double acquiresPerSecond = 0.0;
+    };
+    
+    // Per-thread free lists, defined in the .cpp
+    struct ThreadCache;
+    
+    // Slots are only ever filled (never emptied), so a null slot ends a lookup
+    std::atomic<ShapePool*> m_slots[MAX_SHAPE_POOLS] = {};
+    std::vector<std::unique_ptr<ShapePool>> m_pools;  // Owns the pools, guarded by m_globalMutex
+    std::atomic<uint32_t> m_generation{0};            // Bumped by clear() to invalidate thread caches
+    mutable std::mutex m_globalMutex;                 // Only taken to insert a pool or walk m_pools
+    
+    // Usage profile
+    std::chrono::steady_clock::time_point m_profileStart = std::chrono::steady_clock::now();
+    std::string m_profilePath;                        // Saved at shutdown when set
+    std::vector<UsageRecord> m_loadedProfile;         // Profile of the previous run
+    std::thread m_prewarmThread;
     
     // Helper methods
-    std::string generateShapeKey(const BaseShape* shape, float mass);
+    ShapePool* findPool(const ShapeKey& key) const;
+    ShapePool* findOrCreatePool(const ShapeKey& key);
+    ThreadCache& getThreadCache();
+    static void returnToPool(ShapePool* pool, std::unique_ptr<RigidBody3D> body);
+    void prewarm(std::vector<UsageRecord> records);
+    std::vector<UsageRecord> collectUsageProfile() const;
     void resetRigidBody(RigidBody3D* body);
 };
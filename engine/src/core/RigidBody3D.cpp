@@ -1,8 +1,31 @@
 #include "RigidBody3D.h"
+#include "SlabAllocator.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <algorithm>
 
+SlabAllocator& RigidBody3D::getAllocator() {
+    // Never destroyed: bodies may still be released by other singletons during shutdown
+    static SlabAllocator* allocator = new SlabAllocator(sizeof(RigidBody3D));
+    return *allocator;
+}
+
+void* RigidBody3D::operator new(size_t size) {
+    // Derived classes are larger than a block
+    if (size != sizeof(RigidBody3D)) {
+        return ::operator new(size);
+    }
+    return getAllocator().allocate();
+}
+
+void RigidBody3D::operator delete(void* block, size_t size) {
+    if (size != sizeof(RigidBody3D)) {
+        ::operator delete(block);
+        return;
+    }
+    getAllocator().deallocate(block);
+}
+
 // Constructor with shape and mass
 RigidBody3D::RigidBody3D(std::unique_ptr<BaseShape> shape, float mass) 
     : m_shape(std::move(shape)), m_mass(mass) {
@@ -6,11 +6,18 @@
 #include "BaseShape.h"
 #include "PhysicsConstants.h"
 
+class SlabAllocator;
+
 class RigidBody3D {
 public:
     // Constructor with shape and mass
     RigidBody3D(std::unique_ptr<BaseShape> shape, float mass = Physics::DEFAULT_MASS);
     virtual ~RigidBody3D() = default;
+    
+    // Bodies are placed in a shared slab so they stay packed in memory
+    static void* operator new(size_t size);
+    static void operator delete(void* block, size_t size);
+    static SlabAllocator& getAllocator();
 
     // Geometric properties
     std::unique_ptr<BaseShape> m_shape;
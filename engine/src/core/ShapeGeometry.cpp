@@ -0,0 +1,56 @@
+#include "ShapeGeometry.h"
+#include <cstring>
+
+size_t ShapeGeometryKeyHash::operator()(const ShapeGeometryKey& key) const {
+    uint32_t words[8];
+    words[0] = static_cast<uint32_t>(key.type);
+    words[1] = static_cast<uint32_t>(key.segments);
+    std::memcpy(&words[2], &key.parameters, sizeof(float) * 3);
+    std::memcpy(&words[5], &key.normal, sizeof(float) * 3);
+    
+    // FNV-1a over the fields
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (uint32_t word : words) {
+        hash = (hash ^ word) * 0x100000001B3ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+ShapeGeometryRegistry& ShapeGeometryRegistry::getInstance() {
+    static ShapeGeometryRegistry instance;
+    return instance;
+}
+
+const ShapeGeometry* ShapeGeometryRegistry::getOrCreate(const ShapeGeometryKey& key,
+                                                         const std::function<void(ShapeGeometry&)>& generate) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto it = m_geometry.find(key);
+    if (it != m_geometry.end()) {
+        return it->second.get();
+    }
+    
+    // Generating under the lock keeps concurrent first requests from building twice;
+    // primitive meshes take microseconds
+    auto geometry = std::make_unique<ShapeGeometry>();
+    generate(*geometry);
+    const ShapeGeometry* result = geometry.get();
+    m_geometry.emplace(key, std::move(geometry));
+    return result;
+}
+
+size_t ShapeGeometryRegistry::getGeometryCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_geometry.size();
+}
+
+size_t ShapeGeometryRegistry::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t bytes = 0;
+    for (const auto& entry : m_geometry) {
+        const ShapeGeometry& geometry = *entry.second;
+        bytes += (geometry.vertices.size() + geometry.normals.size()) * sizeof(float) +
+                 geometry.indices.size() * sizeof(unsigned int);
+    }
+    return bytes;
+}
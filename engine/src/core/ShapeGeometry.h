@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "BaseShape.h"
+
+// Immutable mesh data shared by every shape with the same parameters. Vertices are
+// unscaled; the shape's scale is applied through its transform.
+struct ShapeGeometry {
+    std::vector<float> vertices;
+    std::vector<float> normals;
+    std::vector<unsigned int> indices;
+};
+
+// Identifies a geometry: shape type, unscaled dimensions, resolution and (planes) normal
+struct ShapeGeometryKey {
+    ShapeType type = ShapeType::Box;
+    int32_t segments = 0;
+    glm::vec3 parameters = glm::vec3(0.0f);
+    glm::vec3 normal = glm::vec3(0.0f);
+    
+    bool operator==(const ShapeGeometryKey& other) const {
+        return type == other.type && segments == other.segments &&
+               parameters == other.parameters && normal == other.normal;
+    }
+};
+
+struct ShapeGeometryKeyHash {
+    size_t operator()(const ShapeGeometryKey& key) const;
+};
+
+// Flyweight registry: 10k identical spheres share one vertex/normal/index set
+class ShapeGeometryRegistry {
+public:
+    // Singleton pattern
+    static ShapeGeometryRegistry& getInstance();
+    
+    // Geometry for a key, built by generate on first use. The pointer stays valid
+    // for the lifetime of the registry.
+    const ShapeGeometry* getOrCreate(const ShapeGeometryKey& key, const std::function<void(ShapeGeometry&)>& generate);
+    
+    // Get registry statistics
+    size_t getGeometryCount() const;
+    size_t getMemoryUsage() const;
+    
+private:
+    ShapeGeometryRegistry() = default;
+    ~ShapeGeometryRegistry() = default;
+    
+    // Disable copy constructor and assignment operator
+    ShapeGeometryRegistry(const ShapeGeometryRegistry&) = delete;
+    ShapeGeometryRegistry& operator=(const ShapeGeometryRegistry&) = delete;
+    
+    std::unordered_map<ShapeGeometryKey, std::unique_ptr<const ShapeGeometry>, ShapeGeometryKeyHash> m_geometry;
+    
+    // Thread safety
+    mutable std::mutex m_mutex;
+};
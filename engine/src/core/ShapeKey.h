@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "BaseShape.h"
+
+// Trivially copyable key for a shape/mass combination: shape type plus dimensions and
+// mass quantized to centimeters and 10 g (the precision the old string keys printed)
+struct ShapeKey {
+    static constexpr float QUANTIZATION = 100.0f;
+
+    uint8_t type = 0;
+    uint8_t padding[3] = {0, 0, 0};
+    int32_t parameters[3] = {0, 0, 0};
+    int32_t mass = 0;
+
+    static int32_t quantize(float value) {
+        return static_cast<int32_t>(std::lround(value * QUANTIZATION));
+    }
+    static float dequantize(int32_t value) {
+        return static_cast<float>(value) / QUANTIZATION;
+    }
+
+    static ShapeKey fromShape(const BaseShape& shape, float mass) {
+        ShapeKey key;
+        key.type = static_cast<uint8_t>(shape.getType());
+        glm::vec3 parameters = shape.getParameters();
+        key.parameters[0] = quantize(parameters.x);
+        key.parameters[1] = quantize(parameters.y);
+        key.parameters[2] = quantize(parameters.z);
+        key.mass = quantize(mass);
+        return key;
+    }
+
+    bool operator==(const ShapeKey& other) const {
+        return type == other.type && mass == other.mass &&
+               parameters[0] == other.parameters[0] &&
+               parameters[1] == other.parameters[1] &&
+               parameters[2] == other.parameters[2];
+    }
+    bool operator!=(const ShapeKey& other) const { return !(*this == other); }
+
+    // 64-bit mix of the fields (splitmix64 finalizer)
+    uint64_t hash() const {
+        uint64_t h = type;
+        h = h * 0x100000001B3ULL ^ static_cast<uint32_t>(parameters[0]);
+        h = h * 0x100000001B3ULL ^ static_cast<uint32_t>(parameters[1]);
+        h = h * 0x100000001B3ULL ^ static_cast<uint32_t>(parameters[2]);
+        h = h * 0x100000001B3ULL ^ static_cast<uint32_t>(mass);
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+        return h;
+    }
+};
+
+struct ShapeKeyHash {
+    size_t operator()(const ShapeKey& key) const { return static_cast<size_t>(key.hash()); }
+};
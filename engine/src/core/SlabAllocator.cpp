@@ -0,0 +1,77 @@
+#include "SlabAllocator.h"
+#include <new>
+
+SlabAllocator::SlabAllocator(size_t blockSize, size_t blocksPerSlab)
+    : m_blocksPerSlab(blocksPerSlab > 0 ? blocksPerSlab : 1) {
+    // Every block must hold a free list link and keep the next block aligned
+    size_t size = blockSize > sizeof(FreeBlock) ? blockSize : sizeof(FreeBlock);
+    m_blockSize = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+SlabAllocator::~SlabAllocator() {
+    for (void* slab : m_slabs) {
+        ::operator delete(slab);
+    }
+}
+
+void* SlabAllocator::allocate() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (!m_freeList) {
+        addSlab(m_blocksPerSlab);
+    }
+    
+    FreeBlock* block = m_freeList;
+    m_freeList = block->next;
+    m_blocksInUse++;
+    return block;
+}
+
+void SlabAllocator::deallocate(void* block) {
+    if (!block) return;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = m_freeList;
+    m_freeList = freeBlock;
+    m_blocksInUse--;
+}
+
+void SlabAllocator::reserve(size_t count) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    size_t available = m_capacity - m_blocksInUse;
+    if (count > available) {
+        addSlab(count - available);
+    }
+}
+
+size_t SlabAllocator::getSlabCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slabs.size();
+}
+
+size_t SlabAllocator::getCapacity() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+size_t SlabAllocator::getBlocksInUse() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_blocksInUse;
+}
+
+void SlabAllocator::addSlab(size_t blocks) {
+    char* slab = static_cast<char*>(::operator new(blocks * m_blockSize));
+    m_slabs.push_back(slab);
+    m_capacity += blocks;
+    
+    // Thread the new blocks in address order in front of the free list, so a run of
+    // allocations walks the slab sequentially
+    for (size_t i = blocks; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * m_blockSize);
+        block->next = m_freeList;
+        m_freeList = block;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Fixed-size block allocator: blocks are carved out of large contiguous slabs, never move
+// (stable addresses) and are recycled through an intrusive free list (O(1) allocate/free).
+// Blocks freed last are handed out first, so hot objects stay packed together.
+class SlabAllocator {
+public:
+    // Block alignment (same guarantee as global operator new)
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+    
+    SlabAllocator(size_t blockSize, size_t blocksPerSlab = 256);
+    ~SlabAllocator();
+    
+    // Allocate one block of getBlockSize() bytes (grows by one slab when empty)
+    void* allocate();
+    
+    // Return a block obtained from allocate()
+    void deallocate(void* block);
+    
+    // Make sure count blocks can be allocated without growing; the new blocks are one slab
+    void reserve(size_t count);
+    
+    // Statistics
+    size_t getBlockSize() const { return m_blockSize; }
+    size_t getSlabCount() const;
+    size_t getCapacity() const;
+    size_t getBlocksInUse() const;
+
+private:
+    // Free blocks store the link to the next free block in place
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    
+    // Disable copy constructor and assignment operator
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+    
+    void addSlab(size_t blocks);
+    
+    size_t m_blockSize;
+    size_t m_blocksPerSlab;
+    std::vector<void*> m_slabs;
+    FreeBlock* m_freeList = nullptr;
+    size_t m_capacity = 0;
+    size_t m_blocksInUse = 0;
+    mutable std::mutex m_mutex;
+};
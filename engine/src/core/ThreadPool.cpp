@@ -0,0 +1,150 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+    // Set while the current thread executes a task, so nested parallelFor calls run inline
+    thread_local bool t_insideTask = false;
+}
+
+ThreadPool& ThreadPool::getInstance() {
+    static ThreadPool instance(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+    return instance;
+}
+
+ThreadPool::ThreadPool(int numThreads) {
+    int workerCount = std::max(0, numThreads - 1);
+    m_workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i) {
+        // Thread index 0 is reserved for the calling thread
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i + 1);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+    
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(int count, int grainSize, const Task& task) {
+    if (count <= 0) {
+        return;
+    }
+    grainSize = std::max(1, grainSize);
+    
+    // Small jobs, single-threaded pools and nested calls run inline
+    if (m_workers.empty() || count <= grainSize || t_insideTask) {
+        task(0, count, 0);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> jobLock(m_jobMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_count = count;
+        m_grainSize = grainSize;
+        m_nextIndex.store(0, std::memory_order_relaxed);
+        m_activeWorkers = 0;
+        ++m_generation;
+    }
+    m_wakeCondition.notify_all();
+    
+    // The calling thread participates as thread 0
+    t_insideTask = true;
+    runChunks(0);
+    t_insideTask = false;
+    
+    // Every chunk has been handed out; wait for the workers that joined to finish theirs
+    std::exception_ptr exception;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this] { return m_activeWorkers == 0; });
+        m_task = nullptr;
+        exception = m_exception;
+        m_exception = nullptr;
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::submit(Job job) {
+    if (m_workers.empty()) {
+        job();
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_wakeCondition.notify_one();
+}
+
+void ThreadPool::workerLoop(int threadIndex) {
+    t_insideTask = true;
+    uint64_t seenGeneration = 0;
+    
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [&] {
+                return m_stopping || (m_task && m_generation != seenGeneration) || !m_jobs.empty();
+            });
+            
+            // Loop chunks first, then queued jobs; queued jobs are drained before stopping
+            if (m_task && m_generation != seenGeneration) {
+                seenGeneration = m_generation;
+                ++m_activeWorkers;
+            } else if (!m_jobs.empty()) {
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            } else {
+                return;
+            }
+        }
+        
+        if (job) {
+            job();
+            continue;
+        }
+        
+        runChunks(threadIndex);
+        
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_activeWorkers == 0) {
+            m_doneCondition.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runChunks(int threadIndex) {
+    while (true) {
+        int begin = m_nextIndex.fetch_add(m_grainSize, std::memory_order_relaxed);
+        if (begin >= m_count) {
+            break;
+        }
+        int end = std::min(begin + m_grainSize, m_count);
+        try {
+            (*m_task)(begin, end, threadIndex);
+        } catch (...) {
+            // Keep the first exception for the caller and stop handing out chunks
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception) {
+                m_exception = std::current_exception();
+            }
+            m_nextIndex.store(m_count, std::memory_order_relaxed);
+            break;
+        }
+    }
+}
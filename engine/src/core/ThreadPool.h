@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size worker pool for data-parallel loops and background jobs
+//
+// parallelFor splits [0, count) into chunks of grainSize and runs them on the
+// workers and the calling thread. Each invocation receives a thread index in
+// [0, getThreadCount()) so callers can keep per-thread scratch data without locking.
+// submit queues a job that idle workers pick up between parallelFor calls.
+class ThreadPool {
+public:
+    // Task signature: process items [begin, end) on thread threadIndex
+    using Task = std::function<void(int begin, int end, int threadIndex)>;
+    
+    // Background job signature (see submit)
+    using Job = std::function<void()>;
+    
+    // Shared pool sized to the hardware concurrency
+    static ThreadPool& getInstance();
+    
+    // Create a pool with numThreads threads in total (including the calling thread)
+    explicit ThreadPool(int numThreads);
+    ~ThreadPool();
+    
+    // Disable copy constructor and assignment operator
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    // Run task over [0, count) and block until every chunk has finished.
+    // Nested calls from inside a task run serially on the current thread.
+    // If a chunk throws, the remaining chunks are skipped and the first exception is
+    // rethrown on the calling thread.
+    void parallelFor(int count, int grainSize, const Task& task);
+    
+    // Queue job on a worker and return immediately; a single-threaded pool runs it inline.
+    // Jobs run in submission order. Workers busy with a job skip the current parallelFor,
+    // whose chunks the calling thread and the other workers take over. The job must not
+    // throw; wrap it in a std::packaged_task to hand a result or exception back.
+    void submit(Job job);
+    
+    // Number of threads that may execute tasks (workers + calling thread)
+    int getThreadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+    
+private:
+    void workerLoop(int threadIndex);
+    void runChunks(int threadIndex);
+    
+    std::vector<std::thread> m_workers;
+    
+    // Current job, published under m_mutex
+    const Task* m_task = nullptr;
+    int m_count = 0;
+    int m_grainSize = 1;
+    std::atomic<int> m_nextIndex{0};
+    int m_activeWorkers = 0;
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+    std::exception_ptr m_exception;  // First exception thrown by the current job
+    std::deque<Job> m_jobs;          // Submitted background jobs, oldest first
+    
+    // Thread safety
+    std::mutex m_jobMutex;   // Serializes parallelFor callers
+    std::mutex m_mutex;      // Guards the job state above
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+};
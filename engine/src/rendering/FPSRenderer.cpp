@@ -46,6 +46,19 @@ void FPSRenderer::update(float deltaTime, int objectCount, int collisionChecks,
     updateMetrics(deltaTime, objectCount, collisionChecks, drawCalls, trianglesRendered, meshCacheSize, inertiaCacheSize, objectPoolAvailable, objectPoolReused);
 }
 
+void FPSRenderer::updateMeshCache(size_t memoryUsage, size_t memoryBudget, uint64_t hits, uint64_t misses, uint64_t evictions) {
+    m_metrics.meshCacheMemory = memoryUsage;
+    m_metrics.meshCacheBudget = memoryBudget;
+    m_metrics.meshCacheHits = hits;
+    m_metrics.meshCacheMisses = misses;
+    m_metrics.meshCacheEvictions = evictions;
+}
+
+void FPSRenderer::updateCollisionLayers(uint64_t acceptedOverlaps, uint64_t rejectedOverlaps) {
+    m_metrics.acceptedOverlaps = acceptedOverlaps;
+    m_metrics.rejectedOverlaps = rejectedOverlaps;
+}
+
 void FPSRenderer::render(const glm::mat4& view, const glm::mat4& projection) {
     if (!m_displayEnabled) return;
     
@@ -76,12 +89,14 @@ void FPSRenderer::render(const glm::mat4& view, const glm::mat4& projection) {
     glm::mat4 ortho = glm::ortho(0.0f, width, height, 0.0f, -1.0f, 1.0f);
     glUniformMatrix4fv(glGetUniformLocation(m_shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(ortho));
     
-    // Render background - smaller size for just FPS
-    float bgWidth = 120.0f * m_scale;
-    float bgHeight = 40.0f * m_scale;
+    // Render background - FPS and draw calls, plus mesh cache and collision layer lines once they have data
+    bool showMeshCache = m_metrics.meshCacheHits + m_metrics.meshCacheMisses > 0;
+    bool showLayers = m_metrics.acceptedOverlaps + m_metrics.rejectedOverlaps > 0;
+    int lineCount = 2 + (showMeshCache ? 2 : 0) + (showLayers ? 1 : 0);
+    float bgWidth = (showMeshCache || showLayers ? 200.0f : 120.0f) * m_scale;
+    float bgHeight = (16.0f + 24.0f * lineCount) * m_scale;
     renderBackground(m_position.x, m_position.y, bgWidth, bgHeight, glm::vec3(0.1f, 0.1f, 0.1f)); // Dark background
     
-    // Render only FPS
     float xOffset = m_position.x + 15.0f * m_scale;
     float yOffset = m_position.y + 15.0f * m_scale;
     
@@ -89,6 +104,28 @@ void FPSRenderer::render(const glm::mat4& view, const glm::mat4& projection) {
     glm::vec3 fpsColor = getPerformanceColor(m_displayedFPS);
     renderText("FPS: " + std::to_string(static_cast<int>(m_displayedFPS)), xOffset, yOffset, fpsColor);
     
+    // Draw calls issued last frame
+    glm::vec3 textColor(0.8f, 0.8f, 0.8f);
+    renderText("DRAW: " + std::to_string(m_metrics.drawCalls), xOffset, yOffset + 24.0f * m_scale, textColor);
+    
+    if (showMeshCache) {
+        // GPU bytes against the budget, then hits/misses/evictions
+        const float megabyte = 1024.0f * 1024.0f;
+        renderText("MESH: " + formatNumber(m_metrics.meshCacheMemory / megabyte) + "/" +
+                   formatNumber(m_metrics.meshCacheBudget / megabyte, 0) + " MB",
+                   xOffset, yOffset + 48.0f * m_scale, textColor);
+        renderText("H/M/E: " + std::to_string(m_metrics.meshCacheHits) + "/" + std::to_string(m_metrics.meshCacheMisses) +
+                   "/" + std::to_string(m_metrics.meshCacheEvictions),
+                   xOffset, yOffset + 72.0f * m_scale, textColor);
+    }
+    
+    if (showLayers) {
+        // Broadphase overlaps the layer matrix accepted/rejected
+        float lineY = yOffset + (showMeshCache ? 96.0f : 48.0f) * m_scale;
+        renderText("A/R: " + std::to_string(m_metrics.acceptedOverlaps) + "/" + std::to_string(m_metrics.rejectedOverlaps),
+                   xOffset, lineY, textColor);
+    }
+    
     // Restore OpenGL state
     if (depthTestEnabled) {
         glEnable(GL_DEPTH_TEST);
@@ -340,6 +377,70 @@ void FPSRenderer::renderChar(char c, float x, float y, const glm::vec3& color) {
             renderRect(x + charWidth - thickness, y + charHeight/2, thickness, charHeight/2); // right bottom
             renderRect(x, y + charHeight - thickness, charWidth, thickness); // bottom
             break;
+        case 'M':
+            // M: left, right, top, center stem
+            renderRect(x, y, thickness, charHeight); // left
+            renderRect(x + charWidth - thickness, y, thickness, charHeight); // right
+            renderRect(x, y, charWidth, thickness); // top
+            renderRect(x + charWidth/2 - thickness/2, y, thickness, charHeight/2); // center
+            break;
+        case 'B':
+            // B: left, top, middle, bottom, right
+            renderRect(x, y, thickness, charHeight); // left
+            renderRect(x, y, charWidth*0.8f, thickness); // top
+            renderRect(x, y + charHeight/2, charWidth, thickness); // middle
+            renderRect(x, y + charHeight - thickness, charWidth, thickness); // bottom
+            renderRect(x + charWidth*0.8f - thickness, y, thickness, charHeight/2); // right top
+            renderRect(x + charWidth - thickness, y + charHeight/2, thickness, charHeight/2); // right bottom
+            break;
+        case 'H':
+            // H: left, right, middle
+            renderRect(x, y, thickness, charHeight); // left
+            renderRect(x + charWidth - thickness, y, thickness, charHeight); // right
+            renderRect(x, y + charHeight/2, charWidth, thickness); // middle
+            break;
+        case 'E':
+            // E: left, top, middle, bottom
+            renderRect(x, y, thickness, charHeight); // left
+            renderRect(x, y, charWidth, thickness); // top
+            renderRect(x, y + charHeight/2, charWidth*0.6f, thickness); // middle
+            renderRect(x, y + charHeight - thickness, charWidth, thickness); // bottom
+            break;
+        case 'D':
+            // D: left, top, bottom, right
+            renderRect(x, y, thickness, charHeight); // left
+            renderRect(x, y, charWidth*0.8f, thickness); // top
+            renderRect(x, y + charHeight - thickness, charWidth*0.8f, thickness); // bottom
+            renderRect(x + charWidth - thickness, y + thickness, thickness, charHeight - 2*thickness); // right
+            break;
+        case 'R':
+            // R: like P plus a right leg
+            renderRect(x, y, thickness, charHeight); // left
+            renderRect(x, y, charWidth*0.6f, thickness); // top
+            renderRect(x + charWidth*0.6f, y, thickness, charHeight/2 + thickness); // right top
+            renderRect(x, y + charHeight/2, charWidth*0.6f, thickness); // middle
+            renderRect(x + charWidth*0.8f, y + charHeight/2, thickness, charHeight/2); // leg
+            break;
+        case 'A':
+            // A: left, right, top, middle
+            renderRect(x, y, thickness, charHeight); // left
+            renderRect(x + charWidth - thickness, y, thickness, charHeight); // right
+            renderRect(x, y, charWidth, thickness); // top
+            renderRect(x, y + charHeight/2, charWidth, thickness); // middle
+            break;
+        case 'W':
+            // W: left, right, bottom, center stem
+            renderRect(x, y, thickness, charHeight); // left
+            renderRect(x + charWidth - thickness, y, thickness, charHeight); // right
+            renderRect(x, y + charHeight - thickness, charWidth, thickness); // bottom
+            renderRect(x + charWidth/2 - thickness/2, y + charHeight/2, thickness, charHeight/2); // center
+            break;
+        case '/':
+            // Slash: steps from bottom left to top right
+            for (int i = 0; i < 5; i++) {
+                renderRect(x + i * charWidth / 5, y + charHeight - (i + 1) * charHeight / 5, thickness, charHeight / 5);
+            }
+            break;
         case ':':
             // Colon: two dots
             renderRect(x + charWidth/2 - thickness/2, y + charHeight/3, thickness, thickness);
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <glm/glm.hpp>
@@ -21,6 +22,12 @@ public:
     // Update performance metrics (call every frame)
     void update(float deltaTime, int objectCount, int collisionChecks, int drawCalls = 0, int trianglesRendered = 0, size_t meshCacheSize = 0, size_t inertiaCacheSize = 0, size_t objectPoolAvailable = 0, size_t objectPoolReused = 0);
     
+    // Update mesh cache metrics (GPU bytes and lookup counters)
+    void updateMeshCache(size_t memoryUsage, size_t memoryBudget, uint64_t hits, uint64_t misses, uint64_t evictions);
+    
+    // Update collision layer metrics (broadphase overlaps accepted/rejected by the layer matrix)
+    void updateCollisionLayers(uint64_t acceptedOverlaps, uint64_t rejectedOverlaps);
+    
     // Render the performance display
     void render(const glm::mat4& view, const glm::mat4& projection);
     
@@ -64,6 +71,15 @@ private:
                // Cache metrics
                size_t meshCacheSize = 0;
                size_t inertiaCacheSize = 0;
+               size_t meshCacheMemory = 0;
+               size_t meshCacheBudget = 0;
+               uint64_t meshCacheHits = 0;
+               uint64_t meshCacheMisses = 0;
+               uint64_t meshCacheEvictions = 0;
+               
+               // Collision layer metrics
+               uint64_t acceptedOverlaps = 0;
+               uint64_t rejectedOverlaps = 0;
                
                // Object pool metrics
                size_t objectPoolAvailable = 0;
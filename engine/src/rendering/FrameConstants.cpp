@@ -0,0 +1,74 @@
+#include "FrameConstants.h"
+#include <glad/glad.h>
+
+const char* const FrameConstants::BLOCK_NAME = "FrameConstants";
+
+const char* const FrameConstants::GLSL_BLOCK = R"(
+layout (std140) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 cameraPosition;
+    vec4 lightPosition;
+    vec4 lightDirection;
+    vec4 lightColor;
+};
+)";
+
+FrameConstants& FrameConstants::getInstance() {
+    static FrameConstants instance;
+    return instance;
+}
+
+bool FrameConstants::initialize() {
+    if (m_buffer) {
+        return true;
+    }
+    
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameConstantsData), &m_data, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    
+    // The binding point is global state: bound once, every program reads from it
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_POINT, m_buffer);
+    return m_buffer != 0;
+}
+
+void FrameConstants::update(const FrameConstantsData& data) {
+    m_data = data;
+    if (!m_buffer) {
+        return;
+    }
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameConstantsData), &m_data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+std::string FrameConstants::withBlock(const std::string& source) {
+    size_t version = source.find("#version");
+    if (version == std::string::npos) {
+        return GLSL_BLOCK + source;
+    }
+    
+    size_t lineEnd = source.find('\n', version);
+    if (lineEnd == std::string::npos) {
+        return source + "\n" + GLSL_BLOCK;
+    }
+    return source.substr(0, lineEnd + 1) + GLSL_BLOCK + source.substr(lineEnd + 1);
+}
+
+void FrameConstants::bindProgram(GLuint program) {
+    GLuint blockIndex = glGetUniformBlockIndex(program, BLOCK_NAME);
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, blockIndex, BINDING_POINT);
+    }
+}
+
+void FrameConstants::cleanup() {
+    if (m_buffer) {
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <glm/glm.hpp>
+
+// Forward declare OpenGL types
+typedef unsigned int GLuint;
+
+// std140 layout of the FrameConstants uniform block (see FrameConstants::GLSL_BLOCK)
+struct FrameConstantsData {
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::mat4(1.0f);
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    glm::vec4 cameraPosition = glm::vec4(0.0f);   // xyz, w unused
+    glm::vec4 lightPosition = glm::vec4(0.0f);    // Point light for scene objects, w unused
+    glm::vec4 lightDirection = glm::vec4(0.0f);   // Sun direction for terrain and foliage, w unused
+    glm::vec4 lightColor = glm::vec4(1.0f);       // rgb, w unused
+};
+
+static_assert(sizeof(FrameConstantsData) == 256, "FrameConstantsData must match the std140 block layout");
+
+// Per-frame camera and light data in one uniform buffer shared by every shader program
+//
+// The scene fills it once per frame with update(); shader sources get the block with
+// withBlock() and are attached to the buffer's binding point when linked (Shader does
+// this automatically, raw programs call bindProgram()).
+class FrameConstants {
+public:
+    static constexpr GLuint BINDING_POINT = 0;
+    static const char* const BLOCK_NAME;
+    static const char* const GLSL_BLOCK;
+    
+    // Singleton pattern
+    static FrameConstants& getInstance();
+    
+    // Create the buffer and bind it to BINDING_POINT (GL thread, safe to call again)
+    bool initialize();
+    
+    // Upload this frame's values
+    void update(const FrameConstantsData& data);
+    const FrameConstantsData& getData() const { return m_data; }
+    
+    // Insert GLSL_BLOCK after the #version line of a shader source
+    static std::string withBlock(const std::string& source);
+    
+    // Attach a linked program's FrameConstants block, if it has one, to BINDING_POINT
+    static void bindProgram(GLuint program);
+    
+    // Release the buffer (before the GL context goes away)
+    void cleanup();
+
+private:
+    FrameConstants() = default;
+    ~FrameConstants() = default;
+    
+    // Disable copy constructor and assignment operator
+    FrameConstants(const FrameConstants&) = delete;
+    FrameConstants& operator=(const FrameConstants&) = delete;
+    
+    FrameConstantsData m_data;
+    GLuint m_buffer = 0;
+};
@@ -0,0 +1,314 @@
+#include "FrustumCuller.h"
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FRUSTUM_CULLER_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_CULLER_SSE 1
+#endif
+
+namespace {
+    constexpr size_t LANES = 8;
+    
+    // Append the lanes set in mask without branching on them: every lane is stored,
+    // but the write position only advances for visible ones
+    inline size_t appendVisible(uint32_t* out, size_t count, uint32_t base, unsigned int mask) {
+        for (uint32_t lane = 0; lane < LANES; ++lane) {
+            out[count] = base + lane;
+            count += (mask >> lane) & 1u;
+        }
+        return count;
+    }
+    
+    inline float planeDistance(const glm::vec4& plane, float x, float y, float z) {
+        return plane.x * x + plane.y * y + plane.z * z + plane.w;
+    }
+    
+    // Written as !(d >= -r) to match the ordered SIMD compares: NaN bounds are culled
+    bool sphereVisible(const Frustum& frustum, float x, float y, float z, float radius) {
+        for (const glm::vec4& plane : frustum.planes) {
+            if (!(planeDistance(plane, x, y, z) >= -radius)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Box projected onto the plane normal gives the radius of the box along it. The SIMD
+    // paths below evaluate the same expressions in the same order, so results match unless
+    // the compiler contracts the scalar ones into FMAs (e.g. GCC with -march=native), which
+    // can flip objects that touch a plane to within rounding.
+    bool aabbVisible(const Frustum& frustum, float cx, float cy, float cz, float ex, float ey, float ez) {
+        for (const glm::vec4& plane : frustum.planes) {
+            float radius = std::abs(plane.x) * ex + std::abs(plane.y) * ey + std::abs(plane.z) * ez;
+            if (!(planeDistance(plane, cx, cy, cz) >= -radius)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+#if defined(FRUSTUM_CULLER_AVX)
+    unsigned int sphereMask8(const Frustum& frustum, const SphereBounds& bounds, size_t i) {
+        __m256 x = _mm256_loadu_ps(&bounds.centerX[i]);
+        __m256 y = _mm256_loadu_ps(&bounds.centerY[i]);
+        __m256 z = _mm256_loadu_ps(&bounds.centerZ[i]);
+        __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&bounds.radius[i]));
+    
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const glm::vec4& plane : frustum.planes) {
+            __m256 d = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(plane.x)), _mm256_mul_ps(y, _mm256_set1_ps(plane.y)));
+            d = _mm256_add_ps(_mm256_add_ps(d, _mm256_mul_ps(z, _mm256_set1_ps(plane.z))), _mm256_set1_ps(plane.w));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, negRadius, _CMP_GE_OQ));
+        }
+        return static_cast<unsigned int>(_mm256_movemask_ps(inside));
+    }
+    
+    unsigned int aabbMask8(const Frustum& frustum, const AABBBounds& bounds, size_t i) {
+        __m256 cx = _mm256_loadu_ps(&bounds.centerX[i]);
+        __m256 cy = _mm256_loadu_ps(&bounds.centerY[i]);
+        __m256 cz = _mm256_loadu_ps(&bounds.centerZ[i]);
+        __m256 ex = _mm256_loadu_ps(&bounds.extentX[i]);
+        __m256 ey = _mm256_loadu_ps(&bounds.extentY[i]);
+        __m256 ez = _mm256_loadu_ps(&bounds.extentZ[i]);
+    
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const glm::vec4& plane : frustum.planes) {
+            __m256 d = _mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(plane.x)), _mm256_mul_ps(cy, _mm256_set1_ps(plane.y)));
+            d = _mm256_add_ps(_mm256_add_ps(d, _mm256_mul_ps(cz, _mm256_set1_ps(plane.z))), _mm256_set1_ps(plane.w));
+            __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(std::abs(plane.x))),
+                                                   _mm256_mul_ps(ey, _mm256_set1_ps(std::abs(plane.y)))),
+                                     _mm256_mul_ps(ez, _mm256_set1_ps(std::abs(plane.z))));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, _mm256_sub_ps(_mm256_setzero_ps(), r), _CMP_GE_OQ));
+        }
+        return static_cast<unsigned int>(_mm256_movemask_ps(inside));
+    }
+#elif defined(FRUSTUM_CULLER_SSE)
+    unsigned int sphereMask4(const Frustum& frustum, const SphereBounds& bounds, size_t i) {
+        __m128 x = _mm_loadu_ps(&bounds.centerX[i]);
+        __m128 y = _mm_loadu_ps(&bounds.centerY[i]);
+        __m128 z = _mm_loadu_ps(&bounds.centerZ[i]);
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&bounds.radius[i]));
+    
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4& plane : frustum.planes) {
+            __m128 d = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            d = _mm_add_ps(_mm_add_ps(d, _mm_mul_ps(z, _mm_set1_ps(plane.z))), _mm_set1_ps(plane.w));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negRadius));
+        }
+        return static_cast<unsigned int>(_mm_movemask_ps(inside));
+    }
+    
+    unsigned int aabbMask4(const Frustum& frustum, const AABBBounds& bounds, size_t i) {
+        __m128 cx = _mm_loadu_ps(&bounds.centerX[i]);
+        __m128 cy = _mm_loadu_ps(&bounds.centerY[i]);
+        __m128 cz = _mm_loadu_ps(&bounds.centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&bounds.extentX[i]);
+        __m128 ey = _mm_loadu_ps(&bounds.extentY[i]);
+        __m128 ez = _mm_loadu_ps(&bounds.extentZ[i]);
+    
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4& plane : frustum.planes) {
+            __m128 d = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.x)), _mm_mul_ps(cy, _mm_set1_ps(plane.y)));
+            d = _mm_add_ps(_mm_add_ps(d, _mm_mul_ps(cz, _mm_set1_ps(plane.z))), _mm_set1_ps(plane.w));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(std::abs(plane.x))),
+                                             _mm_mul_ps(ey, _mm_set1_ps(std::abs(plane.y)))),
+                                  _mm_mul_ps(ez, _mm_set1_ps(std::abs(plane.z))));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, _mm_sub_ps(_mm_setzero_ps(), r)));
+        }
+        return static_cast<unsigned int>(_mm_movemask_ps(inside));
+    }
+    
+    unsigned int sphereMask8(const Frustum& frustum, const SphereBounds& bounds, size_t i) {
+        return sphereMask4(frustum, bounds, i) | (sphereMask4(frustum, bounds, i + 4) << 4);
+    }
+    
+    unsigned int aabbMask8(const Frustum& frustum, const AABBBounds& bounds, size_t i) {
+        return aabbMask4(frustum, bounds, i) | (aabbMask4(frustum, bounds, i + 4) << 4);
+    }
+#else
+    unsigned int sphereMask8(const Frustum& frustum, const SphereBounds& bounds, size_t i) {
+        unsigned int mask = 0;
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            size_t j = i + lane;
+            mask |= static_cast<unsigned int>(sphereVisible(frustum, bounds.centerX[j], bounds.centerY[j],
+                                                            bounds.centerZ[j], bounds.radius[j])) << lane;
+        }
+        return mask;
+    }
+    
+    unsigned int aabbMask8(const Frustum& frustum, const AABBBounds& bounds, size_t i) {
+        unsigned int mask = 0;
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            size_t j = i + lane;
+            mask |= static_cast<unsigned int>(aabbVisible(frustum, bounds.centerX[j], bounds.centerY[j], bounds.centerZ[j],
+                                                          bounds.extentX[j], bounds.extentY[j], bounds.extentZ[j])) << lane;
+        }
+        return mask;
+    }
+#endif
+}
+
+Frustum Frustum::fromMatrix(const glm::mat4& viewProjection) {
+    // GLM is column-major: row r of the matrix is (m[0][r], m[1][r], m[2][r], m[3][r])
+    const glm::mat4& m = viewProjection;
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+    
+    Frustum frustum;
+    frustum.planes[Left] = row3 + row0;
+    frustum.planes[Right] = row3 - row0;
+    frustum.planes[Bottom] = row3 + row1;
+    frustum.planes[Top] = row3 - row1;
+    frustum.planes[Near] = row3 + row2;
+    frustum.planes[Far] = row3 - row2;
+    
+    // Unit normals make plane distances metric, which the sphere test relies on
+    for (glm::vec4& plane : frustum.planes) {
+        float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+    return frustum;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const {
+    return sphereVisible(*this, center.x, center.y, center.z, radius);
+}
+
+bool Frustum::intersectsAABB(const glm::vec3& min, const glm::vec3& max) const {
+    glm::vec3 center = (min + max) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+    return aabbVisible(*this, center.x, center.y, center.z, extent.x, extent.y, extent.z);
+}
+
+void SphereBounds::clear() {
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    radius.clear();
+}
+
+void SphereBounds::reserve(size_t count) {
+    centerX.reserve(count);
+    centerY.reserve(count);
+    centerZ.reserve(count);
+    radius.reserve(count);
+}
+
+void SphereBounds::add(const glm::vec3& center, float r) {
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    radius.push_back(r);
+}
+
+void AABBBounds::clear() {
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    extentX.clear();
+    extentY.clear();
+    extentZ.clear();
+}
+
+void AABBBounds::reserve(size_t count) {
+    centerX.reserve(count);
+    centerY.reserve(count);
+    centerZ.reserve(count);
+    extentX.reserve(count);
+    extentY.reserve(count);
+    extentZ.reserve(count);
+}
+
+void AABBBounds::add(const glm::vec3& min, const glm::vec3& max) {
+    glm::vec3 center = (min + max) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    extentX.push_back(extent.x);
+    extentY.push_back(extent.y);
+    extentZ.push_back(extent.z);
+}
+
+size_t FrustumCuller::cullSpheres(const Frustum& frustum, const SphereBounds& bounds, std::vector<uint32_t>& visible) {
+    size_t count = bounds.size();
+    
+    // Room for the unconditional stores of appendVisible
+    visible.resize(count + LANES);
+    uint32_t* out = visible.data();
+    size_t visibleCount = 0;
+    
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        visibleCount = appendVisible(out, visibleCount, static_cast<uint32_t>(i), sphereMask8(frustum, bounds, i));
+    }
+    for (; i < count; ++i) {
+        if (sphereVisible(frustum, bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i], bounds.radius[i])) {
+            out[visibleCount++] = static_cast<uint32_t>(i);
+        }
+    }
+    
+    visible.resize(visibleCount);
+    return visibleCount;
+}
+
+size_t FrustumCuller::cullAABBs(const Frustum& frustum, const AABBBounds& bounds, std::vector<uint32_t>& visible) {
+    size_t count = bounds.size();
+    
+    // Room for the unconditional stores of appendVisible
+    visible.resize(count + LANES);
+    uint32_t* out = visible.data();
+    size_t visibleCount = 0;
+    
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        visibleCount = appendVisible(out, visibleCount, static_cast<uint32_t>(i), aabbMask8(frustum, bounds, i));
+    }
+    for (; i < count; ++i) {
+        if (aabbVisible(frustum, bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i],
+                        bounds.extentX[i], bounds.extentY[i], bounds.extentZ[i])) {
+            out[visibleCount++] = static_cast<uint32_t>(i);
+        }
+    }
+    
+    visible.resize(visibleCount);
+    return visibleCount;
+}
+
+size_t FrustumCuller::cullSpheresScalar(const Frustum& frustum, const SphereBounds& bounds, std::vector<uint32_t>& visible) {
+    visible.clear();
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (sphereVisible(frustum, bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i], bounds.radius[i])) {
+            visible.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return visible.size();
+}
+
+size_t FrustumCuller::cullAABBsScalar(const Frustum& frustum, const AABBBounds& bounds, std::vector<uint32_t>& visible) {
+    visible.clear();
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (aabbVisible(frustum, bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i],
+                        bounds.extentX[i], bounds.extentY[i], bounds.extentZ[i])) {
+            visible.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return visible.size();
+}
+
+const char* FrustumCuller::getSimdPath() {
+#if defined(FRUSTUM_CULLER_AVX)
+    return "AVX";
+#elif defined(FRUSTUM_CULLER_SSE)
+    return "SSE";
+#else
+    return "scalar";
+#endif
+}
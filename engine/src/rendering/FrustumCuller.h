@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// View frustum as six normalized planes (xyz normal pointing inside, w distance)
+//
+// Plain math on the camera matrices, so culling runs and can be checked without a GL context.
+struct Frustum {
+    enum Side { Left, Right, Bottom, Top, Near, Far };
+    
+    glm::vec4 planes[6];
+    
+    // Extract the planes of a view-projection matrix (Gribb/Hartmann, OpenGL clip space)
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+    static Frustum fromCamera(const glm::mat4& view, const glm::mat4& projection) {
+        return fromMatrix(projection * view);
+    }
+    
+    // Conservative tests: true unless the volume lies fully outside one plane
+    bool intersectsSphere(const glm::vec3& center, float radius) const;
+    bool intersectsAABB(const glm::vec3& min, const glm::vec3& max) const;
+};
+
+// Bounding spheres in structure-of-arrays layout, 8 lanes loaded per test
+struct SphereBounds {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> radius;
+    
+    size_t size() const { return radius.size(); }
+    void clear();
+    void reserve(size_t count);
+    void add(const glm::vec3& center, float r);
+};
+
+// Axis-aligned boxes in structure-of-arrays layout, stored as center and half extents
+struct AABBBounds {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> extentX;
+    std::vector<float> extentY;
+    std::vector<float> extentZ;
+    
+    size_t size() const { return extentX.size(); }
+    void clear();
+    void reserve(size_t count);
+    void add(const glm::vec3& min, const glm::vec3& max);
+};
+
+// Frustum culling over SoA bounds
+//
+// cullSpheres()/cullAABBs() test 8 objects per iteration (AVX when the build enables it,
+// two SSE halves otherwise, scalar on other targets) and write the indices of the
+// visible objects, in ascending order, to a compact list. The *Scalar variants are the
+// per-object reference and return the same lists, except for objects touching a plane
+// when FMA contraction rounds the scalar path differently. Objects with NaN bounds are
+// culled by both.
+class FrustumCuller {
+public:
+    // Returns the number of visible objects; visible is resized to match
+    static size_t cullSpheres(const Frustum& frustum, const SphereBounds& bounds, std::vector<uint32_t>& visible);
+    static size_t cullAABBs(const Frustum& frustum, const AABBBounds& bounds, std::vector<uint32_t>& visible);
+    
+    static size_t cullSpheresScalar(const Frustum& frustum, const SphereBounds& bounds, std::vector<uint32_t>& visible);
+    static size_t cullAABBsScalar(const Frustum& frustum, const AABBBounds& bounds, std::vector<uint32_t>& visible);
+    
+    // Instruction set the SIMD path was compiled for ("AVX", "SSE" or "scalar")
+    static const char* getSimdPath();
+};
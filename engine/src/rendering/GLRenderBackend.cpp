@@ -0,0 +1,54 @@
+#include "GLRenderBackend.h"
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+
+void GLRenderBackend::setPass(RenderPass pass) {
+    switch (pass) {
+        case RenderPass::Background:
+            glEnable(GL_DEPTH_TEST);
+            glDepthMask(GL_FALSE);
+            glDisable(GL_BLEND);
+            break;
+        case RenderPass::Opaque:
+            glEnable(GL_DEPTH_TEST);
+            glDepthMask(GL_TRUE);
+            glDisable(GL_BLEND);
+            break;
+        case RenderPass::Transparent:
+            glEnable(GL_DEPTH_TEST);
+            glDepthMask(GL_FALSE);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case RenderPass::Overlay:
+            glDisable(GL_DEPTH_TEST);
+            glDepthMask(GL_FALSE);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+    }
+}
+
+void GLRenderBackend::bindProgram(GLuint program) {
+    glUseProgram(program);
+}
+
+void GLRenderBackend::bindVertexArray(GLuint vertexArray) {
+    glBindVertexArray(vertexArray);
+}
+
+void GLRenderBackend::setUniform(GLint location, const glm::mat4& value) {
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void GLRenderBackend::setUniform(GLint location, const glm::vec3& value) {
+    glUniform3fv(location, 1, glm::value_ptr(value));
+}
+
+void GLRenderBackend::drawArrays(size_t first, size_t count) {
+    glDrawArrays(GL_TRIANGLES, static_cast<GLint>(first), static_cast<GLsizei>(count));
+}
+
+void GLRenderBackend::drawElements(GLenum indexType, size_t count, size_t byteOffset) {
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count), indexType, reinterpret_cast<const void*>(byteOffset));
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "RenderBackend.h"
+
+// RenderBackend that issues the calls to the current OpenGL context
+class GLRenderBackend : public RenderBackend {
+public:
+    void setPass(RenderPass pass) override;
+    void bindProgram(GLuint program) override;
+    void bindVertexArray(GLuint vertexArray) override;
+    void setUniform(GLint location, const glm::mat4& value) override;
+    void setUniform(GLint location, const glm::vec3& value) override;
+    void drawArrays(size_t first, size_t count) override;
+    void drawElements(GLenum indexType, size_t count, size_t byteOffset) override;
+};
@@ -1,5 +1,6 @@
 #include "GrassRenderer.h"
 #include "Terrain.h"
+#include "FrameConstants.h"
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -62,20 +63,11 @@ void GrassRenderer::generateGrass(const Terrain& terrain, int grassCount) {
     }
 }
 
-void GrassRenderer::render(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDir) {
+void GrassRenderer::render() {
     if (m_instances.empty()) return;
     
     glUseProgram(m_shaderProgram);
     
-    // Set matrices
-    glUniformMatrix4fv(glGetUniformLocation(m_shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(m_shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    
-    // Set lighting
-    glUniform3fv(glGetUniformLocation(m_shaderProgram, "lightDir"), 1, glm::value_ptr(lightDir));
-    glUniform3f(glGetUniformLocation(m_shaderProgram, "lightColor"), 1.0f, 1.0f, 0.9f);
-    glUniform3f(glGetUniformLocation(m_shaderProgram, "ambientColor"), 0.2f, 0.3f, 0.2f);
-    
     // Bind VAO
     glBindVertexArray(m_VAO);
     
@@ -155,7 +147,7 @@ void GrassRenderer::createGrassBlade() {
 }
 
 bool GrassRenderer::createShader() {
-    const char* vertexShaderSource = R"(
+    const std::string vertexShaderSource = FrameConstants::withBlock(R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aInstancePos;
@@ -163,10 +155,6 @@ layout (location = 2) in float aInstanceScale;
 layout (location = 3) in float aInstanceRot;
 layout (location = 4) in vec3 aInstanceColor;
 
-uniform mat4 view;
-uniform mat4 projection;
-uniform vec3 lightDir;
-uniform vec3 lightColor;
 uniform vec3 ambientColor;
 
 out vec3 fragColor;
@@ -186,15 +174,15 @@ void main() {
     
     // Simple lighting
     vec3 normal = vec3(0.0, 1.0, 0.0); // Grass blades point up
-    float diff = max(dot(normal, normalize(-lightDir)), 0.0);
-    vec3 diffuse = diff * lightColor;
+    float diff = max(dot(normal, normalize(-lightDirection.xyz)), 0.0);
+    vec3 diffuse = diff * lightColor.rgb;
     vec3 ambient = ambientColor;
     
     fragColor = aInstanceColor * (ambient + diffuse);
     
     gl_Position = projection * view * vec4(worldPos, 1.0);
 }
-)";
+)");
 
     const char* fragmentShaderSource = R"(
 #version 330 core
@@ -208,7 +196,8 @@ void main() {
 
     // Compile vertex shader
     GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
+    const char* vertexSource = vertexShaderSource.c_str();
+    glShaderSource(vertexShader, 1, &vertexSource, nullptr);
     glCompileShader(vertexShader);
     
     GLint success;
@@ -247,6 +236,11 @@ void main() {
         return false;
     }
     
+    // Camera and sun come from the FrameConstants block; ambient is fixed per program
+    FrameConstants::bindProgram(m_shaderProgram);
+    glUseProgram(m_shaderProgram);
+    glUniform3f(glGetUniformLocation(m_shaderProgram, "ambientColor"), 0.2f, 0.3f, 0.2f);
+    
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
     
@@ -26,8 +26,8 @@ public:
     // Generate grass instances on terrain
     void generateGrass(const class Terrain& terrain, int grassCount = 10000);
     
-    // Render all grass instances
-    void render(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDir);
+    // Render all grass instances (camera and sun come from FrameConstants)
+    void render();
     
     // Clear grass instances
     void clear();
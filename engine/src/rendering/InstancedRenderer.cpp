@@ -0,0 +1,173 @@
+#include "InstancedRenderer.h"
+#include "Shader.h"
+#include "FrameConstants.h"
+#include <glad/glad.h>
+#include <iostream>
+
+InstancedRenderer::InstancedRenderer() : m_instanceVBO(0), m_instanceCapacity(0), m_drawCalls(0),
+                                         m_trianglesRendered(0), m_instanceCount(0) {}
+
+InstancedRenderer::~InstancedRenderer() {
+    cleanup();
+}
+
+bool InstancedRenderer::initialize() {
+    if (!createShader()) {
+        return false;
+    }
+    
+    glGenBuffers(1, &m_instanceVBO);
+    return true;
+}
+
+void InstancedRenderer::submit(const std::shared_ptr<Mesh>& mesh, const glm::mat4& model, const glm::vec3& color) {
+    if (!mesh || !mesh->isLoaded()) {
+        return;
+    }
+    
+    // A scene uses a handful of meshes, so a linear scan beats hashing
+    Batch* target = nullptr;
+    Batch* unused = nullptr;
+    for (Batch& batch : m_batches) {
+        if (batch.mesh == mesh) {
+            target = &batch;
+            break;
+        }
+        if (!batch.mesh && !unused) {
+            unused = &batch;
+        }
+    }
+    if (!target) {
+        if (!unused) {
+            m_batches.emplace_back();
+            unused = &m_batches.back();
+        }
+        target = unused;
+        target->mesh = mesh;
+    }
+    
+    Mesh::Instance instance;
+    instance.model = model;
+    instance.color = color;
+    target->instances.push_back(instance);
+}
+
+void InstancedRenderer::flush() {
+    m_drawCalls = 0;
+    m_trianglesRendered = 0;
+    m_instanceCount = 0;
+    
+    for (const Batch& batch : m_batches) {
+        m_instanceCount += batch.instances.size();
+    }
+    if (m_instanceCount == 0) {
+        return;
+    }
+    if (!m_instanceVBO || !m_shader) {
+        std::cerr << "InstancedRenderer::flush: Renderer not initialized!" << std::endl;
+        m_instanceCount = 0;
+        m_batches.clear();
+        return;
+    }
+    
+    // Orphan the buffer so the driver never stalls on last frame's draws; grow it in
+    // powers of two so steady scenes stop reallocating
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+    if (m_instanceCount > m_instanceCapacity) {
+        m_instanceCapacity = 64;
+        while (m_instanceCapacity < m_instanceCount) {
+            m_instanceCapacity *= 2;
+        }
+    }
+    glBufferData(GL_ARRAY_BUFFER, m_instanceCapacity * sizeof(Mesh::Instance), nullptr, GL_STREAM_DRAW);
+    
+    size_t offset = 0;
+    for (const Batch& batch : m_batches) {
+        if (batch.instances.empty()) {
+            continue;
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(Mesh::Instance),
+                        batch.instances.size() * sizeof(Mesh::Instance), batch.instances.data());
+        offset += batch.instances.size();
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    m_shader->use();
+    
+    // One draw per mesh; release the meshes so the cache can evict them
+    offset = 0;
+    for (Batch& batch : m_batches) {
+        if (!batch.instances.empty()) {
+            batch.mesh->drawInstanced(m_instanceVBO, offset, batch.instances.size());
+            offset += batch.instances.size();
+            m_drawCalls++;
+            m_trianglesRendered += batch.mesh->getTriangleCount() * batch.instances.size();
+        }
+        batch.mesh.reset();
+        batch.instances.clear();
+    }
+}
+
+bool InstancedRenderer::createShader() {
+    // Same lighting as the scene shader, with the model matrix and color per instance
+    const char* vertexShaderSource = R"(
+        #version 330 core
+        layout (location = 0) in vec3 aPos;
+        layout (location = 1) in vec3 aNormal;
+        layout (location = 2) in mat4 aModel;
+        layout (location = 6) in vec3 aColor;
+        
+        out vec3 FragPos;
+        out vec3 Normal;
+        out vec3 Color;
+        
+        void main() {
+            FragPos = vec3(aModel * vec4(aPos, 1.0));
+            Normal = mat3(transpose(inverse(aModel))) * aNormal;
+            Color = aColor;
+            
+            gl_Position = projection * view * vec4(FragPos, 1.0);
+        }
+    )";
+    
+    const char* fragmentShaderSource = R"(
+        #version 330 core
+        out vec4 FragColor;
+        
+        in vec3 FragPos;
+        in vec3 Normal;
+        in vec3 Color;
+        
+        void main() {
+            // Ambient lighting
+            float ambient = 0.5;
+            
+            // Diffuse lighting
+            vec3 norm = normalize(Normal);
+            vec3 lightDir = normalize(lightPosition.xyz - FragPos);
+            float diff = max(dot(norm, lightDir), 0.0);
+            
+            vec3 result = (ambient + diff) * lightColor.rgb * Color;
+            FragColor = vec4(result, 1.0);
+        }
+    )";
+    
+    m_shader = std::make_unique<Shader>();
+    if (!m_shader->loadFromSource(FrameConstants::withBlock(vertexShaderSource),
+                                  FrameConstants::withBlock(fragmentShaderSource))) {
+        std::cerr << "InstancedRenderer::createShader: Failed to load instanced shader!" << std::endl;
+        m_shader.reset();
+        return false;
+    }
+    return true;
+}
+
+void InstancedRenderer::cleanup() {
+    if (m_instanceVBO) {
+        glDeleteBuffers(1, &m_instanceVBO);
+        m_instanceVBO = 0;
+    }
+    m_instanceCapacity = 0;
+    m_batches.clear();
+    m_shader.reset();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Mesh.h"
+
+class Shader;
+
+// Draws many copies of shared meshes with one glDrawElementsInstanced per mesh
+//
+// Queue objects with submit() during the frame; flush() streams every model matrix
+// and color into one instance buffer (orphaned each frame) and issues one instanced
+// draw per mesh.
+class InstancedRenderer {
+public:
+    InstancedRenderer();
+    ~InstancedRenderer();
+    
+    // Initialize shader and instance buffer
+    bool initialize();
+    
+    // Queue one copy of a mesh
+    void submit(const std::shared_ptr<Mesh>& mesh, const glm::mat4& model, const glm::vec3& color);
+    
+    // Draw everything queued since the last flush and clear the queue; camera and light
+    // come from FrameConstants
+    void flush();
+    
+    // Statistics of the last flush
+    size_t getDrawCalls() const { return m_drawCalls; }
+    size_t getTrianglesRendered() const { return m_trianglesRendered; }
+    size_t getInstanceCount() const { return m_instanceCount; }
+
+private:
+    // Queued instances of one mesh; emptied batches keep their capacity for the next frame
+    struct Batch {
+        std::shared_ptr<Mesh> mesh;
+        std::vector<Mesh::Instance> instances;
+    };
+    
+    std::vector<Batch> m_batches;
+    std::unique_ptr<Shader> m_shader;
+    
+    // OpenGL objects
+    GLuint m_instanceVBO;
+    size_t m_instanceCapacity;  // Instances the buffer has storage for
+    
+    // Statistics
+    size_t m_drawCalls;
+    size_t m_trianglesRendered;
+    size_t m_instanceCount;
+    
+    bool createShader();
+    void cleanup();
+};
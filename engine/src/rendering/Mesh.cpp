@@ -1,8 +1,11 @@
 #include "Mesh.h"
 #include <glad/glad.h>
+#include <cstddef>
 #include <iostream>
 
-Mesh::Mesh() : m_VAO(0), m_VBO(0), m_EBO(0), m_vertexCount(0), m_indexCount(0), m_hasIndices(false) {}
+Mesh::Mesh() : m_VAO(0), m_VBO(0), m_EBO(0), m_vertexCount(0), m_indexCount(0), m_hasIndices(false),
+               m_indexType(GL_UNSIGNED_INT), m_indexSize(sizeof(unsigned int)), m_gpuMemoryUsage(0),
+               m_positionTransform(1.0f) {}
 
 Mesh::~Mesh() {
     cleanup();
@@ -20,6 +23,7 @@ void Mesh::loadVertices(const std::vector<float>& vertices) {
     glBindVertexArray(m_VAO);
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    m_gpuMemoryUsage = vertices.size() * sizeof(float);
     
     // Position attribute (location 0)
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
@@ -34,6 +38,8 @@ void Mesh::loadVertices(const std::vector<float>& vertices, const std::vector<un
     m_vertexCount = vertices.size() / 3; // Assuming 3 components per vertex
     m_indexCount = indices.size();
     m_hasIndices = true;
+    m_indexType = GL_UNSIGNED_INT;
+    m_indexSize = sizeof(unsigned int);
     
     glGenVertexArrays(1, &m_VAO);
     glGenBuffers(1, &m_VBO);
@@ -46,6 +52,7 @@ void Mesh::loadVertices(const std::vector<float>& vertices, const std::vector<un
     
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    m_gpuMemoryUsage = vertices.size() * sizeof(float) + indices.size() * sizeof(unsigned int);
     
     // Position attribute (location 0)
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
@@ -54,16 +61,107 @@ void Mesh::loadVertices(const std::vector<float>& vertices, const std::vector<un
     glBindVertexArray(0);
 }
 
+void Mesh::loadQuantized(const uint16_t* positions, size_t vertexCount, const void* indices, size_t indexCount,
+                         bool indices32, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    cleanup();
+    
+    m_vertexCount = vertexCount;
+    m_indexCount = indexCount;
+    m_hasIndices = true;
+    m_indexType = indices32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    m_indexSize = indices32 ? sizeof(uint32_t) : sizeof(uint16_t);
+    
+    // Normalized attributes arrive in [0, 1]; scale and offset them back to the bounds.
+    // Flat axes quantize to 0, so any scale works there; 1 keeps the matrix invertible.
+    glm::vec3 extent = boundsMax - boundsMin;
+    extent = glm::vec3(extent.x > 0.0f ? extent.x : 1.0f, extent.y > 0.0f ? extent.y : 1.0f,
+                       extent.z > 0.0f ? extent.z : 1.0f);
+    m_positionTransform = glm::mat4(1.0f);
+    m_positionTransform[0][0] = extent.x;
+    m_positionTransform[1][1] = extent.y;
+    m_positionTransform[2][2] = extent.z;
+    m_positionTransform[3] = glm::vec4(boundsMin, 1.0f);
+    
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_EBO);
+    
+    glBindVertexArray(m_VAO);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * 4 * sizeof(uint16_t), positions, GL_STATIC_DRAW);
+    
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * m_indexSize, indices, GL_STATIC_DRAW);
+    m_gpuMemoryUsage = vertexCount * 4 * sizeof(uint16_t) + indexCount * m_indexSize;
+    
+    // Position attribute (location 0), normalized unsigned shorts
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, 4 * sizeof(uint16_t), (void*)0);
+    glEnableVertexAttribArray(0);
+    
+    glBindVertexArray(0);
+}
+
 void Mesh::draw() const {
+    if (!m_VAO) {
+        return;
+    }
+    
     glBindVertexArray(m_VAO);
     if (m_hasIndices) {
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indexCount), GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indexCount), m_indexType, 0);
     } else {
         glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertexCount));
     }
     glBindVertexArray(0);
 }
 
+void Mesh::drawRange(size_t first, size_t count) const {
+    if (!m_VAO) {
+        return;
+    }
+    
+    glBindVertexArray(m_VAO);
+    if (m_hasIndices) {
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count), m_indexType,
+                       reinterpret_cast<const void*>(first * m_indexSize));
+    } else {
+        glDrawArrays(GL_TRIANGLES, static_cast<GLint>(first), static_cast<GLsizei>(count));
+    }
+    glBindVertexArray(0);
+}
+
+void Mesh::drawInstanced(GLuint instanceBuffer, size_t firstInstance, size_t instanceCount) const {
+    if (!m_VAO || instanceCount == 0) {
+        return;
+    }
+    
+    glBindVertexArray(m_VAO);
+    
+    // Point the instance attributes at this range of the buffer; the divisor and enable
+    // flags are VAO state, so they persist between calls
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    size_t base = firstInstance * sizeof(Instance);
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                              reinterpret_cast<const void*>(base + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(2 + column);
+        glVertexAttribDivisor(2 + column, 1);
+    }
+    glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<const void*>(base + offsetof(Instance, color)));
+    glEnableVertexAttribArray(6);
+    glVertexAttribDivisor(6, 1);
+    
+    if (m_hasIndices) {
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(m_indexCount), m_indexType, 0,
+                                static_cast<GLsizei>(instanceCount));
+    } else {
+        glDrawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertexCount), static_cast<GLsizei>(instanceCount));
+    }
+    glBindVertexArray(0);
+}
+
 void Mesh::cleanup() {
     if (m_EBO) {
         glDeleteBuffers(1, &m_EBO);
@@ -79,5 +177,7 @@ void Mesh::cleanup() {
     }
     m_vertexCount = 0;
     m_indexCount = 0;
+    m_gpuMemoryUsage = 0;
+    m_positionTransform = glm::mat4(1.0f);
     m_hasIndices = false;
 }
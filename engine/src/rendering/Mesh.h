@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -9,6 +11,14 @@ typedef unsigned int GLuint;
 // Manages OpenGL mesh data (VAO, VBO, EBO)
 class Mesh {
 public:
+    // Per-instance attributes read by drawInstanced(): model matrix columns at
+    // locations 2-5, color at location 6
+    struct Instance {
+        glm::mat4 model;
+        glm::vec3 color;
+        float padding = 0.0f;
+    };
+    
     Mesh();
     ~Mesh();
     
@@ -16,12 +26,40 @@ public:
     void loadVertices(const std::vector<float>& vertices);
     void loadVertices(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
     
+    // Load 16-bit quantized positions (x, y, z, padding as fractions of the bounds) and
+    // 16- or 32-bit indices straight from caller memory, e.g. a mapped asset file
+    void loadQuantized(const uint16_t* positions, size_t vertexCount, const void* indices, size_t indexCount,
+                       bool indices32, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    
     // Render the mesh
     void draw() const;
     
+    // Render a range of vertices (non-indexed meshes) or indices (indexed meshes)
+    void drawRange(size_t first, size_t count) const;
+    
+    // Render instanceCount copies reading Instance records from instanceBuffer,
+    // starting firstInstance records into it
+    void drawInstanced(GLuint instanceBuffer, size_t firstInstance, size_t instanceCount) const;
+    
     // Get vertex count
     size_t getVertexCount() const { return m_vertexCount; }
     size_t getIndexCount() const { return m_indexCount; }
+    
+    // Draw state for render queue commands; the index type is 0 for non-indexed meshes
+    GLuint getVertexArray() const { return m_VAO; }
+    unsigned int getIndexType() const { return m_hasIndices ? m_indexType : 0; }
+    size_t getIndexSize() const { return m_hasIndices ? m_indexSize : 0; }
+    size_t getTriangleCount() const { return (m_hasIndices ? m_indexCount : m_vertexCount) / 3; }
+    
+    // Maps vertex positions to model space; identity unless the positions are quantized.
+    // Multiply it into the model matrix when drawing.
+    const glm::mat4& getPositionTransform() const { return m_positionTransform; }
+    
+    // Bytes uploaded to the vertex and index buffers
+    size_t getGpuMemoryUsage() const { return m_gpuMemoryUsage; }
+    
+    // False until vertices have been loaded
+    bool isLoaded() const { return m_VAO != 0; }
 
 private:
     GLuint m_VAO;
@@ -31,6 +69,10 @@ private:
     size_t m_vertexCount;
     size_t m_indexCount;
     bool m_hasIndices;
+    unsigned int m_indexType;
+    size_t m_indexSize;
+    size_t m_gpuMemoryUsage;
+    glm::mat4 m_positionTransform;
     
     void cleanup();
 };
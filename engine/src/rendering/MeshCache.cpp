@@ -1,116 +1,468 @@
 #include "MeshCache.h"
 #include "Mesh.h"
+#include "../core/ThreadPool.h"
+#include "../utils/ContentHash.h"
+#include "../utils/MeshAsset.h"
 #include "../utils/MeshGenerator.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 
-// Static key definitions are now constexpr in header
+struct MeshHandle::Entry {
+    MeshDesc desc;
+    std::string assetPath;                           // Source file, for meshes loaded from assets
+    std::shared_ptr<Mesh> mesh;
+    
+    // Background work, consumed by the upload: generated vertices or the mapped asset
+    std::future<std::vector<float>> vertices;
+    std::future<std::shared_ptr<MeshAsset>> asset;
+    
+    bool isWorkDone() const {
+        const auto zero = std::chrono::seconds(0);
+        return vertices.valid() ? vertices.wait_for(zero) == std::future_status::ready
+                                : asset.wait_for(zero) == std::future_status::ready;
+    }
+    void waitForWork() const {
+        if (vertices.valid()) {
+            vertices.wait();
+        } else {
+            asset.wait();
+        }
+    }
+    
+    // Guarded by MeshCache::m_mutex
+    bool uploaded = false;
+    size_t memoryUsage = 0;
+    uint64_t lastUse = 0;
+};
+
+namespace {
+    // Run function on the shared thread pool; the future reports its result
+    template <typename Function>
+    auto RunInBackground(Function function) -> std::future<decltype(function())> {
+        using Result = decltype(function());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+        std::future<Result> result = task->get_future();
+        ThreadPool::getInstance().submit([task] { (*task)(); });
+        return result;
+    }
+}
+
+MeshDesc MeshDesc::sphere(float radius, unsigned int segments, unsigned int rings) {
+    MeshDesc desc;
+    desc.type = Type::Sphere;
+    desc.size = glm::vec3(radius, 0.0f, 0.0f);
+    desc.segments = segments;
+    desc.rings = rings;
+    return desc;
+}
+
+MeshDesc MeshDesc::box(const glm::vec3& size) {
+    MeshDesc desc;
+    desc.type = Type::Box;
+    desc.size = size;
+    return desc;
+}
+
+MeshDesc MeshDesc::cylinder(float radius, float height, unsigned int segments) {
+    MeshDesc desc;
+    desc.type = Type::Cylinder;
+    desc.size = glm::vec3(radius, height, 0.0f);
+    desc.segments = segments;
+    return desc;
+}
+
+MeshDesc MeshDesc::plane(float width, float depth, float elevation) {
+    MeshDesc desc;
+    desc.type = Type::Plane;
+    desc.size = glm::vec3(width, elevation, depth);
+    return desc;
+}
+
+size_t MeshDescHash::operator()(const MeshDesc& desc) const {
+    uint32_t words[6];
+    words[0] = static_cast<uint32_t>(desc.type);
+    std::memcpy(&words[1], &desc.size, sizeof(float) * 3);
+    words[4] = desc.segments;
+    words[5] = desc.rings;
+    
+    // FNV-1a over the fields
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (uint32_t word : words) {
+        hash = (hash ^ word) * 0x100000001B3ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+std::shared_ptr<Mesh> MeshHandle::getMesh() const {
+    return m_entry ? m_entry->mesh : nullptr;
+}
+
+bool MeshHandle::isReady() const {
+    return m_entry && m_entry->mesh->isLoaded();
+}
 
 MeshCache& MeshCache::getInstance() {
     static MeshCache instance;
     return instance;
 }
 
+MeshHandle MeshCache::getOrCreate(const MeshDesc& desc) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto it = m_generated.find(desc);
+    if (it != m_generated.end()) {
+        m_hits++;
+        it->second->lastUse = ++m_useClock;
+        return MeshHandle(it->second);
+    }
+    m_misses++;
+    
+    // The Mesh object exists right away so callers can hold on to it; its GL
+    // buffers are created by processUploads once the vertices are ready
+    auto entry = std::make_shared<MeshHandle::Entry>();
+    entry->desc = desc;
+    entry->mesh = std::make_shared<Mesh>();
+    entry->vertices = RunInBackground([desc] { return generateVertices(desc); });
+    entry->lastUse = ++m_useClock;
+    
+    m_generated.emplace(desc, entry);
+    m_pending.push_back(entry);
+    return MeshHandle(entry);
+}
+
+MeshHandle MeshCache::loadAsset(const std::string& sourcePath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto it = m_assets.find(sourcePath);
+    if (it != m_assets.end()) {
+        m_hits++;
+        it->second->lastUse = ++m_useClock;
+        return MeshHandle(it->second);
+    }
+    m_misses++;
+    
+    auto entry = std::make_shared<MeshHandle::Entry>();
+    entry->assetPath = sourcePath;
+    entry->mesh = std::make_shared<Mesh>();
+    std::string compiledPath = getCompiledPath(sourcePath);
+    entry->asset = RunInBackground([sourcePath, compiledPath] { return openAsset(sourcePath, compiledPath); });
+    entry->lastUse = ++m_useClock;
+    
+    m_assets.emplace(sourcePath, entry);
+    m_pending.push_back(entry);
+    return MeshHandle(entry);
+}
+
+void MeshCache::setAssetCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_assetDirectory = directory;
+}
+
+std::string MeshCache::getAssetCacheDirectory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_assetDirectory;
+}
+
+size_t MeshCache::processUploads(size_t maxUploads) {
+    struct Upload {
+        std::shared_ptr<MeshHandle::Entry> entry;
+        std::vector<float> vertices;
+        std::shared_ptr<MeshAsset> asset;
+        bool fromAsset = false;
+    };
+    
+    // Collect finished work under the lock, upload outside it
+    std::vector<Upload> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pending.begin();
+        while (it != m_pending.end() && ready.size() < maxUploads) {
+            MeshHandle::Entry& entry = **it;
+            if (!entry.isWorkDone()) {
+                ++it;
+                continue;
+            }
+            Upload upload;
+            upload.entry = *it;
+            upload.fromAsset = !entry.vertices.valid();
+            if (upload.fromAsset) {
+                upload.asset = entry.asset.get();
+            } else {
+                upload.vertices = entry.vertices.get();
+            }
+            ready.push_back(std::move(upload));
+            it = m_pending.erase(it);
+        }
+    }
+    
+    for (Upload& upload : ready) {
+        if (!upload.fromAsset) {
+            upload.entry->mesh->loadVertices(upload.vertices);
+            continue;
+        }
+        if (!upload.asset) {
+            continue;  // Failed to load; the mesh stays empty
+        }
+        
+        // Straight from the mapping; the file is unmapped once the upload is done
+        const MeshAssetHeader& header = upload.asset->getHeader();
+        upload.entry->mesh->loadQuantized(upload.asset->getVertexData(), header.vertexCount,
+                                          upload.asset->getIndexData(), header.indexCount,
+                                          (header.flags & MeshAssetHeader::INDEX_32BIT) != 0,
+                                          glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]),
+                                          glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]));
+        upload.asset.reset();
+    }
+    
+    // Account for the new buffers and drop what no longer fits; evicted meshes
+    // release their buffers when the victims go out of scope on this thread
+    std::vector<std::shared_ptr<Mesh>> victims;
+    size_t uploaded = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Upload& upload : ready) {
+            MeshHandle::Entry& entry = *upload.entry;
+            entry.uploaded = true;
+            entry.memoryUsage = entry.mesh->getGpuMemoryUsage();
+            // Entries dropped by clear() while generating are no longer accounted
+            if (isTracked(upload.entry)) {
+                m_memoryUsage += entry.memoryUsage;
+            }
+        }
+        
+        // Release our references first so the new meshes count as unreferenced
+        uploaded = ready.size();
+        ready.clear();
+        collectEvictions(victims);
+    }
+    return uploaded;
+}
+
+void MeshCache::finishUploads() {
+    std::vector<std::shared_ptr<MeshHandle::Entry>> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pending = m_pending;
+    }
+    
+    for (const auto& entry : pending) {
+        entry->waitForWork();
+    }
+    pending.clear();
+    processUploads();
+}
+
 std::shared_ptr<Mesh> MeshCache::getMesh(const std::string& key) {
     std::lock_guard<std::mutex> lock(m_mutex);
     
     auto it = m_cache.find(key);
     if (it != m_cache.end()) {
-        return it->second;
+        m_hits++;
+        it->second.lastUse = ++m_useClock;
+        return it->second.mesh;
     }
     
     // Mesh not found in cache
+    m_misses++;
     return nullptr;
 }
 
 void MeshCache::cacheMesh(const std::string& key, std::shared_ptr<Mesh> mesh) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_cache[key] = mesh;
+    CachedMesh& cached = m_cache[key];
+    m_memoryUsage -= cached.memoryUsage;
+    cached.memoryUsage = mesh ? mesh->getGpuMemoryUsage() : 0;
+    cached.lastUse = ++m_useClock;
+    cached.mesh = std::move(mesh);
+    m_memoryUsage += cached.memoryUsage;
 }
 
-void MeshCache::preloadCommonMeshes() {
+void MeshCache::setMemoryBudget(size_t bytes) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryBudget = bytes;
+}
+
+size_t MeshCache::getMemoryBudget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memoryBudget;
+}
+
+size_t MeshCache::evictToBudget() {
+    std::vector<std::shared_ptr<Mesh>> victims;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        collectEvictions(victims);
+    }
+    return victims.size();
+}
+
+void MeshCache::collectEvictions(std::vector<std::shared_ptr<Mesh>>& victims) {
+    if (m_memoryBudget == 0) {
+        return;
+    }
     
-    std::cout << "Preloading common meshes..." << std::endl;
-    
-    // Preload cube mesh
-    if (m_cache.find(CUBE_KEY) == m_cache.end()) {
-        auto cubeMesh = std::make_shared<Mesh>();
-        cubeMesh->loadVertices(MeshGenerator::generateCube());
-        m_cache[CUBE_KEY] = cubeMesh;
-        std::cout << "Cached cube mesh" << std::endl;
-    }
-    
-    // Preload sphere mesh
-    if (m_cache.find(SPHERE_KEY) == m_cache.end()) {
-        auto sphereMesh = std::make_shared<Mesh>();
-        sphereMesh->loadVertices(MeshGenerator::generateSphere(32, 16, 1.0f));
-        m_cache[SPHERE_KEY] = sphereMesh;
-        std::cout << "Cached sphere mesh (1.0f radius)" << std::endl;
-    }
-    
-    // Preload ground plane mesh
-    if (m_cache.find(GROUND_PLANE_KEY) == m_cache.end()) {
-        auto groundMesh = std::make_shared<Mesh>();
-        groundMesh->loadVertices(MeshGenerator::generateGroundPlane());
-        m_cache[GROUND_PLANE_KEY] = groundMesh;
-        std::cout << "Cached ground plane mesh" << std::endl;
-    }
-    
-    // Preload small sphere mesh (for performance test)
-    if (m_cache.find(SPHERE_SMALL_KEY) == m_cache.end()) {
-        auto smallSphereMesh = std::make_shared<Mesh>();
-        smallSphereMesh->loadVertices(MeshGenerator::generateSphere(32, 16, 0.3f));
-        m_cache[SPHERE_SMALL_KEY] = smallSphereMesh;
-        std::cout << "Cached small sphere mesh (0.3f radius)" << std::endl;
-    }
-    
-    // Preload small cube mesh (for performance test)
-    if (m_cache.find(CUBE_SMALL_KEY) == m_cache.end()) {
-        auto smallCubeMesh = std::make_shared<Mesh>();
-        // Generate a smaller cube by scaling the vertices
-        auto cubeVertices = MeshGenerator::generateCube();
-        for (size_t i = 0; i < cubeVertices.size(); i += 3) {
-            cubeVertices[i] *= 0.4f;     // x
-            cubeVertices[i + 1] *= 0.4f; // y
-            cubeVertices[i + 2] *= 0.4f; // z
+    while (m_memoryUsage > m_memoryBudget) {
+        // Oldest mesh held only by the cache: no handle and no outside Mesh reference
+        uint64_t oldestUse = UINT64_MAX;
+        auto oldestGenerated = m_generated.end();
+        auto oldestAsset = m_assets.end();
+        auto oldestCached = m_cache.end();
+        auto isEvictable = [](const std::shared_ptr<MeshHandle::Entry>& entry) {
+            return entry->uploaded && entry.use_count() == 1 && entry->mesh.use_count() == 1;
+        };
+        for (auto it = m_generated.begin(); it != m_generated.end(); ++it) {
+            if (it->second->lastUse < oldestUse && isEvictable(it->second)) {
+                oldestUse = it->second->lastUse;
+                oldestGenerated = it;
+            }
+        }
+        for (auto it = m_assets.begin(); it != m_assets.end(); ++it) {
+            if (it->second->lastUse < oldestUse && isEvictable(it->second)) {
+                oldestUse = it->second->lastUse;
+                oldestAsset = it;
+                oldestGenerated = m_generated.end();
+            }
         }
-        smallCubeMesh->loadVertices(cubeVertices);
-        m_cache[CUBE_SMALL_KEY] = smallCubeMesh;
-        std::cout << "Cached small cube mesh (0.4f scale)" << std::endl;
+        for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+            if (it->second.lastUse < oldestUse && it->second.mesh.use_count() == 1) {
+                oldestUse = it->second.lastUse;
+                oldestCached = it;
+                oldestGenerated = m_generated.end();
+                oldestAsset = m_assets.end();
+            }
+        }
+        
+        if (oldestCached != m_cache.end()) {
+            m_memoryUsage -= oldestCached->second.memoryUsage;
+            victims.push_back(std::move(oldestCached->second.mesh));
+            m_cache.erase(oldestCached);
+        } else if (oldestAsset != m_assets.end()) {
+            m_memoryUsage -= oldestAsset->second->memoryUsage;
+            victims.push_back(std::move(oldestAsset->second->mesh));
+            m_assets.erase(oldestAsset);
+        } else if (oldestGenerated != m_generated.end()) {
+            m_memoryUsage -= oldestGenerated->second->memoryUsage;
+            victims.push_back(std::move(oldestGenerated->second->mesh));
+            m_generated.erase(oldestGenerated);
+        } else {
+            // Everything left is in use
+            break;
+        }
+        m_evictions++;
     }
-    
-    std::cout << "Mesh cache preloading complete. Total cached meshes: " << m_cache.size() << std::endl;
 }
 
 void MeshCache::clear() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_cache.clear();
+    std::vector<std::shared_ptr<MeshHandle::Entry>> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pending.swap(m_pending);
+        m_generated.clear();
+        m_assets.clear();
+        m_cache.clear();
+        m_memoryUsage = 0;
+    }
+    
+    // Background tasks only touch their own future, so they can finish unlocked
+    for (const auto& entry : pending) {
+        entry->waitForWork();
+    }
     std::cout << "Mesh cache cleared" << std::endl;
 }
 
 size_t MeshCache::getCacheSize() const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    return m_cache.size();
+    return m_generated.size() + m_assets.size() + m_cache.size();
+}
+
+size_t MeshCache::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending.size();
 }
 
 size_t MeshCache::getMemoryUsage() const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    // Rough estimate: each mesh has vertices, assume average 1000 vertices * 3 floats * 4 bytes
-    return m_cache.size() * 1000 * 3 * 4;
+    return m_memoryUsage;
+}
+
+MeshCache::Statistics MeshCache::getStatistics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Statistics statistics;
+    statistics.cachedMeshes = m_generated.size() + m_assets.size() + m_cache.size();
+    statistics.pendingMeshes = m_pending.size();
+    statistics.memoryUsage = m_memoryUsage;
+    statistics.memoryBudget = m_memoryBudget;
+    statistics.hits = m_hits;
+    statistics.misses = m_misses;
+    statistics.evictions = m_evictions;
+    return statistics;
+}
+
+void MeshCache::resetStatistics() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+bool MeshCache::isTracked(const std::shared_ptr<MeshHandle::Entry>& entry) const {
+    if (entry->assetPath.empty()) {
+        auto it = m_generated.find(entry->desc);
+        return it != m_generated.end() && it->second == entry;
+    }
+    auto it = m_assets.find(entry->assetPath);
+    return it != m_assets.end() && it->second == entry;
 }
 
-std::string MeshCache::generateSphereKey(float radius, int longitudeSegments, int latitudeSegments) {
-    return "sphere_" + std::to_string(radius) + "_" + 
-           std::to_string(longitudeSegments) + "_" + 
-           std::to_string(latitudeSegments);
+std::string MeshCache::getCompiledPath(const std::string& sourcePath) const {
+    if (m_assetDirectory.empty()) {
+        return sourcePath + MeshAsset::EXTENSION;
+    }
+    
+    // Sources with the same file name in different folders get different compiled files
+    ContentHash hash;
+    hash.update(sourcePath.data(), sourcePath.size());
+    std::string name = std::filesystem::path(sourcePath).filename().string() + "_" + ContentHash::toHex(hash.finish());
+    return (std::filesystem::path(m_assetDirectory) / (name + MeshAsset::EXTENSION)).string();
 }
 
-std::string MeshCache::generateCubeKey(float size) {
-    return "cube_" + std::to_string(size);
+std::shared_ptr<MeshAsset> MeshCache::openAsset(const std::string& sourcePath, const std::string& compiledPath) {
+    // A missing source (stamp 0) accepts whatever was compiled, so builds can ship compiled files only
+    uint64_t stamp = MeshAsset::getSourceStamp(sourcePath);
+    auto asset = std::make_shared<MeshAsset>();
+    if (asset->open(compiledPath, stamp)) {
+        return asset;
+    }
+    if (stamp == 0) {
+        std::cerr << "MeshCache::loadAsset: " << sourcePath << " not found and no compiled asset!" << std::endl;
+        return nullptr;
+    }
+    
+    std::cout << "Compiling mesh asset " << sourcePath << " -> " << compiledPath << std::endl;
+    if (!MeshAsset::compileFile(sourcePath, compiledPath) || !asset->open(compiledPath, stamp)) {
+        std::cerr << "MeshCache::loadAsset: Failed to compile " << sourcePath << "!" << std::endl;
+        return nullptr;
+    }
+    return asset;
 }
 
-std::string MeshCache::generateBoxKey(float width, float height, float depth) {
-    return "box_" + std::to_string(width) + "_" + 
-           std::to_string(height) + "_" + 
-           std::to_string(depth);
+std::vector<float> MeshCache::generateVertices(const MeshDesc& desc) {
+    switch (desc.type) {
+        case MeshDesc::Type::Sphere:
+            return MeshGenerator::generateSphere(desc.segments, desc.rings, desc.size.x);
+        case MeshDesc::Type::Box:
+            return MeshGenerator::generateBox(desc.size.x, desc.size.y, desc.size.z);
+        case MeshDesc::Type::Cylinder:
+            return MeshGenerator::generateCylinder(desc.segments, desc.size.x, desc.size.y);
+        case MeshDesc::Type::Plane: {
+            std::vector<float> vertices = MeshGenerator::generatePlane(desc.size.x, desc.size.z);
+            for (size_t i = 1; i < vertices.size(); i += 3) {
+                vertices[i] = desc.size.y;
+            }
+            return vertices;
+        }
+    }
+    return {};
 }
@@ -1,42 +1,133 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <unordered_map>
 #include <string>
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <glm/glm.hpp>
 
-// Forward declaration
+// Forward declarations
 class Mesh;
+class MeshAsset;
+
+// Parameters of a generated mesh
+struct MeshDesc {
+    enum class Type : uint8_t {
+        Sphere,
+        Box,
+        Cylinder,
+        Plane
+    };
+    
+    Type type = Type::Box;
+    glm::vec3 size = glm::vec3(1.0f);  // Sphere: (radius, -, -), Box: extents, Cylinder: (radius, height, -),
+                                       // Plane: (width, elevation, depth)
+    unsigned int segments = 0;         // Sphere and cylinder longitude segments
+    unsigned int rings = 0;            // Sphere latitude segments
+    
+    static MeshDesc sphere(float radius, unsigned int segments = 32, unsigned int rings = 16);
+    static MeshDesc box(const glm::vec3& size);
+    static MeshDesc cylinder(float radius, float height, unsigned int segments = 32);
+    static MeshDesc plane(float width, float depth, float elevation = 0.0f);
+    
+    bool operator==(const MeshDesc& other) const {
+        return type == other.type && size == other.size && segments == other.segments && rings == other.rings;
+    }
+};
+
+struct MeshDescHash {
+    size_t operator()(const MeshDesc& desc) const;
+};
+
+// Handle to a cached mesh whose vertices may still be generating
+//
+// getMesh() returns the same Mesh object before and after the upload; it draws
+// nothing until MeshCache::processUploads() has filled its buffers.
+class MeshHandle {
+public:
+    MeshHandle() = default;
+    
+    std::shared_ptr<Mesh> getMesh() const;
+    
+    // True once the vertices are uploaded to the GPU
+    bool isReady() const;
+    bool isValid() const { return m_entry != nullptr; }
+
+private:
+    friend class MeshCache;
+    struct Entry;
+    
+    explicit MeshHandle(std::shared_ptr<Entry> entry) : m_entry(std::move(entry)) {}
+    
+    std::shared_ptr<Entry> m_entry;
+};
 
 // Mesh cache for storing and reusing generated meshes
+//
+// getOrCreate() starts vertex generation on a worker thread and returns at once;
+// the render thread uploads finished meshes in batches with processUploads().
+// When the uploaded meshes exceed the memory budget, the least recently used
+// meshes that nobody outside the cache references are released.
 class MeshCache {
 public:
+    struct Statistics {
+        size_t cachedMeshes = 0;
+        size_t pendingMeshes = 0;
+        size_t memoryUsage = 0;     // Bytes in vertex and index buffers
+        size_t memoryBudget = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+    
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+    
     // Singleton pattern
     static MeshCache& getInstance();
     
-    // Get or create a cached mesh
-    std::shared_ptr<Mesh> getMesh(const std::string& key);
+    // Get a mesh by parameters, generating it asynchronously on the first request
+    MeshHandle getOrCreate(const MeshDesc& desc);
+    
+    // Get a mesh from an OBJ/PLY file. The compiled asset (see MeshAsset) is mapped on a
+    // worker thread, and (re)built first if it is missing or older than the source.
+    MeshHandle loadAsset(const std::string& sourcePath);
     
-    // Cache a mesh with a specific key
+    // Directory compiled assets are written to; empty (default) puts them next to the source
+    void setAssetCacheDirectory(const std::string& directory);
+    std::string getAssetCacheDirectory() const;
+    
+    // Upload meshes whose generation has finished, then evict down to the budget
+    // (GL thread only). Returns the number of meshes uploaded.
+    size_t processUploads(size_t maxUploads = SIZE_MAX);
+    
+    // Block until every requested mesh is generated and uploaded (GL thread only)
+    void finishUploads();
+    
+    // Get or cache a mesh built by the caller under a custom key
+    std::shared_ptr<Mesh> getMesh(const std::string& key);
     void cacheMesh(const std::string& key, std::shared_ptr<Mesh> mesh);
     
-    // Generate and cache common meshes
-    void preloadCommonMeshes();
+    // GPU memory budget in bytes, 0 for unlimited
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
     
-    // Clear all cached meshes
+    // Release unreferenced meshes, least recently used first, until usage fits the budget
+    // (GL thread only). Returns the number of meshes evicted.
+    size_t evictToBudget();
+    
+    // Clear all cached meshes (waits for generation in flight)
     void clear();
     
     // Get cache statistics
     size_t getCacheSize() const;
+    size_t getPendingCount() const;
     size_t getMemoryUsage() const;
-    
-    // Predefined mesh keys
-    static constexpr const char* CUBE_KEY = "cube_1.0";
-    static constexpr const char* SPHERE_KEY = "sphere_1.0_32_16";
-    static constexpr const char* GROUND_PLANE_KEY = "ground_plane_1x1";
-    static constexpr const char* SPHERE_SMALL_KEY = "sphere_0.3_32_16";
-    static constexpr const char* CUBE_SMALL_KEY = "cube_0.4";
+    Statistics getStatistics() const;
+    void resetStatistics();
 
 private:
     MeshCache() = default;
@@ -46,14 +137,39 @@ private:
     MeshCache(const MeshCache&) = delete;
     MeshCache& operator=(const MeshCache&) = delete;
     
+    // Caller-built mesh with its accounting
+    struct CachedMesh {
+        std::shared_ptr<Mesh> mesh;
+        size_t memoryUsage = 0;
+        uint64_t lastUse = 0;
+    };
+    
     // Cache storage
-    std::unordered_map<std::string, std::shared_ptr<Mesh>> m_cache;
+    std::unordered_map<MeshDesc, std::shared_ptr<MeshHandle::Entry>, MeshDescHash> m_generated;
+    std::unordered_map<std::string, std::shared_ptr<MeshHandle::Entry>> m_assets;  // By source path
+    std::unordered_map<std::string, CachedMesh> m_cache;
+    std::vector<std::shared_ptr<MeshHandle::Entry>> m_pending;  // Requested but not uploaded yet
+    std::string m_assetDirectory;
+    
+    // Memory accounting and LRU clock (ticks on every lookup)
+    size_t m_memoryUsage = 0;
+    size_t m_memoryBudget = DEFAULT_MEMORY_BUDGET;
+    uint64_t m_useClock = 0;
+    
+    // Statistics
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
     
     // Thread safety
     mutable std::mutex m_mutex;
     
-    // Helper methods
-    std::string generateSphereKey(float radius, int longitudeSegments, int latitudeSegments);
-    std::string generateCubeKey(float size);
-    std::string generateBoxKey(float width, float height, float depth);
+    // Remove victims from the maps; the caller destroys them outside the lock
+    void collectEvictions(std::vector<std::shared_ptr<Mesh>>& victims);
+    
+    bool isTracked(const std::shared_ptr<MeshHandle::Entry>& entry) const;
+    std::string getCompiledPath(const std::string& sourcePath) const;
+    
+    static std::shared_ptr<MeshAsset> openAsset(const std::string& sourcePath, const std::string& compiledPath);
+    static std::vector<float> generateVertices(const MeshDesc& desc);
 };
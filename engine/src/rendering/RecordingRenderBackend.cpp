@@ -0,0 +1,49 @@
+#include "RecordingRenderBackend.h"
+
+void RecordingRenderBackend::setPass(RenderPass pass) {
+    record(Call::SetPass, static_cast<size_t>(pass));
+}
+
+void RecordingRenderBackend::bindProgram(GLuint program) {
+    record(Call::BindProgram, program);
+}
+
+void RecordingRenderBackend::bindVertexArray(GLuint vertexArray) {
+    record(Call::BindVertexArray, vertexArray);
+}
+
+void RecordingRenderBackend::setUniform(GLint location, const glm::mat4& value) {
+    record(Call::SetUniformMat4, static_cast<size_t>(location), m_matrices.size());
+    m_matrices.push_back(value);
+}
+
+void RecordingRenderBackend::setUniform(GLint location, const glm::vec3& value) {
+    record(Call::SetUniformVec3, static_cast<size_t>(location), m_vectors.size());
+    m_vectors.push_back(value);
+}
+
+void RecordingRenderBackend::drawArrays(size_t first, size_t count) {
+    record(Call::DrawArrays, count, first);
+}
+
+void RecordingRenderBackend::drawElements(GLenum, size_t count, size_t byteOffset) {
+    record(Call::DrawElements, count, byteOffset);
+}
+
+size_t RecordingRenderBackend::getStateChanges() const {
+    return getCount(Call::SetPass) + getCount(Call::BindProgram) + getCount(Call::BindVertexArray);
+}
+
+void RecordingRenderBackend::reset() {
+    m_records.clear();
+    m_matrices.clear();
+    m_vectors.clear();
+    for (size_t& count : m_counts) {
+        count = 0;
+    }
+}
+
+void RecordingRenderBackend::record(Call call, size_t value, size_t argument) {
+    m_records.push_back({call, value, argument});
+    m_counts[static_cast<size_t>(call)]++;
+}
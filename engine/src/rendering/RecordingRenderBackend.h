@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include "RenderBackend.h"
+
+// RenderBackend that records every call instead of drawing
+//
+// Lets RenderQueue sorting and state filtering be checked, and state changes counted,
+// without a GPU or GL context.
+class RecordingRenderBackend : public RenderBackend {
+public:
+    enum class Call : uint8_t {
+        SetPass,
+        BindProgram,
+        BindVertexArray,
+        SetUniformMat4,
+        SetUniformVec3,
+        DrawArrays,
+        DrawElements
+    };
+    
+    // One recorded call. value is the pass, program, vertex array, uniform location or
+    // element count the call was made with; argument is the first vertex or byte offset
+    // of a draw, or the index of a uniform's value in getMatrices()/getVectors()
+    struct Record {
+        Call call;
+        size_t value;
+        size_t argument;
+    };
+    
+    void setPass(RenderPass pass) override;
+    void bindProgram(GLuint program) override;
+    void bindVertexArray(GLuint vertexArray) override;
+    void setUniform(GLint location, const glm::mat4& value) override;
+    void setUniform(GLint location, const glm::vec3& value) override;
+    void drawArrays(size_t first, size_t count) override;
+    void drawElements(GLenum indexType, size_t count, size_t byteOffset) override;
+    
+    const std::vector<Record>& getRecords() const { return m_records; }
+    const std::vector<glm::mat4>& getMatrices() const { return m_matrices; }
+    const std::vector<glm::vec3>& getVectors() const { return m_vectors; }
+    size_t getCount(Call call) const { return m_counts[static_cast<size_t>(call)]; }
+    
+    // Pass, program and vertex array changes
+    size_t getStateChanges() const;
+    size_t getDrawCalls() const { return getCount(Call::DrawArrays) + getCount(Call::DrawElements); }
+    
+    void reset();
+
+private:
+    std::vector<Record> m_records;
+    std::vector<glm::mat4> m_matrices;
+    std::vector<glm::vec3> m_vectors;
+    size_t m_counts[7] = {};
+    
+    void record(Call call, size_t value, size_t argument = 0);
+};
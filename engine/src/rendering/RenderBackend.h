@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Forward declare OpenGL types
+typedef unsigned int GLuint;
+typedef int GLint;
+typedef unsigned int GLenum;
+
+// Render passes in execution order; each pass sets its own depth and blend state
+enum class RenderPass : uint8_t {
+    Background,   // Depth test on, depth writes off
+    Opaque,       // Depth test and writes on, blending off (default GL state)
+    Transparent,  // Depth writes off, alpha blending, drawn back to front
+    Overlay       // Depth test off, alpha blending
+};
+
+// One draw packet: the state it needs plus its per-draw uniforms
+//
+// Commands only hold GL names, so the meshes and programs they refer to must stay
+// alive until the queue has executed.
+struct RenderCommand {
+    RenderPass pass = RenderPass::Opaque;
+    GLuint program = 0;
+    GLuint vertexArray = 0;
+    
+    // glDrawArrays when indexType is 0, glDrawElements otherwise; first counts vertices
+    // or indices
+    GLenum indexType = 0;
+    uint32_t indexSize = 0;
+    size_t first = 0;
+    size_t count = 0;
+    
+    // Per-draw uniforms, skipped when the location is -1
+    GLint modelLocation = -1;
+    GLint colorLocation = -1;
+    glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color = glm::vec3(1.0f);
+};
+
+// State and draw calls a RenderQueue executes against
+//
+// GLRenderBackend issues them to OpenGL; RecordingRenderBackend only records them so
+// sorting and state filtering can be checked without a GL context.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+    
+    virtual void setPass(RenderPass pass) = 0;
+    virtual void bindProgram(GLuint program) = 0;
+    virtual void bindVertexArray(GLuint vertexArray) = 0;
+    virtual void setUniform(GLint location, const glm::mat4& value) = 0;
+    virtual void setUniform(GLint location, const glm::vec3& value) = 0;
+    virtual void drawArrays(size_t first, size_t count) = 0;
+    virtual void drawElements(GLenum indexType, size_t count, size_t byteOffset) = 0;
+};
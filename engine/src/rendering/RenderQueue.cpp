@@ -0,0 +1,220 @@
+#include "RenderQueue.h"
+#include "Mesh.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+constexpr int PASS_SHIFT = 62;
+constexpr uint64_t PROGRAM_MASK = 0xFFF;
+constexpr uint64_t VERTEX_ARRAY_MASK = 0xFFFF;
+constexpr uint64_t DEPTH_MASK = 0xFFFFFF;
+
+// Below this many commands the radix sort's histogram passes cost more than a comparison sort
+constexpr size_t RADIX_SORT_THRESHOLD = 1024;
+
+// Top 24 bits of the float; non-negative floats order the same as their bit patterns
+uint64_t quantizeDepth(float depth) {
+    if (!(depth > 0.0f)) {
+        return 0;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return (bits >> 7) & DEPTH_MASK;
+}
+
+} // namespace
+
+uint64_t RenderQueue::makeSortKey(RenderPass pass, GLuint program, GLuint vertexArray, float depth) {
+    uint64_t key = static_cast<uint64_t>(pass) << PASS_SHIFT;
+    uint64_t programBits = program & PROGRAM_MASK;
+    uint64_t vertexArrayBits = vertexArray & VERTEX_ARRAY_MASK;
+    uint64_t depthBits = quantizeDepth(depth);
+    
+    if (pass == RenderPass::Transparent) {
+        // Blending needs back to front, so depth outranks state
+        key |= (DEPTH_MASK - depthBits) << 38;
+        key |= programBits << 26;
+        key |= vertexArrayBits << 10;
+    } else {
+        // Front to back within each program and vertex array to help early depth rejection
+        key |= programBits << 50;
+        key |= vertexArrayBits << 34;
+        key |= depthBits << 10;
+    }
+    return key;
+}
+
+RenderCommand RenderQueue::makeMeshCommand(const Mesh& mesh, GLuint program, RenderPass pass) {
+    RenderCommand command;
+    command.pass = pass;
+    command.program = program;
+    command.vertexArray = mesh.getVertexArray();
+    command.indexType = mesh.getIndexType();
+    command.indexSize = static_cast<uint32_t>(mesh.getIndexSize());
+    command.count = command.indexType ? mesh.getIndexCount() : mesh.getVertexCount();
+    return command;
+}
+
+void RenderQueue::submit(const RenderCommand& command, float depth) {
+    Entry entry;
+    entry.key = makeSortKey(command.pass, command.program, command.vertexArray, depth);
+    entry.command = static_cast<uint32_t>(m_commands.size());
+    m_commands.push_back(command);
+    m_entries.push_back(entry);
+    m_sorted = false;
+}
+
+void RenderQueue::sort() {
+    if (m_sorted || !m_sortingEnabled) {
+        return;
+    }
+    m_sorted = true;
+    
+    const size_t count = m_entries.size();
+    if (count < 2) {
+        return;
+    }
+    if (count < RADIX_SORT_THRESHOLD) {
+        std::stable_sort(m_entries.begin(), m_entries.end(),
+                         [](const Entry& a, const Entry& b) { return a.key < b.key; });
+        return;
+    }
+    
+    // LSD radix sort, 8 bits per pass; one sweep builds all eight histograms
+    size_t histograms[8][256] = {};
+    for (const Entry& entry : m_entries) {
+        for (int byte = 0; byte < 8; ++byte) {
+            histograms[byte][(entry.key >> (byte * 8)) & 0xFF]++;
+        }
+    }
+    
+    m_scratch.resize(count);
+    Entry* source = m_entries.data();
+    Entry* destination = m_scratch.data();
+    for (int byte = 0; byte < 8; ++byte) {
+        size_t* histogram = histograms[byte];
+    
+        // Every key has the same byte here (e.g. the unused low bits): nothing to move
+        const int shift = byte * 8;
+        if (histogram[(source[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+    
+        size_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            size_t bucketSize = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketSize;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+    
+    if (source != m_entries.data()) {
+        m_entries.swap(m_scratch);
+    }
+}
+
+void RenderQueue::execute(RenderBackend& backend) {
+    sort();
+    
+    m_statistics = Statistics();
+    m_statistics.commands = m_commands.size();
+    
+    // Uniform values are per program, so the cached ones are forgotten on every bind
+    bool passSet = false;
+    RenderPass currentPass = RenderPass::Opaque;
+    GLuint currentProgram = 0;
+    GLuint currentVertexArray = 0;
+    bool modelSet = false;
+    bool colorSet = false;
+    GLint modelLocation = -1;
+    GLint colorLocation = -1;
+    glm::mat4 currentModel(1.0f);
+    glm::vec3 currentColor(0.0f);
+    
+    for (const Entry& entry : m_entries) {
+        const RenderCommand& command = m_commands[entry.command];
+        if (command.count == 0) {
+            continue;
+        }
+    
+        if (!passSet || command.pass != currentPass) {
+            backend.setPass(command.pass);
+            currentPass = command.pass;
+            passSet = true;
+            m_statistics.passChanges++;
+        } else {
+            m_statistics.redundantChangesSkipped++;
+        }
+    
+        if (command.program != currentProgram) {
+            backend.bindProgram(command.program);
+            currentProgram = command.program;
+            modelSet = false;
+            colorSet = false;
+            m_statistics.programBinds++;
+        } else {
+            m_statistics.redundantChangesSkipped++;
+        }
+    
+        if (command.vertexArray != currentVertexArray) {
+            backend.bindVertexArray(command.vertexArray);
+            currentVertexArray = command.vertexArray;
+            m_statistics.vertexArrayBinds++;
+        } else {
+            m_statistics.redundantChangesSkipped++;
+        }
+    
+        if (command.modelLocation != -1) {
+            if (!modelSet || command.modelLocation != modelLocation || command.model != currentModel) {
+                backend.setUniform(command.modelLocation, command.model);
+                modelLocation = command.modelLocation;
+                currentModel = command.model;
+                modelSet = true;
+                m_statistics.uniformUploads++;
+            } else {
+                m_statistics.redundantChangesSkipped++;
+            }
+        }
+        if (command.colorLocation != -1) {
+            if (!colorSet || command.colorLocation != colorLocation || command.color != currentColor) {
+                backend.setUniform(command.colorLocation, command.color);
+                colorLocation = command.colorLocation;
+                currentColor = command.color;
+                colorSet = true;
+                m_statistics.uniformUploads++;
+            } else {
+                m_statistics.redundantChangesSkipped++;
+            }
+        }
+    
+        if (command.indexType) {
+            backend.drawElements(command.indexType, command.count, command.first * command.indexSize);
+        } else {
+            backend.drawArrays(command.first, command.count);
+        }
+        m_statistics.drawCalls++;
+        m_statistics.trianglesRendered += command.count / 3;
+    }
+    
+    // Leave the default state for immediate-mode rendering that follows
+    if (currentVertexArray != 0) {
+        backend.bindVertexArray(0);
+    }
+    if (passSet && currentPass != RenderPass::Opaque) {
+        backend.setPass(RenderPass::Opaque);
+    }
+    
+    clear();
+}
+
+void RenderQueue::clear() {
+    m_commands.clear();
+    m_entries.clear();
+    m_sorted = true;
+}
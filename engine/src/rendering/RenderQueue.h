@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "RenderBackend.h"
+
+class Mesh;
+
+// Queue of draw packets executed in sort-key order
+//
+// Scene code submits commands during the frame; execute() radix-sorts them by a 64-bit
+// key and replays them on a backend, skipping pass, program, vertex array and uniform
+// changes that would not change anything. Commands with equal keys keep their
+// submission order.
+//
+// Key layout, most significant bits first:
+//   Background/Opaque/Overlay: pass (2) | program (12) | vertex array (16) | depth (24) | unused (10)
+//   Transparent:               pass (2) | inverted depth (24) | program (12) | vertex array (16) | unused (10)
+// Program and vertex array names are truncated to their fields; a collision only costs
+// extra state changes, never a wrong draw.
+class RenderQueue {
+public:
+    // Work done by the last execute()
+    struct Statistics {
+        size_t commands = 0;
+        size_t drawCalls = 0;
+        size_t trianglesRendered = 0;
+        size_t passChanges = 0;
+        size_t programBinds = 0;
+        size_t vertexArrayBinds = 0;
+        size_t uniformUploads = 0;
+        size_t redundantChangesSkipped = 0;  // State and uniform calls filtered out
+    };
+    
+    // Build the sort key of a command; depth is the distance from the camera
+    static uint64_t makeSortKey(RenderPass pass, GLuint program, GLuint vertexArray, float depth);
+    
+    // Command drawing all of a mesh with a program
+    static RenderCommand makeMeshCommand(const Mesh& mesh, GLuint program, RenderPass pass = RenderPass::Opaque);
+    
+    // Queue a command; depth orders draws within a pass and state group
+    void submit(const RenderCommand& command, float depth = 0.0f);
+    
+    // Sort the queued commands (execute() sorts on its own)
+    void sort();
+    
+    // Replay the queued commands on the backend, then clear the queue. State is left as
+    // the Opaque pass with no vertex array bound.
+    void execute(RenderBackend& backend);
+    
+    void clear();
+    
+    // Execute in submission order instead of key order (for comparisons and debugging)
+    void setSortingEnabled(bool enabled) { m_sortingEnabled = enabled; }
+    bool isSortingEnabled() const { return m_sortingEnabled; }
+    
+    size_t size() const { return m_commands.size(); }
+    bool empty() const { return m_commands.empty(); }
+    
+    // Queued commands in execution order; valid after sort() until the next submit()
+    uint64_t getSortedKey(size_t index) const { return m_entries[index].key; }
+    const RenderCommand& getSortedCommand(size_t index) const { return m_commands[m_entries[index].command]; }
+    
+    const Statistics& getStatistics() const { return m_statistics; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint32_t command;  // Index into m_commands
+    };
+    
+    std::vector<RenderCommand> m_commands;
+    std::vector<Entry> m_entries;
+    std::vector<Entry> m_scratch;  // Radix sort ping-pong buffer, kept between frames
+    bool m_sorted = true;
+    bool m_sortingEnabled = true;
+    Statistics m_statistics;
+};
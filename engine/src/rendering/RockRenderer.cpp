@@ -1,5 +1,6 @@
 #include "RockRenderer.h"
 #include "Terrain.h"
+#include "FrameConstants.h"
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -62,20 +63,11 @@ void RockRenderer::generateRocks(const Terrain& terrain, int rockCount) {
     }
 }
 
-void RockRenderer::render(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDir) {
+void RockRenderer::render() {
     if (m_instances.empty()) return;
     
     glUseProgram(m_shaderProgram);
     
-    // Set matrices
-    glUniformMatrix4fv(glGetUniformLocation(m_shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(m_shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    
-    // Set lighting
-    glUniform3fv(glGetUniformLocation(m_shaderProgram, "lightDir"), 1, glm::value_ptr(lightDir));
-    glUniform3f(glGetUniformLocation(m_shaderProgram, "lightColor"), 1.0f, 1.0f, 0.9f);
-    glUniform3f(glGetUniformLocation(m_shaderProgram, "ambientColor"), 0.2f, 0.2f, 0.2f);
-    
     // Bind VAO
     glBindVertexArray(m_VAO);
     
@@ -166,7 +158,7 @@ void RockRenderer::createRockGeometry() {
 }
 
 bool RockRenderer::createShader() {
-    const char* vertexShaderSource = R"(
+    const std::string vertexShaderSource = FrameConstants::withBlock(R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aInstancePos;
@@ -174,10 +166,6 @@ layout (location = 2) in float aInstanceScale;
 layout (location = 3) in float aInstanceRot;
 layout (location = 4) in vec3 aInstanceColor;
 
-uniform mat4 view;
-uniform mat4 projection;
-uniform vec3 lightDir;
-uniform vec3 lightColor;
 uniform vec3 ambientColor;
 
 out vec3 fragColor;
@@ -197,15 +185,15 @@ void main() {
     
     // Simple lighting
     vec3 normal = normalize(rotatedPos); // Approximate normal
-    float diff = max(dot(normal, normalize(-lightDir)), 0.0);
-    vec3 diffuse = diff * lightColor;
+    float diff = max(dot(normal, normalize(-lightDirection.xyz)), 0.0);
+    vec3 diffuse = diff * lightColor.rgb;
     vec3 ambient = ambientColor;
     
     fragColor = aInstanceColor * (ambient + diffuse);
     
     gl_Position = projection * view * vec4(worldPos, 1.0);
 }
-)";
+)");
 
     const char* fragmentShaderSource = R"(
 #version 330 core
@@ -219,7 +207,8 @@ void main() {
 
     // Compile vertex shader
     GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
+    const char* vertexSource = vertexShaderSource.c_str();
+    glShaderSource(vertexShader, 1, &vertexSource, nullptr);
     glCompileShader(vertexShader);
     
     GLint success;
@@ -258,6 +247,11 @@ void main() {
         return false;
     }
     
+    // Camera and sun come from the FrameConstants block; ambient is fixed per program
+    FrameConstants::bindProgram(m_shaderProgram);
+    glUseProgram(m_shaderProgram);
+    glUniform3f(glGetUniformLocation(m_shaderProgram, "ambientColor"), 0.2f, 0.2f, 0.2f);
+    
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
     
@@ -26,8 +26,8 @@ public:
     // Generate rock instances on terrain
     void generateRocks(const class Terrain& terrain, int rockCount = 500);
     
-    // Render all rock instances
-    void render(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDir);
+    // Render all rock instances (camera and sun come from FrameConstants)
+    void render();
     
     // Clear rock instances
     void clear();
@@ -1,4 +1,5 @@
 #include "Shader.h"
+#include "FrameConstants.h"
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
@@ -31,34 +32,57 @@ void Shader::use() const {
     glUseProgram(m_programID);
 }
 
-void Shader::setUniform(const std::string& name, const glm::mat4& value) const {
-    GLint location = glGetUniformLocation(m_programID, name.c_str());
-    if (location != -1) {
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name) const {
+    auto it = m_uniformLocations.find(name);
+    if (it == m_uniformLocations.end()) {
+        it = m_uniformLocations.emplace(name, glGetUniformLocation(m_programID, name.c_str())).first;
     }
+    
+    UniformHandle uniform;
+    uniform.location = it->second;
+    return uniform;
 }
 
-void Shader::setUniform(const std::string& name, const glm::vec3& value) const {
-    GLint location = glGetUniformLocation(m_programID, name.c_str());
-    if (location != -1) {
-        glUniform3fv(location, 1, glm::value_ptr(value));
+void Shader::setUniform(UniformHandle uniform, const glm::mat4& value) const {
+    if (uniform.isValid()) {
+        glUniformMatrix4fv(uniform.location, 1, GL_FALSE, glm::value_ptr(value));
     }
 }
 
-void Shader::setUniform(const std::string& name, float value) const {
-    GLint location = glGetUniformLocation(m_programID, name.c_str());
-    if (location != -1) {
-        glUniform1f(location, value);
+void Shader::setUniform(UniformHandle uniform, const glm::vec3& value) const {
+    if (uniform.isValid()) {
+        glUniform3fv(uniform.location, 1, glm::value_ptr(value));
     }
 }
 
-void Shader::setUniform(const std::string& name, int value) const {
-    GLint location = glGetUniformLocation(m_programID, name.c_str());
-    if (location != -1) {
-        glUniform1i(location, value);
+void Shader::setUniform(UniformHandle uniform, float value) const {
+    if (uniform.isValid()) {
+        glUniform1f(uniform.location, value);
     }
 }
 
+void Shader::setUniform(UniformHandle uniform, int value) const {
+    if (uniform.isValid()) {
+        glUniform1i(uniform.location, value);
+    }
+}
+
+void Shader::setUniform(const std::string& name, const glm::mat4& value) const {
+    setUniform(getUniformHandle(name), value);
+}
+
+void Shader::setUniform(const std::string& name, const glm::vec3& value) const {
+    setUniform(getUniformHandle(name), value);
+}
+
+void Shader::setUniform(const std::string& name, float value) const {
+    setUniform(getUniformHandle(name), value);
+}
+
+void Shader::setUniform(const std::string& name, int value) const {
+    setUniform(getUniformHandle(name), value);
+}
+
 bool Shader::compileShader(GLuint& shader, GLenum type, const std::string& source) {
     shader = glCreateShader(type);
     const char* src = source.c_str();
@@ -92,6 +116,8 @@ bool Shader::linkProgram() {
         return false;
     }
     
+    // Programs that declare the shared block read it from the per-frame buffer
+    FrameConstants::bindProgram(m_programID);
     return true;
 }
 
@@ -108,4 +134,5 @@ void Shader::cleanup() {
         glDeleteProgram(m_programID);
         m_programID = 0;
     }
+    m_uniformLocations.clear();
 }
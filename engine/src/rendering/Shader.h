@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <glm/glm.hpp>
 
 // Forward declare OpenGL types to avoid header conflicts
@@ -12,6 +13,13 @@ typedef unsigned int GLenum;
 // Manages OpenGL shader programs
 class Shader {
 public:
+    // Location of a uniform in this program, -1 if the program has no such uniform
+    struct UniformHandle {
+        GLint location = -1;
+        
+        bool isValid() const { return location != -1; }
+    };
+    
     Shader();
     ~Shader();
     
@@ -21,7 +29,16 @@ public:
     // Use this shader program
     void use() const;
     
-    // Set uniforms
+    // Look up a uniform once (cached per name); use the handle for per-draw values
+    UniformHandle getUniformHandle(const std::string& name) const;
+    
+    // Set uniforms by handle (no lookup)
+    void setUniform(UniformHandle uniform, const glm::mat4& value) const;
+    void setUniform(UniformHandle uniform, const glm::vec3& value) const;
+    void setUniform(UniformHandle uniform, float value) const;
+    void setUniform(UniformHandle uniform, int value) const;
+    
+    // Set uniforms by name (cached lookup)
     void setUniform(const std::string& name, const glm::mat4& value) const;
     void setUniform(const std::string& name, const glm::vec3& value) const;
     void setUniform(const std::string& name, float value) const;
@@ -35,6 +52,9 @@ private:
     GLuint m_vertexShader;
     GLuint m_fragmentShader;
     
+    // Uniform locations by name, filled on first lookup
+    mutable std::unordered_map<std::string, GLint> m_uniformLocations;
+    
     bool compileShader(GLuint& shader, GLenum type, const std::string& source);
     bool linkProgram();
     void cleanup();
@@ -1,4 +1,5 @@
 #include "Skybox.h"
+#include "FrameConstants.h"
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
@@ -18,35 +19,35 @@ bool Skybox::initialize() {
          1.0f, -1.0f, -1.0f,
          1.0f,  1.0f, -1.0f,
         -1.0f,  1.0f, -1.0f,
-
+    
         -1.0f, -1.0f,  1.0f,
         -1.0f, -1.0f, -1.0f,
         -1.0f,  1.0f, -1.0f,
         -1.0f,  1.0f, -1.0f,
         -1.0f,  1.0f,  1.0f,
         -1.0f, -1.0f,  1.0f,
-
+    
          1.0f, -1.0f, -1.0f,
          1.0f, -1.0f,  1.0f,
          1.0f,  1.0f,  1.0f,
          1.0f,  1.0f,  1.0f,
          1.0f,  1.0f, -1.0f,
          1.0f, -1.0f, -1.0f,
-
+    
         -1.0f, -1.0f,  1.0f,
         -1.0f,  1.0f,  1.0f,
          1.0f,  1.0f,  1.0f,
          1.0f,  1.0f,  1.0f,
          1.0f, -1.0f,  1.0f,
         -1.0f, -1.0f,  1.0f,
-
+    
         -1.0f,  1.0f, -1.0f,
          1.0f,  1.0f, -1.0f,
          1.0f,  1.0f,  1.0f,
          1.0f,  1.0f,  1.0f,
         -1.0f,  1.0f,  1.0f,
         -1.0f,  1.0f, -1.0f,
-
+    
         -1.0f, -1.0f, -1.0f,
         -1.0f, -1.0f,  1.0f,
          1.0f, -1.0f, -1.0f,
@@ -54,7 +55,7 @@ bool Skybox::initialize() {
         -1.0f, -1.0f,  1.0f,
          1.0f, -1.0f,  1.0f
     };
-
+    
     // Generate skybox colors (day preset)
     auto colors = generateDaySkyboxColors();
     
@@ -94,13 +95,8 @@ bool Skybox::initialize() {
     return true;
 }
 
-void Skybox::render(const glm::mat4& view, const glm::mat4& projection) {
-    // Remove translation from view matrix
-    glm::mat4 skyboxView = glm::mat4(glm::mat3(view));
-    
+void Skybox::render() {
     glUseProgram(m_shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(m_shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(skyboxView));
-    glUniformMatrix4fv(glGetUniformLocation(m_shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
     
     glBindVertexArray(m_VAO);
     glActiveTexture(GL_TEXTURE0);
@@ -128,18 +124,17 @@ std::vector<float> Skybox::generateDaySkyboxColors() {
 }
 
 bool Skybox::createShader() {
-    const char* vertexShaderSource = R"(
+    // Translation is removed from the view matrix so the sky stays centered on the camera
+    const std::string vertexShaderSource = FrameConstants::withBlock(R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
-uniform mat4 view;
-uniform mat4 projection;
 out vec3 TexCoords;
 void main() {
     TexCoords = aPos;
-    vec4 pos = projection * view * vec4(aPos, 1.0);
+    vec4 pos = projection * mat4(mat3(view)) * vec4(aPos, 1.0);
     gl_Position = pos.xyww;
 }
-)";
+)");
 
     const char* fragmentShaderSource = R"(
 #version 330 core
@@ -153,7 +148,8 @@ void main() {
 
     // Compile vertex shader
     GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
+    const char* vertexSource = vertexShaderSource.c_str();
+    glShaderSource(vertexShader, 1, &vertexSource, nullptr);
     glCompileShader(vertexShader);
     
     GLint success;
@@ -191,6 +187,7 @@ void main() {
         std::cerr << "Skybox shader program linking failed: " << infoLog << std::endl;
         return false;
     }
+    FrameConstants::bindProgram(m_shaderProgram);
     
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
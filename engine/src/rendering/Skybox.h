@@ -16,8 +16,8 @@ public:
     // Initialize skybox with day preset
     bool initialize();
     
-    // Render the skybox
-    void render(const glm::mat4& view, const glm::mat4& projection);
+    // Render the skybox (camera comes from FrameConstants)
+    void render();
     
     // Get skybox shader program ID
     GLuint getShaderProgram() const { return m_shaderProgram; }
@@ -1,10 +1,12 @@
 #include "Terrain.h"
+#include "FrameConstants.h"
 #include "../utils/TerrainGenerator.h"
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <iostream>
 
-Terrain::Terrain() : m_width(0), m_height(0), m_scale(0.1f) {}
+Terrain::Terrain() : m_width(0), m_height(0), m_scale(0.1f), m_minHeight(0.0f), m_maxHeight(0.0f) {}
 
 Terrain::~Terrain() = default;
 
@@ -23,6 +25,12 @@ bool Terrain::initialize(int width, int height, float scale, float heightScale,
         m_heightData[i / 3] = terrainData.vertices[i + 1]; // Y component
     }
     
+    if (!m_heightData.empty()) {
+        auto range = std::minmax_element(m_heightData.begin(), m_heightData.end());
+        m_minHeight = *range.first;
+        m_maxHeight = *range.second;
+    }
+    
     // Create mesh with vertices, normals, colors, and indices
     m_mesh = std::make_unique<Mesh>();
     
@@ -88,18 +96,9 @@ bool Terrain::initialize(int width, int height, float scale, float heightScale,
     return true;
 }
 
-void Terrain::render(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDir) {
+void Terrain::render(const glm::mat4& model) {
     m_shader->use();
-    
-    // Set matrices
-    m_shader->setUniform("model", model);
-    m_shader->setUniform("view", view);
-    m_shader->setUniform("projection", projection);
-    
-    // Set lighting
-    m_shader->setUniform("lightDir", lightDir);
-    m_shader->setUniform("lightColor", glm::vec3(1.0f, 1.0f, 0.9f));
-    m_shader->setUniform("ambientColor", glm::vec3(0.3f, 0.4f, 0.5f));
+    m_shader->setUniform(m_modelUniform, model);
     
     // Render terrain
     glBindVertexArray(m_terrainVAO);
@@ -107,6 +106,18 @@ void Terrain::render(const glm::mat4& model, const glm::mat4& view, const glm::m
     glBindVertexArray(0);
 }
 
+void Terrain::submit(RenderQueue& queue, const glm::mat4& model) const {
+    RenderCommand command;
+    command.program = m_shader->getProgramID();
+    command.vertexArray = m_terrainVAO;
+    command.indexType = GL_UNSIGNED_INT;
+    command.indexSize = sizeof(unsigned int);
+    command.count = m_indexCount;
+    command.modelLocation = m_modelUniform.location;
+    command.model = model;
+    queue.submit(command);
+}
+
 float Terrain::getHeightAt(float worldX, float worldZ) const {
     glm::ivec2 coords = worldToHeightmap(worldX, worldZ);
     
@@ -148,10 +159,6 @@ layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec3 aColor;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform vec3 lightDir;
-uniform vec3 lightColor;
 uniform vec3 ambientColor;
 
 out vec3 fragColor;
@@ -161,8 +168,8 @@ void main() {
     vec3 worldNormal = normalize(mat3(transpose(inverse(model))) * aNormal);
     
     // Simple lighting
-    float diff = max(dot(worldNormal, normalize(-lightDir)), 0.0);
-    vec3 diffuse = diff * lightColor;
+    float diff = max(dot(worldNormal, normalize(-lightDirection.xyz)), 0.0);
+    vec3 diffuse = diff * lightColor.rgb;
     vec3 ambient = ambientColor;
     
     fragColor = aColor * (ambient + diffuse);
@@ -182,5 +189,13 @@ void main() {
 )";
 
     m_shader = std::make_unique<Shader>();
-    return m_shader->loadFromSource(vertexShaderSource, fragmentShaderSource);
+    if (!m_shader->loadFromSource(FrameConstants::withBlock(vertexShaderSource), fragmentShaderSource)) {
+        return false;
+    }
+    
+    // Per-program constants are set once; camera and sun come from the FrameConstants block
+    m_modelUniform = m_shader->getUniformHandle("model");
+    m_shader->use();
+    m_shader->setUniform("ambientColor", glm::vec3(0.3f, 0.4f, 0.5f));
+    return true;
 }
@@ -2,8 +2,10 @@
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <vector>
 #include "Mesh.h"
 #include "Shader.h"
+#include "RenderQueue.h"
 
 // Forward declare OpenGL types
 typedef unsigned int GLuint;
@@ -17,18 +19,29 @@ public:
     // Initialize terrain with procedural generation
     bool initialize(int width = 256, int height = 256, float scale = 0.1f, float heightScale = 2.0f, float roughness = 1.0f);
     
-    // Render the terrain
-    void render(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDir);
+    // Render the terrain (camera and sun come from FrameConstants)
+    void render(const glm::mat4& model);
+    
+    // Queue the terrain draw instead of drawing immediately
+    void submit(RenderQueue& queue, const glm::mat4& model) const;
     
     // Get terrain height at world position
     float getHeightAt(float worldX, float worldZ) const;
     
     // Get terrain bounds
     glm::vec2 getBounds() const { return m_bounds; }
+    
+    // Height grid access for physics (heights[z * width + x], world spacing = grid scale)
+    const std::vector<float>& getHeightData() const { return m_heightData; }
+    int getGridWidth() const { return m_width; }
+    int getGridLength() const { return m_height; }
+    float getGridScale() const { return m_scale; }
+    glm::vec2 getHeightRange() const { return glm::vec2(m_minHeight, m_maxHeight); }
 
 private:
     std::unique_ptr<Mesh> m_mesh;
     std::unique_ptr<Shader> m_shader;
+    Shader::UniformHandle m_modelUniform;
     
     // Terrain data
     int m_width, m_height;
@@ -37,6 +50,7 @@ private:
     
     // Height data for collision
     std::vector<float> m_heightData;
+    float m_minHeight, m_maxHeight;
     
     // OpenGL objects for rendering
     GLuint m_terrainVAO, m_terrainVBO, m_terrainEBO;
@@ -1,6 +1,6 @@
 #include "Box.h"
 #include "../core/PhysicsConstants.h"
-#include "../core/InertiaTensorCache.h"
+#include "../core/ShapeGeometry.h"
 #include <algorithm>
 
 Box::Box(float width, float height, float depth) 
@@ -15,34 +15,18 @@ float Box::getVolume() const {
 glm::mat3 Box::getInertiaTensor(float mass) const {
     glm::vec3 scaled = m_dimensions * m_scale;
     
-    // Generate cache key
-    std::string key = InertiaTensorCache::generateBoxKey(scaled.x, scaled.y, scaled.z, mass);
-    
-    // Check cache first
-    auto& cache = InertiaTensorCache::getInstance();
-    glm::mat3 cached = cache.getInertiaTensor(key);
-    
-    // If not identity matrix, return cached result
-    if (cached != glm::mat3(1.0f)) {
-        return cached;
-    }
-    
+    // Closed form, cheaper than any cache lookup
     // Calculate inertia tensor for a box centered at origin
     float w = scaled.x, h = scaled.y, d = scaled.z;
     float Ixx = mass * (h * h + d * d) / 12.0f;
     float Iyy = mass * (w * w + d * d) / 12.0f;
     float Izz = mass * (w * w + h * h) / 12.0f;
     
-    glm::mat3 tensor(
+    return glm::mat3(
         Ixx, 0.0f, 0.0f,
         0.0f, Iyy, 0.0f,
         0.0f, 0.0f, Izz
     );
-    
-    // Cache the result
-    cache.cacheInertiaTensor(key, tensor);
-    
-    return tensor;
 }
 
 glm::vec3 Box::getBoundingBoxMin() const {
@@ -70,37 +54,22 @@ bool Box::containsPoint(const glm::vec3& point) const {
 
 void Box::setDimensions(const glm::vec3& dimensions) {
     m_dimensions = dimensions;
-    m_meshGenerated = false; // Regenerate mesh
+    m_geometry = nullptr; // Look up the geometry for the new parameters
 }
 
-const std::vector<float>& Box::getVertices() const {
-    if (!m_meshGenerated) {
-        generateMesh();
+const ShapeGeometry& Box::getGeometry() const {
+    if (!m_geometry) {
+        ShapeGeometryKey key;
+        key.type = ShapeType::Box;
+        key.parameters = m_dimensions;
+        m_geometry = ShapeGeometryRegistry::getInstance().getOrCreate(key,
+            [this](ShapeGeometry& geometry) { generateGeometry(geometry); });
     }
-    return m_vertices;
+    return *m_geometry;
 }
 
-const std::vector<float>& Box::getNormals() const {
-    if (!m_meshGenerated) {
-        generateMesh();
-    }
-    return m_normals;
-}
-
-const std::vector<unsigned int>& Box::getIndices() const {
-    if (!m_meshGenerated) {
-        generateMesh();
-    }
-    return m_indices;
-}
-
-void Box::generateMesh() const {
-    m_vertices.clear();
-    m_normals.clear();
-    m_indices.clear();
-    
-    glm::vec3 scaled = m_dimensions * m_scale;
-    float w = scaled.x * 0.5f, h = scaled.y * 0.5f, d = scaled.z * 0.5f;
+void Box::generateGeometry(ShapeGeometry& geometry) const {
+    float w = m_dimensions.x * 0.5f, h = m_dimensions.y * 0.5f, d = m_dimensions.z * 0.5f;
     
     // 8 vertices of the box
     std::vector<glm::vec3> positions = {
@@ -131,14 +100,14 @@ void Box::generateMesh() const {
             int posIndex = faces[face][vertex];
             
             // Add position
-            m_vertices.push_back(positions[posIndex].x);
-            m_vertices.push_back(positions[posIndex].y);
-            m_vertices.push_back(positions[posIndex].z);
+            geometry.vertices.push_back(positions[posIndex].x);
+            geometry.vertices.push_back(positions[posIndex].y);
+            geometry.vertices.push_back(positions[posIndex].z);
             
             // Add normal
-            m_normals.push_back(normals[face].x);
-            m_normals.push_back(normals[face].y);
-            m_normals.push_back(normals[face].z);
+            geometry.normals.push_back(normals[face].x);
+            geometry.normals.push_back(normals[face].y);
+            geometry.normals.push_back(normals[face].z);
         }
     }
     
@@ -147,15 +116,13 @@ void Box::generateMesh() const {
         int baseIndex = face * 4;
         
         // First triangle
-        m_indices.push_back(baseIndex);
-        m_indices.push_back(baseIndex + 1);
-        m_indices.push_back(baseIndex + 2);
+        geometry.indices.push_back(baseIndex);
+        geometry.indices.push_back(baseIndex + 1);
+        geometry.indices.push_back(baseIndex + 2);
         
         // Second triangle
-        m_indices.push_back(baseIndex);
-        m_indices.push_back(baseIndex + 2);
-        m_indices.push_back(baseIndex + 3);
+        geometry.indices.push_back(baseIndex);
+        geometry.indices.push_back(baseIndex + 2);
+        geometry.indices.push_back(baseIndex + 3);
     }
-    
-    m_meshGenerated = true;
 }
@@ -1,5 +1,6 @@
 #include "Cylinder.h"
 #include "../core/PhysicsConstants.h"
+#include "../core/ShapeGeometry.h"
 #include <cmath>
 
 Cylinder::Cylinder(float radius, float height, int segments) 
@@ -56,73 +57,58 @@ bool Cylinder::containsPoint(const glm::vec3& point) const {
 
 void Cylinder::setRadius(float radius) {
     m_radius = radius;
-    m_meshGenerated = false; // Regenerate mesh
+    m_geometry = nullptr; // Look up the geometry for the new parameters
 }
 
 void Cylinder::setHeight(float height) {
     m_height = height;
-    m_meshGenerated = false; // Regenerate mesh
+    m_geometry = nullptr; // Look up the geometry for the new parameters
 }
 
 void Cylinder::setSegments(int segments) {
     m_segments = segments;
-    m_meshGenerated = false; // Regenerate mesh
+    m_geometry = nullptr; // Look up the geometry for the new parameters
 }
 
-const std::vector<float>& Cylinder::getVertices() const {
-    if (!m_meshGenerated) {
-        generateMesh();
+const ShapeGeometry& Cylinder::getGeometry() const {
+    if (!m_geometry) {
+        ShapeGeometryKey key;
+        key.type = ShapeType::Cylinder;
+        key.segments = m_segments;
+        key.parameters = glm::vec3(m_radius, m_height, 0.0f);
+        m_geometry = ShapeGeometryRegistry::getInstance().getOrCreate(key,
+            [this](ShapeGeometry& geometry) { generateGeometry(geometry); });
     }
-    return m_vertices;
+    return *m_geometry;
 }
 
-const std::vector<float>& Cylinder::getNormals() const {
-    if (!m_meshGenerated) {
-        generateMesh();
-    }
-    return m_normals;
-}
-
-const std::vector<unsigned int>& Cylinder::getIndices() const {
-    if (!m_meshGenerated) {
-        generateMesh();
-    }
-    return m_indices;
-}
-
-void Cylinder::generateMesh() const {
-    m_vertices.clear();
-    m_normals.clear();
-    m_indices.clear();
-    
-    float scaledRadius = m_radius * std::max(m_scale.x, m_scale.z);
-    float scaledHeight = m_height * m_scale.y;
-    float halfHeight = scaledHeight * 0.5f;
+void Cylinder::generateGeometry(ShapeGeometry& geometry) const {
+    float halfHeight = m_height * 0.5f;
     
     // Generate side vertices
     for (int i = 0; i <= m_segments; ++i) {
         float angle = 2.0f * M_PI * i / m_segments;
-        float x = std::cos(angle) * scaledRadius;
-        float z = std::sin(angle) * scaledRadius;
+        float x = std::cos(angle) * m_radius;
+        float z = std::sin(angle) * m_radius;
         
         // Bottom vertex
-        m_vertices.push_back(x);
-        m_vertices.push_back(-halfHeight);
-        m_vertices.push_back(z);
+        geometry.vertices.push_back(x);
+        geometry.vertices.push_back(-halfHeight);
+        geometry.vertices.push_back(z);
         
         // Top vertex
-        m_vertices.push_back(x);
-        m_vertices.push_back(halfHeight);
-        m_vertices.push_back(z);
+        geometry.vertices.push_back(x);
+        geometry.vertices.push_back(halfHeight);
+        geometry.vertices.push_back(z);
         
         // Side normals (pointing outward)
         glm::vec3 normal = glm::normalize(glm::vec3(x, 0.0f, z));
-        m_normals.push_back(normal.x);
-        m_normals.push_back(normal.y);
-        m_normals.push_back(normal.z);
-        m_normals.push_back(normal.x);
-        m_normals.push_back(normal.y);
-        m_normals.push_back(normal.z);
+        geometry.normals.push_back(normal.x);
+        geometry.normals.push_back(normal.y);
+        geometry.normals.push_back(normal.z);
+        geometry.normals.push_back(normal.x);
+        geometry.normals.push_back(normal.y);
+        geometry.normals.push_back(normal.z);
     }
     
     // Generate side indices
@@ -131,47 +117,47 @@ void Cylinder::generateMesh() const {
         int next = (i + 1) * 2;
         
         // First triangle
-        m_indices.push_back(current);
-        m_indices.push_back(next);
-        m_indices.push_back(current + 1);
+        geometry.indices.push_back(current);
+        geometry.indices.push_back(next);
+        geometry.indices.push_back(current + 1);
         
         // Second triangle
-        m_indices.push_back(current + 1);
-        m_indices.push_back(next);
-        m_indices.push_back(next + 1);
+        geometry.indices.push_back(current + 1);
+        geometry.indices.push_back(next);
+        geometry.indices.push_back(next + 1);
     }
     
     // Generate top and bottom caps
-    int capStartIndex = m_vertices.size() / 3;
+    int capStartIndex = geometry.vertices.size() / 3;
     
     // Center vertices for caps
-    m_vertices.push_back(0.0f); m_vertices.push_back(-halfHeight); m_vertices.push_back(0.0f); // Bottom center
-    m_vertices.push_back(0.0f); m_vertices.push_back(halfHeight); m_vertices.push_back(0.0f);  // Top center
+    geometry.vertices.push_back(0.0f); geometry.vertices.push_back(-halfHeight); geometry.vertices.push_back(0.0f); // Bottom center
+    geometry.vertices.push_back(0.0f); geometry.vertices.push_back(halfHeight); geometry.vertices.push_back(0.0f);  // Top center
     
-    m_normals.push_back(0.0f); m_normals.push_back(-1.0f); m_normals.push_back(0.0f); // Bottom normal
-    m_normals.push_back(0.0f); m_normals.push_back(1.0f); m_normals.push_back(0.0f);  // Top normal
+    geometry.normals.push_back(0.0f); geometry.normals.push_back(-1.0f); geometry.normals.push_back(0.0f); // Bottom normal
+    geometry.normals.push_back(0.0f); geometry.normals.push_back(1.0f); geometry.normals.push_back(0.0f);  // Top normal
     
     // Cap vertices
     for (int i = 0; i <= m_segments; ++i) {
         float angle = 2.0f * M_PI * i / m_segments;
-        float x = std::cos(angle) * scaledRadius;
-        float z = std::sin(angle) * scaledRadius;
+        float x = std::cos(angle) * m_radius;
+        float z = std::sin(angle) * m_radius;
         
         // Bottom cap
-        m_vertices.push_back(x);
-        m_vertices.push_back(-halfHeight);
-        m_vertices.push_back(z);
-        m_normals.push_back(0.0f);
-        m_normals.push_back(-1.0f);
-        m_normals.push_back(0.0f);
+        geometry.vertices.push_back(x);
+        geometry.vertices.push_back(-halfHeight);
+        geometry.vertices.push_back(z);
+        geometry.normals.push_back(0.0f);
+        geometry.normals.push_back(-1.0f);
+        geometry.normals.push_back(0.0f);
         
         // Top cap
-        m_vertices.push_back(x);
-        m_vertices.push_back(halfHeight);
-        m_vertices.push_back(z);
-        m_normals.push_back(0.0f);
-        m_normals.push_back(1.0f);
-        m_normals.push_back(0.0f);
+        geometry.vertices.push_back(x);
+        geometry.vertices.push_back(halfHeight);
+        geometry.vertices.push_back(z);
+        geometry.normals.push_back(0.0f);
+        geometry.normals.push_back(1.0f);
+        geometry.normals.push_back(0.0f);
     }
     
     // Generate cap indices
@@ -182,15 +168,13 @@ void Cylinder::generateMesh() const {
         int next = capStartIndex + 2 + ((i + 1) % m_segments) * 2;
         
         // Bottom cap triangle
-        m_indices.push_back(bottomCenter);
-        m_indices.push_back(current);
-        m_indices.push_back(next);
+        geometry.indices.push_back(bottomCenter);
+        geometry.indices.push_back(current);
+        geometry.indices.push_back(next);
         
         // Top cap triangle
-        m_indices.push_back(topCenter);
-        m_indices.push_back(next + 1);
-        m_indices.push_back(current + 1);
+        geometry.indices.push_back(topCenter);
+        geometry.indices.push_back(next + 1);
+        geometry.indices.push_back(current + 1);
     }
-    
-    m_meshGenerated = true;
 }
@@ -1,5 +1,6 @@
 #include "Plane.h"
 #include "../core/PhysicsConstants.h"
+#include "../core/ShapeGeometry.h"
 
 Plane::Plane(float width, float depth) 
     : m_dimensions(glm::vec2(width, depth)), m_normal(glm::vec3(0.0f, 1.0f, 0.0f)) {
@@ -42,42 +43,28 @@ bool Plane::containsPoint(const glm::vec3& point) const {
 
 void Plane::setDimensions(const glm::vec2& dimensions) {
     m_dimensions = dimensions;
-    m_meshGenerated = false; // Regenerate mesh
+    m_geometry = nullptr; // Look up the geometry for the new parameters
 }
 
 void Plane::setNormal(const glm::vec3& normal) {
     m_normal = glm::normalize(normal);
-    m_meshGenerated = false; // Regenerate mesh
+    m_geometry = nullptr; // Look up the geometry for the new parameters
 }
 
-const std::vector<float>& Plane::getVertices() const {
-    if (!m_meshGenerated) {
-        generateMesh();
+const ShapeGeometry& Plane::getGeometry() const {
+    if (!m_geometry) {
+        ShapeGeometryKey key;
+        key.type = ShapeType::Plane;
+        key.parameters = glm::vec3(m_dimensions.x, 0.0f, m_dimensions.y);
+        key.normal = m_normal;
+        m_geometry = ShapeGeometryRegistry::getInstance().getOrCreate(key,
+            [this](ShapeGeometry& geometry) { generateGeometry(geometry); });
     }
-    return m_vertices;
+    return *m_geometry;
 }
 
-const std::vector<float>& Plane::getNormals() const {
-    if (!m_meshGenerated) {
-        generateMesh();
-    }
-    return m_normals;
-}
-
-const std::vector<unsigned int>& Plane::getIndices() const {
-    if (!m_meshGenerated) {
-        generateMesh();
-    }
-    return m_indices;
-}
-
-void Plane::generateMesh() const {
-    m_vertices.clear();
-    m_normals.clear();
-    m_indices.clear();
-    
-    glm::vec2 scaled = m_dimensions * glm::vec2(m_scale.x, m_scale.z);
-    float w = scaled.x * 0.5f, d = scaled.y * 0.5f;
+void Plane::generateGeometry(ShapeGeometry& geometry) const {
+    float w = m_dimensions.x * 0.5f, d = m_dimensions.y * 0.5f;
     
     // Generate 4 vertices for the plane
     std::vector<glm::vec3> positions = {
@@ -89,23 +76,21 @@ void Plane::generateMesh() const {
     
     // Add vertices
     for (const auto& pos : positions) {
-        m_vertices.push_back(pos.x);
-        m_vertices.push_back(pos.y);
-        m_vertices.push_back(pos.z);
+        geometry.vertices.push_back(pos.x);
+        geometry.vertices.push_back(pos.y);
+        geometry.vertices.push_back(pos.z);
     }
     
     // Add normals (all the same for a flat plane)
     for (int i = 0; i < 4; ++i) {
-        m_normals.push_back(m_normal.x);
-        m_normals.push_back(m_normal.y);
-        m_normals.push_back(m_normal.z);
+        geometry.normals.push_back(m_normal.x);
+        geometry.normals.push_back(m_normal.y);
+        geometry.normals.push_back(m_normal.z);
     }
     
     // Generate indices (2 triangles)
-    m_indices = {
+    geometry.indices = {
         0, 1, 2, // First triangle
         0, 2, 3  // Second triangle
     };
-    
-    m_meshGenerated = true;
 }
@@ -1,6 +1,7 @@
 #include "Sphere.h"
 #include "../core/PhysicsConstants.h"
-#include "../core/InertiaTensorCache.h"
+#include "../core/ShapeGeometry.h"
+#include <algorithm>
 #include <cmath>
 
 Sphere::Sphere(float radius, int segments) 
@@ -15,31 +16,15 @@ float Sphere::getVolume() const {
 glm::mat3 Sphere::getInertiaTensor(float mass) const {
     float scaledRadius = m_radius * std::max({m_scale.x, m_scale.y, m_scale.z});
     
-    // Generate cache key
-    std::string key = InertiaTensorCache::generateSphereKey(scaledRadius, mass);
-    
-    // Check cache first
-    auto& cache = InertiaTensorCache::getInstance();
-    glm::mat3 cached = cache.getInertiaTensor(key);
-    
-    // If not identity matrix, return cached result
-    if (cached != glm::mat3(1.0f)) {
-        return cached;
-    }
-    
+    // Closed form, cheaper than any cache lookup
     // Calculate inertia tensor for a sphere
     float I = (2.0f / 5.0f) * mass * scaledRadius * scaledRadius;
     
-    glm::mat3 tensor(
+    return glm::mat3(
         I, 0.0f, 0.0f,
         0.0f, I, 0.0f,
         0.0f, 0.0f, I
     );
-    
-    // Cache the result
-    cache.cacheInertiaTensor(key, tensor);
-    
-    return tensor;
 }
 
 glm::vec3 Sphere::getBoundingBoxMin() const {
@@ -63,47 +48,32 @@ bool Sphere::containsPoint(const glm::vec3& point) const {
 
 void Sphere::setRadius(float radius) {
     m_radius = radius;
-    m_meshGenerated = false; // Regenerate mesh
+    m_geometry = nullptr; // Look up the geometry for the new parameters
 }
 
 void Sphere::setSegments(int segments) {
     m_segments = segments;
-    m_meshGenerated = false; // Regenerate mesh
-}
-
-const std::vector<float>& Sphere::getVertices() const {
-    if (!m_meshGenerated) {
-        generateMesh();
-    }
-    return m_vertices;
-}
-
-const std::vector<float>& Sphere::getNormals() const {
-    if (!m_meshGenerated) {
-        generateMesh();
-    }
-    return m_normals;
+    m_geometry = nullptr; // Look up the geometry for the new parameters
 }
 
-const std::vector<unsigned int>& Sphere::getIndices() const {
-    if (!m_meshGenerated) {
-        generateMesh();
+const ShapeGeometry& Sphere::getGeometry() const {
+    if (!m_geometry) {
+        ShapeGeometryKey key;
+        key.type = ShapeType::Sphere;
+        key.segments = m_segments;
+        key.parameters = glm::vec3(m_radius, 0.0f, 0.0f);
+        m_geometry = ShapeGeometryRegistry::getInstance().getOrCreate(key,
+            [this](ShapeGeometry& geometry) { generateGeometry(geometry); });
     }
-    return m_indices;
+    return *m_geometry;
 }
 
-void Sphere::generateMesh() const {
-    m_vertices.clear();
-    m_normals.clear();
-    m_indices.clear();
-    
-    float scaledRadius = m_radius * std::max({m_scale.x, m_scale.y, m_scale.z});
-    
+void Sphere::generateGeometry(ShapeGeometry& geometry) const {
     // Generate vertices using UV sphere method
     for (int y = 0; y <= m_segments; ++y) {
         float yAngle = M_PI * y / m_segments;
-        float yPos = std::cos(yAngle) * scaledRadius;
-        float yRadius = std::sin(yAngle) * scaledRadius;
+        float yPos = std::cos(yAngle) * m_radius;
+        float yRadius = std::sin(yAngle) * m_radius;
         
         for (int x = 0; x <= m_segments; ++x) {
             float xAngle = 2.0f * M_PI * x / m_segments;
@@ -111,15 +81,15 @@ void Sphere::generateMesh() const {
             float zPos = std::sin(xAngle) * yRadius;
             
             // Position
-            m_vertices.push_back(xPos);
-            m_vertices.push_back(yPos);
-            m_vertices.push_back(zPos);
+            geometry.vertices.push_back(xPos);
+            geometry.vertices.push_back(yPos);
+            geometry.vertices.push_back(zPos);
             
             // Normal (same as position normalized)
             glm::vec3 normal = glm::normalize(glm::vec3(xPos, yPos, zPos));
-            m_normals.push_back(normal.x);
-            m_normals.push_back(normal.y);
-            m_normals.push_back(normal.z);
+            geometry.normals.push_back(normal.x);
+            geometry.normals.push_back(normal.y);
+            geometry.normals.push_back(normal.z);
         }
     }
     
@@ -130,16 +100,14 @@ void Sphere::generateMesh() const {
             int next = current + m_segments + 1;
             
             // First triangle
-            m_indices.push_back(current);
-            m_indices.push_back(next);
-            m_indices.push_back(current + 1);
+            geometry.indices.push_back(current);
+            geometry.indices.push_back(next);
+            geometry.indices.push_back(current + 1);
             
             // Second triangle
-            m_indices.push_back(current + 1);
-            m_indices.push_back(next);
-            m_indices.push_back(next + 1);
+            geometry.indices.push_back(current + 1);
+            geometry.indices.push_back(next);
+            geometry.indices.push_back(next + 1);
         }
     }
-    
-    m_meshGenerated = true;
 }
@@ -15,11 +15,11 @@ public:
     glm::vec3 getBoundingBoxMin() const override;
     glm::vec3 getBoundingBoxMax() const override;
     
-    const std::vector<float>& getVertices() const override;
-    const std::vector<float>& getNormals() const override;
-    const std::vector<unsigned int>& getIndices() const override;
+    const ShapeGeometry& getGeometry() const override;
     
     const char* getTypeName() const override { return "Sphere"; }
+    ShapeType getType() const override { return ShapeType::Sphere; }
+    glm::vec3 getParameters() const override { return glm::vec3(m_radius, 0.0f, 0.0f); }
     glm::vec3 getCenter() const override;
     bool containsPoint(const glm::vec3& point) const override;
     
@@ -33,11 +33,8 @@ private:
     float m_radius; // radius in meters
     int m_segments; // mesh resolution
     
-    // Cached mesh data
-    mutable std::vector<float> m_vertices;
-    mutable std::vector<float> m_normals;
-    mutable std::vector<unsigned int> m_indices;
-    mutable bool m_meshGenerated = false;
+    // Shared mesh data, looked up on first use
+    mutable const ShapeGeometry* m_geometry = nullptr;
     
-    void generateMesh() const;
+    void generateGeometry(ShapeGeometry& geometry) const;
 };
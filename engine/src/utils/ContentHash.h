@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Streaming 64-bit content hash for cache keys (not cryptographic)
+//
+// Processes input 8 bytes at a time with a multiply/rotate mix, so hashing
+// large vertex arrays costs about as much as reading them.
+class ContentHash {
+public:
+    ContentHash() = default;
+    
+    // Feed raw bytes
+    void update(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        m_length += size;
+        
+        // Complete a partially filled word first
+        while (m_pendingSize > 0 && m_pendingSize < 8 && size > 0) {
+            m_pending[m_pendingSize++] = *bytes++;
+            --size;
+        }
+        if (m_pendingSize == 8) {
+            mixWord(load64(m_pending));
+            m_pendingSize = 0;
+        }
+        
+        while (size >= 8) {
+            mixWord(load64(bytes));
+            bytes += 8;
+            size -= 8;
+        }
+        
+        while (size > 0) {
+            m_pending[m_pendingSize++] = *bytes++;
+            --size;
+        }
+    }
+    
+    // Feed a trivially copyable value
+    template <typename T>
+    void updateValue(const T& value) {
+        update(&value, sizeof(T));
+    }
+    
+    // Feed the contents of a vector of trivially copyable elements (including its length)
+    template <typename T>
+    void updateVector(const std::vector<T>& values) {
+        updateValue(static_cast<uint64_t>(values.size()));
+        if (!values.empty()) {
+            update(values.data(), values.size() * sizeof(T));
+        }
+    }
+    
+    // Final hash of everything fed so far (does not reset the state)
+    uint64_t finish() const {
+        uint64_t state = m_state;
+        if (m_pendingSize > 0) {
+            uint8_t tail[8] = {};
+            std::memcpy(tail, m_pending, m_pendingSize);
+            state = mix(state, load64(tail));
+        }
+        state ^= m_length;
+        
+        // Final avalanche (from MurmurHash3's fmix64)
+        state ^= state >> 33;
+        state *= 0xFF51AFD7ED558CCDULL;
+        state ^= state >> 33;
+        state *= 0xC4CEB9FE1A85EC53ULL;
+        state ^= state >> 33;
+        return state;
+    }
+    
+    // Hash formatted as 16 hex digits, for file names
+    static std::string toHex(uint64_t hash) {
+        static const char* DIGITS = "0123456789abcdef";
+        std::string text(16, '0');
+        for (int i = 15; i >= 0; --i) {
+            text[i] = DIGITS[hash & 0xF];
+            hash >>= 4;
+        }
+        return text;
+    }
+    
+private:
+    static uint64_t load64(const uint8_t* bytes) {
+        uint64_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    
+    static uint64_t rotl(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+    
+    static uint64_t mix(uint64_t state, uint64_t word) {
+        word *= 0x87C37B91114253D5ULL;
+        word = rotl(word, 31);
+        word *= 0x4CF5AD432745937FULL;
+        state ^= word;
+        return rotl(state, 27) * 5 + 0x52DCE729;
+    }
+    
+    void mixWord(uint64_t word) {
+        m_state = mix(m_state, word);
+    }
+    
+    uint64_t m_state = 0x9E3779B97F4A7C15ULL;
+    uint64_t m_length = 0;
+    uint8_t m_pending[8] = {};
+    size_t m_pendingSize = 0;
+};
@@ -0,0 +1,121 @@
+#include "MappedFile.h"
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : m_data(nullptr), m_size(0), m_fileHandle(INVALID_HANDLE_VALUE), m_mappingHandle(nullptr) {}
+
+bool MappedFile::open(const std::string& path, Access access) {
+    close();
+    
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    // PAGE_WRITECOPY + FILE_MAP_COPY gives private copy-on-write pages
+    bool copyOnWrite = access == Access::CopyOnWrite;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    void* view = MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+        m_fileHandle = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+}
+
+#else
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0) {}
+
+bool MappedFile::open(const std::string& path, Access access) {
+    close();
+    
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    
+    // MAP_PRIVATE with PROT_WRITE gives copy-on-write pages backed by the file
+    int protection = access == Access::CopyOnWrite ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), protection, MAP_PRIVATE, fd, 0);
+    
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    
+    if (view == MAP_FAILED) {
+        std::cerr << "MappedFile::open: Failed to map " << path << std::endl;
+        return false;
+    }
+    
+    m_data = static_cast<uint8_t*>(view);
+    m_size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+    m_size = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Memory-mapped view of a whole file
+//
+// CopyOnWrite mappings may be modified in memory (e.g. to fix up pointers in
+// place); modified pages become private copies and never reach the file.
+class MappedFile {
+public:
+    enum class Access {
+        ReadOnly,
+        CopyOnWrite
+    };
+    
+    MappedFile();
+    ~MappedFile();
+    
+    // Disable copy constructor and assignment operator
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    // Map a file, replacing any current mapping. Returns false if the file cannot be mapped.
+    bool open(const std::string& path, Access access = Access::ReadOnly);
+    
+    // Unmap the file
+    void close();
+    
+    bool isOpen() const { return m_data != nullptr; }
+    uint8_t* data() { return m_data; }
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    
+private:
+    uint8_t* m_data;
+    size_t m_size;
+    
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#endif
+};
@@ -0,0 +1,393 @@
+#include "MassProperties.h"
+#include "ContentHash.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+// Triangles are integrated in groups of LANES with independent accumulators, which the
+// compiler turns into SIMD (a single running sum would serialize on the adds)
+constexpr size_t LANES = 4;
+
+// Triangle corners in structure-of-arrays form, padded with degenerate triangles
+struct TriangleArrays {
+    std::vector<double> x[3];
+    std::vector<double> y[3];
+    std::vector<double> z[3];
+};
+
+// Eberly's per-axis subexpressions for one triangle
+inline void subexpressions(double w0, double w1, double w2,
+                           double& f1, double& f2, double& f3, double& g0, double& g1, double& g2) {
+    double temp0 = w0 + w1;
+    double temp1 = w0 * w0;
+    double temp2 = temp1 + w1 * temp0;
+    f1 = temp0 + w2;
+    f2 = temp2 + w2 * f1;
+    f3 = w0 * temp1 + w1 * temp2 + w2 * f2;
+    g0 = f2 + w0 * (f1 + w0);
+    g1 = f2 + w1 * (f1 + w1);
+    g2 = f2 + w2 * (f1 + w2);
+}
+
+// Integrals of 1, x, y, z, x^2, y^2, z^2, xy, yz, zx over the enclosed volume
+void integrate(const TriangleArrays& arrays, double integrals[10]) {
+    double sums[10][LANES] = {};
+    size_t count = arrays.x[0].size();
+    
+    for (size_t base = 0; base < count; base += LANES) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            size_t i = base + lane;
+            double x0 = arrays.x[0][i], y0 = arrays.y[0][i], z0 = arrays.z[0][i];
+            double x1 = arrays.x[1][i], y1 = arrays.y[1][i], z1 = arrays.z[1][i];
+            double x2 = arrays.x[2][i], y2 = arrays.y[2][i], z2 = arrays.z[2][i];
+            
+            // Edge cross product (area weighted normal)
+            double a1 = x1 - x0, b1 = y1 - y0, c1 = z1 - z0;
+            double a2 = x2 - x0, b2 = y2 - y0, c2 = z2 - z0;
+            double d0 = b1 * c2 - b2 * c1;
+            double d1 = a2 * c1 - a1 * c2;
+            double d2 = a1 * b2 - a2 * b1;
+            
+            double f1x, f2x, f3x, g0x, g1x, g2x;
+            double f1y, f2y, f3y, g0y, g1y, g2y;
+            double f1z, f2z, f3z, g0z, g1z, g2z;
+            subexpressions(x0, x1, x2, f1x, f2x, f3x, g0x, g1x, g2x);
+            subexpressions(y0, y1, y2, f1y, f2y, f3y, g0y, g1y, g2y);
+            subexpressions(z0, z1, z2, f1z, f2z, f3z, g0z, g1z, g2z);
+            
+            sums[0][lane] += d0 * f1x;
+            sums[1][lane] += d0 * f2x;
+            sums[2][lane] += d1 * f2y;
+            sums[3][lane] += d2 * f2z;
+            sums[4][lane] += d0 * f3x;
+            sums[5][lane] += d1 * f3y;
+            sums[6][lane] += d2 * f3z;
+            sums[7][lane] += d0 * (y0 * g0x + y1 * g1x + y2 * g2x);
+            sums[8][lane] += d1 * (z0 * g0y + z1 * g1y + z2 * g2y);
+            sums[9][lane] += d2 * (x0 * g0z + x1 * g1z + x2 * g2z);
+        }
+    }
+    
+    static const double MULTIPLIERS[10] = {
+        1.0 / 6.0, 1.0 / 24.0, 1.0 / 24.0, 1.0 / 24.0, 1.0 / 60.0,
+        1.0 / 60.0, 1.0 / 60.0, 1.0 / 120.0, 1.0 / 120.0, 1.0 / 120.0
+    };
+    for (int k = 0; k < 10; ++k) {
+        double total = 0.0;
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            total += sums[k][lane];
+        }
+        integrals[k] = total * MULTIPLIERS[k];
+    }
+}
+
+// Eigen decomposition of a symmetric 3x3 matrix (cyclic Jacobi rotations)
+void diagonalize(double a[3][3], double eigenvalues[3], double vectors[3][3]) {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            vectors[i][j] = i == j ? 1.0 : 0.0;
+        }
+    }
+    
+    const int pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+    for (int sweep = 0; sweep < 32; ++sweep) {
+        double offDiagonal = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        double diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        if (offDiagonal <= 1e-24 * diagonal) break;
+        
+        for (const auto& pair : pairs) {
+            int p = pair[0];
+            int q = pair[1];
+            if (a[p][q] == 0.0) continue;
+            
+            double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+            double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+            double c = 1.0 / std::sqrt(t * t + 1.0);
+            double s = t * c;
+            
+            for (int k = 0; k < 3; ++k) {
+                double akp = a[k][p], akq = a[k][q];
+                a[k][p] = c * akp - s * akq;
+                a[k][q] = s * akp + c * akq;
+            }
+            for (int k = 0; k < 3; ++k) {
+                double apk = a[p][k], aqk = a[q][k];
+                a[p][k] = c * apk - s * aqk;
+                a[q][k] = s * apk + c * aqk;
+            }
+            for (int k = 0; k < 3; ++k) {
+                double vkp = vectors[k][p], vkq = vectors[k][q];
+                vectors[k][p] = c * vkp - s * vkq;
+                vectors[k][q] = s * vkp + c * vkq;
+            }
+        }
+    }
+    
+    for (int i = 0; i < 3; ++i) {
+        eigenvalues[i] = a[i][i];
+    }
+}
+
+// Layout of a mass properties cache file
+struct MassPropertiesRecord {
+    char magic[8];
+    uint32_t version;
+    uint32_t valid;
+    uint64_t contentHash;
+    float volume;
+    float centerOfMass[3];
+    float inertia[9];
+    float principalMoments[3];
+    float principalAxes[9];
+};
+
+const char MASS_CACHE_MAGIC[8] = {'R', 'C', 'M', 'A', 'S', 'S', '1', '\0'};
+const uint32_t MASS_CACHE_VERSION = 1;
+
+std::string getCachePath(const std::string& directory, uint64_t contentHash) {
+    return (std::filesystem::path(directory) / ("mass_" + ContentHash::toHex(contentHash) + ".bin")).string();
+}
+
+} // namespace
+
+glm::mat3 MassProperties::getInertia(float mass) const {
+    if (!valid || volume <= 0.0f) {
+        return glm::mat3(0.0f);
+    }
+    return inertia * (mass / volume);
+}
+
+glm::mat3 MassProperties::getInertiaAboutOrigin(float mass) const {
+    if (!valid || volume <= 0.0f) {
+        return glm::mat3(0.0f);
+    }
+    
+    // I_origin = I_com + m (|c|^2 E - c c^T)
+    glm::vec3 c = centerOfMass;
+    glm::mat3 shift = glm::mat3(glm::dot(c, c)) - glm::outerProduct(c, c);
+    return getInertia(mass) + shift * mass;
+}
+
+MassProperties MassProperties::compute(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles) {
+    MassProperties properties;
+    if (vertices.empty() || triangles.empty()) {
+        return properties;
+    }
+    
+    // Integrate relative to the bounds center; far-away meshes would otherwise lose
+    // precision to cancellation in the second moments
+    glm::vec3 boundsMin = vertices[0];
+    glm::vec3 boundsMax = vertices[0];
+    for (const glm::vec3& vertex : vertices) {
+        boundsMin = glm::min(boundsMin, vertex);
+        boundsMax = glm::max(boundsMax, vertex);
+    }
+    glm::vec3 reference = (boundsMin + boundsMax) * 0.5f;
+    
+    TriangleArrays arrays;
+    size_t padded = (triangles.size() + LANES - 1) / LANES * LANES;
+    for (int corner = 0; corner < 3; ++corner) {
+        arrays.x[corner].reserve(padded);
+        arrays.y[corner].reserve(padded);
+        arrays.z[corner].reserve(padded);
+    }
+    
+    int vertexCount = static_cast<int>(vertices.size());
+    for (const glm::ivec3& triangle : triangles) {
+        int indices[3] = {triangle.x, triangle.y, triangle.z};
+        if (indices[0] < 0 || indices[0] >= vertexCount ||
+            indices[1] < 0 || indices[1] >= vertexCount ||
+            indices[2] < 0 || indices[2] >= vertexCount) {
+            continue;
+        }
+        for (int corner = 0; corner < 3; ++corner) {
+            glm::vec3 point = vertices[indices[corner]] - reference;
+            arrays.x[corner].push_back(point.x);
+            arrays.y[corner].push_back(point.y);
+            arrays.z[corner].push_back(point.z);
+        }
+    }
+    
+    // Degenerate padding triangles contribute nothing
+    size_t count = (arrays.x[0].size() + LANES - 1) / LANES * LANES;
+    for (int corner = 0; corner < 3; ++corner) {
+        arrays.x[corner].resize(count, 0.0);
+        arrays.y[corner].resize(count, 0.0);
+        arrays.z[corner].resize(count, 0.0);
+    }
+    
+    double integrals[10];
+    integrate(arrays, integrals);
+    
+    // Inward winding flips every integral
+    if (integrals[0] < 0.0) {
+        for (double& integral : integrals) {
+            integral = -integral;
+        }
+    }
+    
+    double volume = integrals[0];
+    if (!(volume > 1e-12)) {
+        return properties;
+    }
+    
+    double cx = integrals[1] / volume;
+    double cy = integrals[2] / volume;
+    double cz = integrals[3] / volume;
+    
+    // Second moments about the center of mass (unit density)
+    double tensor[3][3];
+    tensor[0][0] = integrals[5] + integrals[6] - volume * (cy * cy + cz * cz);
+    tensor[1][1] = integrals[4] + integrals[6] - volume * (cz * cz + cx * cx);
+    tensor[2][2] = integrals[4] + integrals[5] - volume * (cx * cx + cy * cy);
+    tensor[0][1] = tensor[1][0] = -(integrals[7] - volume * cx * cy);
+    tensor[1][2] = tensor[2][1] = -(integrals[8] - volume * cy * cz);
+    tensor[0][2] = tensor[2][0] = -(integrals[9] - volume * cz * cx);
+    
+    properties.valid = true;
+    properties.volume = static_cast<float>(volume);
+    properties.centerOfMass = reference + glm::vec3(static_cast<float>(cx), static_cast<float>(cy), static_cast<float>(cz));
+    for (int column = 0; column < 3; ++column) {
+        for (int row = 0; row < 3; ++row) {
+            properties.inertia[column][row] = static_cast<float>(tensor[row][column]);
+        }
+    }
+    
+    double eigenvalues[3];
+    double eigenvectors[3][3];
+    diagonalize(tensor, eigenvalues, eigenvectors);
+    for (int column = 0; column < 3; ++column) {
+        properties.principalMoments[column] = static_cast<float>(eigenvalues[column]);
+        for (int row = 0; row < 3; ++row) {
+            properties.principalAxes[column][row] = static_cast<float>(eigenvectors[row][column]);
+        }
+    }
+    return properties;
+}
+
+MassPropertiesCache& MassPropertiesCache::getInstance() {
+    static MassPropertiesCache instance;
+    return instance;
+}
+
+MassProperties MassPropertiesCache::get(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles) {
+    ContentHash hash;
+    hash.updateVector(vertices);
+    hash.updateVector(triangles);
+    uint64_t contentHash = hash.finish();
+    
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_cache.find(contentHash);
+        if (it != m_cache.end()) {
+            return it->second;
+        }
+        directory = m_directory;
+    }
+    
+    MassProperties properties;
+    std::string path = directory.empty() ? std::string() : getCachePath(directory, contentHash);
+    bool loaded = !path.empty() && loadFromDisk(path, contentHash, properties);
+    if (!loaded) {
+        properties = MassProperties::compute(vertices, triangles);
+        if (!path.empty()) {
+            storeToDisk(directory, path, contentHash, properties);
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!loaded) {
+        m_computeCount++;
+    }
+    m_cache.emplace(contentHash, properties);
+    return properties;
+}
+
+void MassPropertiesCache::setCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directory = directory;
+}
+
+std::string MassPropertiesCache::getCacheDirectory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_directory;
+}
+
+size_t MassPropertiesCache::getComputeCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_computeCount;
+}
+
+void MassPropertiesCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.clear();
+    m_computeCount = 0;
+}
+
+bool MassPropertiesCache::loadFromDisk(const std::string& path, uint64_t contentHash, MassProperties& properties) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    
+    MassPropertiesRecord record;
+    if (!file.read(reinterpret_cast<char*>(&record), sizeof(record)) ||
+        std::memcmp(record.magic, MASS_CACHE_MAGIC, sizeof(record.magic)) != 0 ||
+        record.version != MASS_CACHE_VERSION || record.contentHash != contentHash) {
+        std::cerr << "MassPropertiesCache::get: Ignoring stale cache file " << path << std::endl;
+        return false;
+    }
+    
+    properties.valid = record.valid != 0;
+    properties.volume = record.volume;
+    properties.centerOfMass = glm::vec3(record.centerOfMass[0], record.centerOfMass[1], record.centerOfMass[2]);
+    for (int column = 0; column < 3; ++column) {
+        properties.principalMoments[column] = record.principalMoments[column];
+        for (int row = 0; row < 3; ++row) {
+            properties.inertia[column][row] = record.inertia[column * 3 + row];
+            properties.principalAxes[column][row] = record.principalAxes[column * 3 + row];
+        }
+    }
+    return true;
+}
+
+void MassPropertiesCache::storeToDisk(const std::string& directory, const std::string& path, uint64_t contentHash,
+                                      const MassProperties& properties) {
+    MassPropertiesRecord record;
+    std::memset(&record, 0, sizeof(record));
+    std::memcpy(record.magic, MASS_CACHE_MAGIC, sizeof(record.magic));
+    record.version = MASS_CACHE_VERSION;
+    record.valid = properties.valid ? 1 : 0;
+    record.contentHash = contentHash;
+    record.volume = properties.volume;
+    for (int column = 0; column < 3; ++column) {
+        record.centerOfMass[column] = properties.centerOfMass[column];
+        record.principalMoments[column] = properties.principalMoments[column];
+        for (int row = 0; row < 3; ++row) {
+            record.inertia[column * 3 + row] = properties.inertia[column][row];
+            record.principalAxes[column * 3 + row] = properties.principalAxes[column][row];
+        }
+    }
+    
+    // Write to a temporary file and rename, so a concurrent reader never sees a partial file
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        if (!file) {
+            std::cerr << "MassPropertiesCache::get: Failed to write cache file " << tempPath << std::endl;
+        }
+    }
+    
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+    }
+}
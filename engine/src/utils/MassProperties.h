@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Volume, center of mass and inertia of a closed triangle mesh
+//
+// Computed exactly with the divergence theorem (Eberly, "Polyhedral Mass Properties"):
+// every volume integral becomes a sum over the surface triangles. Triangles may wind
+// either way as long as the winding is consistent.
+struct MassProperties {
+    bool valid = false;                             // False if the mesh encloses no volume
+    float volume = 0.0f;
+    glm::vec3 centerOfMass = glm::vec3(0.0f);
+    glm::mat3 inertia = glm::mat3(0.0f);            // About the center of mass at unit density
+    glm::vec3 principalMoments = glm::vec3(0.0f);   // Eigenvalues of inertia
+    glm::mat3 principalAxes = glm::mat3(1.0f);      // Columns are the matching eigenvectors
+    
+    // Inertia tensor about the center of mass for a body of the given mass
+    glm::mat3 getInertia(float mass) const;
+    
+    // Inertia tensor about the mesh origin (parallel axis shift of getInertia), for
+    // bodies that rotate about their shape origin as Bullet's do
+    glm::mat3 getInertiaAboutOrigin(float mass) const;
+    
+    // Integrate a mesh (triangles with out-of-range indices are skipped)
+    static MassProperties compute(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles);
+};
+
+// Mass properties by mesh content hash, so every instance of the same prop is
+// integrated once; with a cache directory set, results also survive restarts
+class MassPropertiesCache {
+public:
+    // Singleton pattern
+    static MassPropertiesCache& getInstance();
+    
+    // Mass properties of a mesh, from memory, disk or computed
+    MassProperties get(const std::vector<glm::vec3>& vertices, const std::vector<glm::ivec3>& triangles);
+    
+    // Directory results are persisted in (created on first write), empty to disable (default)
+    void setCacheDirectory(const std::string& directory);
+    std::string getCacheDirectory() const;
+    
+    // Get cache statistics
+    size_t getComputeCount() const;
+    void clear();
+    
+private:
+    MassPropertiesCache() = default;
+    ~MassPropertiesCache() = default;
+    
+    // Disable copy constructor and assignment operator
+    MassPropertiesCache(const MassPropertiesCache&) = delete;
+    MassPropertiesCache& operator=(const MassPropertiesCache&) = delete;
+    
+    std::unordered_map<uint64_t, MassProperties> m_cache;
+    std::string m_directory;
+    size_t m_computeCount = 0;
+    
+    // Thread safety (integration runs outside the lock)
+    mutable std::mutex m_mutex;
+    
+    static bool loadFromDisk(const std::string& path, uint64_t contentHash, MassProperties& properties);
+    static void storeToDisk(const std::string& directory, const std::string& path, uint64_t contentHash,
+                            const MassProperties& properties);
+};
@@ -0,0 +1,328 @@
+#include "MeshAsset.h"
+#include "MeshImporter.h"
+#include "ContentHash.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char MESH_ASSET_MAGIC[8] = {'R', 'C', 'M', 'E', 'S', 'H', '1', '\0'};
+
+// Forsyth's vertex scoring: recently used vertices score high, and vertices with few
+// remaining triangles get a boost so they are finished off and leave the cache
+constexpr int CACHE_SIZE = 32;
+constexpr float CACHE_DECAY_POWER = 1.5f;
+constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float VALENCE_BOOST_SCALE = 2.0f;
+constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+float vertexScore(int cachePosition, uint32_t remainingTriangles) {
+    if (remainingTriangles == 0) {
+        return -1.0f;
+    }
+    
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // Vertices of the last triangle get a fixed score so it is not reused immediately
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            float scaler = 1.0f / (CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+        }
+    }
+    return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+}
+
+inline uint64_t alignOffset(uint64_t offset) {
+    return (offset + 15) & ~uint64_t(15);
+}
+
+// Largest index below vertexCount; the GPU would otherwise read past the vertex buffer
+template <typename Index>
+bool indicesInRange(const Index* indices, uint32_t indexCount, uint32_t vertexCount) {
+    Index maxIndex = 0;
+    for (uint32_t i = 0; i < indexCount; ++i) {
+        maxIndex = std::max(maxIndex, indices[i]);
+    }
+    return indexCount == 0 || maxIndex < vertexCount;
+}
+
+} // namespace
+
+void MeshAsset::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) {
+        return;
+    }
+    
+    // Triangle adjacency per vertex (CSR layout)
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices) {
+        remaining[index]++;
+    }
+    std::vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyStart[v + 1] = adjacencyStart[v] + remaining[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int corner = 0; corner < 3; ++corner) {
+            adjacency[fill[indices[t * 3 + corner]]++] = static_cast<uint32_t>(t);
+        }
+    }
+    
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScores[v] = vertexScore(-1, remaining[v]);
+    }
+    std::vector<float> triangleScores(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+    }
+    
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(CACHE_SIZE + 3);
+    nextCache.reserve(CACHE_SIZE + 3);
+    
+    size_t scanPosition = 0;
+    int64_t bestTriangle = -1;
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (bestTriangle < 0) {
+            // Nothing adjacent to the cache: continue with the next unemitted triangle in input order
+            while (emitted[scanPosition]) {
+                ++scanPosition;
+            }
+            bestTriangle = static_cast<int64_t>(scanPosition);
+        }
+        
+        size_t triangle = static_cast<size_t>(bestTriangle);
+        emitted[triangle] = true;
+        const uint32_t* corners = &indices[triangle * 3];
+        output.insert(output.end(), corners, corners + 3);
+        
+        // The triangle's vertices move to the front of the LRU cache
+        nextCache.assign(corners, corners + 3);
+        for (uint32_t vertex : cache) {
+            if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2]) {
+                nextCache.push_back(vertex);
+            }
+        }
+        for (int corner = 0; corner < 3; ++corner) {
+            uint32_t vertex = corners[corner];
+            remaining[vertex]--;
+            // Drop the triangle from the vertex's live adjacency
+            uint32_t* begin = &adjacency[adjacencyStart[vertex]];
+            uint32_t* end = begin + remaining[vertex] + 1;
+            *std::find(begin, end, static_cast<uint32_t>(triangle)) = end[-1];
+        }
+        
+        // Rescore the vertices whose cache position changed, and their triangles
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            uint32_t vertex = nextCache[i];
+            cachePosition[vertex] = i < CACHE_SIZE ? static_cast<int>(i) : -1;
+            float score = vertexScore(cachePosition[vertex], remaining[vertex]);
+            float delta = score - vertexScores[vertex];
+            vertexScores[vertex] = score;
+            for (uint32_t a = 0; a < remaining[vertex]; ++a) {
+                triangleScores[adjacency[adjacencyStart[vertex] + a]] += delta;
+            }
+        }
+        if (nextCache.size() > CACHE_SIZE) {
+            nextCache.resize(CACHE_SIZE);
+        }
+        cache.swap(nextCache);
+        
+        // Next triangle: the best one touching the cache
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (uint32_t vertex : cache) {
+            for (uint32_t a = 0; a < remaining[vertex]; ++a) {
+                uint32_t candidate = adjacency[adjacencyStart[vertex] + a];
+                if (triangleScores[candidate] > bestScore) {
+                    bestScore = triangleScores[candidate];
+                    bestTriangle = candidate;
+                }
+            }
+        }
+    }
+    
+    indices.swap(output);
+}
+
+void MeshAsset::optimizeVertexFetch(std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices) {
+    const uint32_t UNUSED = UINT32_MAX;
+    std::vector<uint32_t> remap(positions.size(), UNUSED);
+    std::vector<glm::vec3> reordered;
+    reordered.reserve(positions.size());
+    
+    for (uint32_t& index : indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = static_cast<uint32_t>(reordered.size());
+            reordered.push_back(positions[index]);
+        }
+        index = remap[index];
+    }
+    positions.swap(reordered);
+}
+
+bool MeshAsset::compile(const ImportedMesh& mesh, uint64_t sourceStamp, const std::string& outputPath) {
+    if (mesh.positions.empty() || mesh.indices.size() < 3 || mesh.indices.size() % 3 != 0) {
+        std::cerr << "MeshAsset::compile: Invalid mesh!" << std::endl;
+        return false;
+    }
+    
+    std::vector<glm::vec3> positions = mesh.positions;
+    std::vector<uint32_t> indices = mesh.indices;
+    optimizeVertexCache(indices, positions.size());
+    optimizeVertexFetch(positions, indices);
+    
+    glm::vec3 boundsMin = positions[0];
+    glm::vec3 boundsMax = positions[0];
+    for (const glm::vec3& position : positions) {
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
+    glm::vec3 extent = boundsMax - boundsMin;
+    
+    std::vector<uint16_t> quantized(positions.size() * 4, 0);
+    for (size_t v = 0; v < positions.size(); ++v) {
+        for (int axis = 0; axis < 3; ++axis) {
+            float fraction = extent[axis] > 0.0f ? (positions[v][axis] - boundsMin[axis]) / extent[axis] : 0.0f;
+            quantized[v * 4 + axis] = static_cast<uint16_t>(std::lround(std::clamp(fraction, 0.0f, 1.0f) * 65535.0f));
+        }
+    }
+    
+    MeshAssetHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MESH_ASSET_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.sourceStamp = sourceStamp;
+    header.vertexCount = static_cast<uint32_t>(positions.size());
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    for (int axis = 0; axis < 3; ++axis) {
+        header.boundsMin[axis] = boundsMin[axis];
+        header.boundsMax[axis] = boundsMax[axis];
+    }
+    bool wideIndices = positions.size() > 65536;
+    header.flags = wideIndices ? MeshAssetHeader::INDEX_32BIT : 0;
+    header.vertexOffset = alignOffset(sizeof(MeshAssetHeader));
+    header.indexOffset = alignOffset(header.vertexOffset + quantized.size() * sizeof(uint16_t));
+    
+    std::vector<uint16_t> narrowIndices;
+    if (!wideIndices) {
+        narrowIndices.assign(indices.begin(), indices.end());
+    }
+    
+    std::error_code error;
+    std::filesystem::path output(outputPath);
+    if (output.has_parent_path()) {
+        std::filesystem::create_directories(output.parent_path(), error);
+    }
+    std::string tempPath = outputPath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        const char padding[16] = {};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(padding, static_cast<std::streamsize>(header.vertexOffset - sizeof(header)));
+        file.write(reinterpret_cast<const char*>(quantized.data()), quantized.size() * sizeof(uint16_t));
+        file.write(padding, static_cast<std::streamsize>(header.indexOffset - header.vertexOffset - quantized.size() * sizeof(uint16_t)));
+        if (wideIndices) {
+            file.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint32_t));
+        } else {
+            file.write(reinterpret_cast<const char*>(narrowIndices.data()), narrowIndices.size() * sizeof(uint16_t));
+        }
+        if (!file) {
+            std::cerr << "MeshAsset::compile: Failed to write " << tempPath << "!" << std::endl;
+            file.close();
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+    
+    std::filesystem::rename(tempPath, outputPath, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool MeshAsset::compileFile(const std::string& sourcePath, const std::string& outputPath) {
+    ImportedMesh mesh;
+    if (!MeshImporter::load(sourcePath, mesh)) {
+        return false;
+    }
+    return compile(mesh, getSourceStamp(sourcePath), outputPath);
+}
+
+uint64_t MeshAsset::getSourceStamp(const std::string& sourcePath) {
+    // Size and modification time, so checking for a stale asset never reads the source
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(sourcePath, error);
+    if (error) {
+        return 0;
+    }
+    auto modified = std::filesystem::last_write_time(sourcePath, error);
+    if (error) {
+        return 0;
+    }
+    
+    ContentHash hash;
+    hash.updateValue(size);
+    hash.updateValue(static_cast<int64_t>(modified.time_since_epoch().count()));
+    return hash.finish() | 1;  // Never 0, which means "any source"
+}
+
+bool MeshAsset::open(const std::string& path, uint64_t sourceStamp) {
+    close();
+    if (!m_file.open(path) || m_file.size() < sizeof(MeshAssetHeader)) {
+        m_file.close();
+        return false;
+    }
+    
+    const MeshAssetHeader* header = reinterpret_cast<const MeshAssetHeader*>(m_file.data());
+    bool wideIndices = (header->flags & MeshAssetHeader::INDEX_32BIT) != 0;
+    size_t indexSize = wideIndices ? sizeof(uint32_t) : sizeof(uint16_t);
+    bool valid = std::memcmp(header->magic, MESH_ASSET_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == VERSION &&
+                 (sourceStamp == 0 || header->sourceStamp == sourceStamp) &&
+                 header->vertexOffset % 16 == 0 && header->indexOffset % 16 == 0 &&
+                 header->vertexOffset >= sizeof(MeshAssetHeader) &&
+                 header->vertexOffset + uint64_t(header->vertexCount) * 4 * sizeof(uint16_t) <= header->indexOffset &&
+                 header->indexOffset + uint64_t(header->indexCount) * indexSize <= m_file.size() &&
+                 header->indexCount % 3 == 0;
+    
+    // A truncated or corrupted index section must not reach glDrawElements
+    if (valid) {
+        const uint8_t* indices = m_file.data() + header->indexOffset;
+        valid = wideIndices ? indicesInRange(reinterpret_cast<const uint32_t*>(indices), header->indexCount, header->vertexCount)
+                            : indicesInRange(reinterpret_cast<const uint16_t*>(indices), header->indexCount, header->vertexCount);
+    }
+    if (!valid) {
+        m_file.close();
+        return false;
+    }
+    
+    m_header = header;
+    return true;
+}
+
+const uint16_t* MeshAsset::getVertexData() const {
+    return reinterpret_cast<const uint16_t*>(m_file.data() + m_header->vertexOffset);
+}
+
+const void* MeshAsset::getIndexData() const {
+    return m_file.data() + m_header->indexOffset;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "MappedFile.h"
+
+struct ImportedMesh;
+
+// Layout of a compiled mesh file: header, quantized positions, indices. Offsets are
+// 16-byte aligned so the sections can be handed to the GPU straight from a mapping.
+struct MeshAssetHeader {
+    static constexpr uint32_t INDEX_32BIT = 1u << 0;  // Indices are uint32 instead of uint16
+    
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t sourceStamp;     // Identifies the source file the asset was compiled from
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    float boundsMin[3];       // Positions are stored as uint16 fractions of these bounds
+    float boundsMax[3];
+    uint64_t vertexOffset;    // 4 x uint16 per vertex (x, y, z, padding)
+    uint64_t indexOffset;
+    uint8_t reserved[8];
+};
+static_assert(sizeof(MeshAssetHeader) == 80, "MeshAssetHeader layout changed; bump the asset version");
+
+// Compiled mesh asset
+//
+// compile() turns imported geometry into the binary format: triangles reordered for
+// the post-transform vertex cache (Forsyth), vertices reordered by first use,
+// positions quantized to 16 bits. open() maps a compiled file read-only.
+class MeshAsset {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr const char* EXTENSION = ".rcmesh";
+    
+    MeshAsset() = default;
+    
+    // Disable copy constructor and assignment operator
+    MeshAsset(const MeshAsset&) = delete;
+    MeshAsset& operator=(const MeshAsset&) = delete;
+    
+    // Write an optimized asset for a mesh (via a temporary file, so readers never see a partial one)
+    static bool compile(const ImportedMesh& mesh, uint64_t sourceStamp, const std::string& outputPath);
+    
+    // Import an OBJ/PLY file and compile it
+    static bool compileFile(const std::string& sourcePath, const std::string& outputPath);
+    
+    // Stamp of a source file (size and modification time), 0 if it does not exist
+    static uint64_t getSourceStamp(const std::string& sourcePath);
+    
+    // Map a compiled asset. With a non-zero sourceStamp, assets compiled from another
+    // version of the source are rejected.
+    bool open(const std::string& path, uint64_t sourceStamp = 0);
+    void close() { m_file.close(); m_header = nullptr; }
+    bool isOpen() const { return m_header != nullptr; }
+    
+    const MeshAssetHeader& getHeader() const { return *m_header; }
+    const uint16_t* getVertexData() const;
+    const void* getIndexData() const;
+    
+    // Reorder triangles to maximize post-transform vertex cache hits
+    static void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+    
+    // Reorder vertices by first use in the index buffer and drop unreferenced ones
+    static void optimizeVertexFetch(std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices);
+    
+private:
+    MappedFile m_file;
+    const MeshAssetHeader* m_header = nullptr;
+};
@@ -18,6 +18,16 @@ std::vector<float> MeshGenerator::generateCube() {
     };
 }
 
+std::vector<float> MeshGenerator::generateBox(float width, float height, float depth) {
+    std::vector<float> vertices = generateCube();
+    for (size_t i = 0; i < vertices.size(); i += 3) {
+        vertices[i] *= width;
+        vertices[i + 1] *= height;
+        vertices[i + 2] *= depth;
+    }
+    return vertices;
+}
+
 std::vector<float> MeshGenerator::generateSphere(unsigned int longitudeSegments, unsigned int latitudeSegments, float radius) {
     std::vector<float> vertices;
     const float pi = 3.14159265358979323846f;
@@ -27,13 +37,13 @@ std::vector<float> MeshGenerator::generateSphere(unsigned int longitudeSegments,
         float v1 = (float)(y + 1) / (float)latitudeSegments;
         float theta0 = v0 * pi;
         float theta1 = v1 * pi;
-
+    
         for (unsigned int x = 0; x < longitudeSegments; ++x) {
             float u0 = (float)x / (float)longitudeSegments;
             float u1 = (float)(x + 1) / (float)longitudeSegments;
             float phi0 = u0 * 2.0f * pi;
             float phi1 = u1 * 2.0f * pi;
-
+    
             // Four positions on the sphere quad strip
             float p00_x = radius * sinf(theta0) * cosf(phi0);
             float p00_y = radius * cosf(theta0);
@@ -50,7 +60,7 @@ std::vector<float> MeshGenerator::generateSphere(unsigned int longitudeSegments,
             float p11_x = radius * sinf(theta1) * cosf(phi1);
             float p11_y = radius * cosf(theta1);
             float p11_z = radius * sinf(theta1) * sinf(phi1);
-
+    
             // Two triangles: (p00, p10, p11) and (p00, p11, p01)
             vertices.insert(vertices.end(), {p00_x, p00_y, p00_z, p10_x, p10_y, p10_z, p11_x, p11_y, p11_z});
             vertices.insert(vertices.end(), {p00_x, p00_y, p00_z, p11_x, p11_y, p11_z, p01_x, p01_y, p01_z});
@@ -76,3 +86,29 @@ std::vector<float> MeshGenerator::generatePlane(float width, float height) {
          halfWidth, 0.0f,  halfHeight, -halfWidth, 0.0f,  halfHeight, -halfWidth, 0.0f, -halfHeight
     };
 }
+
+std::vector<float> MeshGenerator::generateCylinder(unsigned int segments, float radius, float height) {
+    std::vector<float> vertices;
+    const float pi = 3.14159265358979323846f;
+    float halfHeight = height * 0.5f;
+    vertices.reserve(segments * 12 * 3);
+    
+    for (unsigned int i = 0; i < segments; ++i) {
+        float phi0 = (float)i / (float)segments * 2.0f * pi;
+        float phi1 = (float)(i + 1) / (float)segments * 2.0f * pi;
+        float x0 = radius * cosf(phi0);
+        float z0 = radius * sinf(phi0);
+        float x1 = radius * cosf(phi1);
+        float z1 = radius * sinf(phi1);
+        
+        // Side quad
+        vertices.insert(vertices.end(), {x0, -halfHeight, z0, x1, halfHeight, z1, x1, -halfHeight, z1});
+        vertices.insert(vertices.end(), {x0, -halfHeight, z0, x0, halfHeight, z0, x1, halfHeight, z1});
+        
+        // Top and bottom cap wedges
+        vertices.insert(vertices.end(), {0.0f, halfHeight, 0.0f, x1, halfHeight, z1, x0, halfHeight, z0});
+        vertices.insert(vertices.end(), {0.0f, -halfHeight, 0.0f, x0, -halfHeight, z0, x1, -halfHeight, z1});
+    }
+    
+    return vertices;
+}
@@ -8,6 +8,9 @@ public:
     // Generate a cube mesh (vertices only)
     static std::vector<float> generateCube();
     
+    // Generate a box mesh centered on the origin
+    static std::vector<float> generateBox(float width, float height, float depth);
+    
     // Generate a UV sphere mesh
     static std::vector<float> generateSphere(unsigned int longitudeSegments, unsigned int latitudeSegments, float radius);
     
@@ -16,4 +19,7 @@ public:
     
     // Generate a plane mesh
     static std::vector<float> generatePlane(float width, float height);
+    
+    // Generate a capped cylinder along the Y axis, centered on the origin
+    static std::vector<float> generateCylinder(unsigned int segments, float radius, float height);
 };
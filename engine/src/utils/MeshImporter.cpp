@@ -0,0 +1,357 @@
+#include "MeshImporter.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+
+// Cursor over a text buffer that is not NUL-terminated
+struct TextReader {
+    const char* current;
+    const char* end;
+    
+    bool atEnd() const { return current >= end; }
+    
+    // Next line without its terminator; false at the end of the buffer
+    bool nextLine(std::string& line) {
+        if (atEnd()) {
+            return false;
+        }
+        const char* lineEnd = static_cast<const char*>(std::memchr(current, '\n', end - current));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+        line.assign(current, lineEnd);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        current = lineEnd < end ? lineEnd + 1 : end;
+        return true;
+    }
+};
+
+// Whitespace-separated tokens of one line
+void splitTokens(const std::string& line, std::vector<std::string>& tokens) {
+    tokens.clear();
+    size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && std::isspace(static_cast<unsigned char>(line[i]))) {
+            ++i;
+        }
+        size_t start = i;
+        while (i < line.size() && !std::isspace(static_cast<unsigned char>(line[i]))) {
+            ++i;
+        }
+        if (i > start) {
+            tokens.emplace_back(line, start, i - start);
+        }
+    }
+}
+
+// Resolve an OBJ index (1-based, or negative relative to the end)
+bool resolveObjIndex(const std::string& token, size_t vertexCount, uint32_t& index) {
+    long value = std::strtol(token.c_str(), nullptr, 10);  // Stops at the first '/'
+    long resolved = value > 0 ? value - 1 : static_cast<long>(vertexCount) + value;
+    if (value == 0 || resolved < 0 || resolved >= static_cast<long>(vertexCount)) {
+        return false;
+    }
+    index = static_cast<uint32_t>(resolved);
+    return true;
+}
+
+enum class PlyType {
+    Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64, Invalid
+};
+
+PlyType parsePlyType(const std::string& name) {
+    if (name == "char" || name == "int8") return PlyType::Int8;
+    if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+    if (name == "short" || name == "int16") return PlyType::Int16;
+    if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+    if (name == "int" || name == "int32") return PlyType::Int32;
+    if (name == "uint" || name == "uint32") return PlyType::UInt32;
+    if (name == "float" || name == "float32") return PlyType::Float32;
+    if (name == "double" || name == "float64") return PlyType::Float64;
+    return PlyType::Invalid;
+}
+
+size_t plyTypeSize(PlyType type) {
+    switch (type) {
+        case PlyType::Int8: case PlyType::UInt8: return 1;
+        case PlyType::Int16: case PlyType::UInt16: return 2;
+        case PlyType::Int32: case PlyType::UInt32: case PlyType::Float32: return 4;
+        case PlyType::Float64: return 8;
+        default: return 0;
+    }
+}
+
+struct PlyProperty {
+    std::string name;
+    PlyType type = PlyType::Invalid;
+    PlyType countType = PlyType::Invalid;  // Set for list properties
+};
+
+struct PlyElement {
+    std::string name;
+    size_t count = 0;
+    std::vector<PlyProperty> properties;
+};
+
+// Reads PLY values from either encoding
+struct PlyReader {
+    const char* current;
+    const char* end;
+    bool binary;
+    
+    bool read(PlyType type, double& value) {
+        if (binary) {
+            size_t size = plyTypeSize(type);
+            if (size == 0 || static_cast<size_t>(end - current) < size) {
+                return false;
+            }
+            // Little endian files on little endian hosts (every platform the engine targets)
+            switch (type) {
+                case PlyType::Int8: { int8_t v; std::memcpy(&v, current, 1); value = v; break; }
+                case PlyType::UInt8: { uint8_t v; std::memcpy(&v, current, 1); value = v; break; }
+                case PlyType::Int16: { int16_t v; std::memcpy(&v, current, 2); value = v; break; }
+                case PlyType::UInt16: { uint16_t v; std::memcpy(&v, current, 2); value = v; break; }
+                case PlyType::Int32: { int32_t v; std::memcpy(&v, current, 4); value = v; break; }
+                case PlyType::UInt32: { uint32_t v; std::memcpy(&v, current, 4); value = v; break; }
+                case PlyType::Float32: { float v; std::memcpy(&v, current, 4); value = v; break; }
+                case PlyType::Float64: { double v; std::memcpy(&v, current, 8); value = v; break; }
+                default: return false;
+            }
+            current += size;
+            return true;
+        }
+        
+        while (current < end && std::isspace(static_cast<unsigned char>(*current))) {
+            ++current;
+        }
+        const char* start = current;
+        while (current < end && !std::isspace(static_cast<unsigned char>(*current))) {
+            ++current;
+        }
+        if (current == start) {
+            return false;
+        }
+        value = std::strtod(std::string(start, current).c_str(), nullptr);
+        return true;
+    }
+};
+
+} // namespace
+
+bool MeshImporter::load(const std::string& path, ImportedMesh& mesh) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "MeshImporter::load: Failed to open " << path << "!" << std::endl;
+        return false;
+    }
+    
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    
+    const char* data = reinterpret_cast<const char*>(file.data());
+    if (extension == ".obj") {
+        return loadOBJ(data, file.size(), mesh);
+    }
+    if (extension == ".ply") {
+        return loadPLY(data, file.size(), mesh);
+    }
+    
+    std::cerr << "MeshImporter::load: Unsupported format " << extension << "!" << std::endl;
+    return false;
+}
+
+bool MeshImporter::loadOBJ(const char* data, size_t size, ImportedMesh& mesh) {
+    mesh.positions.clear();
+    mesh.indices.clear();
+    
+    TextReader reader{data, data + size};
+    std::string line;
+    std::vector<std::string> tokens;
+    std::vector<uint32_t> polygon;
+    size_t skippedFaces = 0;
+    
+    while (reader.nextLine(line)) {
+        if (line.size() < 2 || (line[1] != ' ' && line[1] != '\t')) {
+            continue;
+        }
+        
+        if (line[0] == 'v') {
+            splitTokens(line, tokens);
+            if (tokens.size() < 4) {
+                std::cerr << "MeshImporter::loadOBJ: Malformed vertex \"" << line << "\"!" << std::endl;
+                return false;
+            }
+            mesh.positions.emplace_back(std::strtof(tokens[1].c_str(), nullptr),
+                                        std::strtof(tokens[2].c_str(), nullptr),
+                                        std::strtof(tokens[3].c_str(), nullptr));
+        } else if (line[0] == 'f') {
+            splitTokens(line, tokens);
+            polygon.clear();
+            bool valid = tokens.size() >= 4;
+            for (size_t i = 1; i < tokens.size() && valid; ++i) {
+                uint32_t index;
+                valid = resolveObjIndex(tokens[i], mesh.positions.size(), index);
+                polygon.push_back(index);
+            }
+            if (!valid) {
+                skippedFaces++;
+                continue;
+            }
+            for (size_t i = 2; i < polygon.size(); ++i) {
+                mesh.indices.insert(mesh.indices.end(), {polygon[0], polygon[i - 1], polygon[i]});
+            }
+        }
+    }
+    
+    if (skippedFaces > 0) {
+        std::cerr << "MeshImporter::loadOBJ: Skipped " << skippedFaces << " invalid faces" << std::endl;
+    }
+    return !mesh.positions.empty() && !mesh.indices.empty();
+}
+
+bool MeshImporter::loadPLY(const char* data, size_t size, ImportedMesh& mesh) {
+    mesh.positions.clear();
+    mesh.indices.clear();
+    
+    TextReader header{data, data + size};
+    std::string line;
+    std::vector<std::string> tokens;
+    if (!header.nextLine(line) || line != "ply") {
+        std::cerr << "MeshImporter::loadPLY: Missing ply signature!" << std::endl;
+        return false;
+    }
+    
+    bool binary = false;
+    std::vector<PlyElement> elements;
+    bool headerComplete = false;
+    while (header.nextLine(line)) {
+        splitTokens(line, tokens);
+        if (tokens.empty() || tokens[0] == "comment" || tokens[0] == "obj_info") {
+            continue;
+        }
+        if (tokens[0] == "end_header") {
+            headerComplete = true;
+            break;
+        }
+        if (tokens[0] == "format" && tokens.size() >= 2) {
+            if (tokens[1] == "binary_little_endian") {
+                binary = true;
+            } else if (tokens[1] != "ascii") {
+                std::cerr << "MeshImporter::loadPLY: Unsupported format " << tokens[1] << "!" << std::endl;
+                return false;
+            }
+        } else if (tokens[0] == "element" && tokens.size() >= 3) {
+            PlyElement element;
+            element.name = tokens[1];
+            element.count = static_cast<size_t>(std::strtoull(tokens[2].c_str(), nullptr, 10));
+            elements.push_back(element);
+        } else if (tokens[0] == "property" && !elements.empty()) {
+            PlyProperty property;
+            if (tokens.size() >= 5 && tokens[1] == "list") {
+                property.countType = parsePlyType(tokens[2]);
+                property.type = parsePlyType(tokens[3]);
+                property.name = tokens[4];
+            } else if (tokens.size() >= 3) {
+                property.type = parsePlyType(tokens[1]);
+                property.name = tokens[2];
+            }
+            if (property.type == PlyType::Invalid) {
+                std::cerr << "MeshImporter::loadPLY: Unsupported property \"" << line << "\"!" << std::endl;
+                return false;
+            }
+            elements.back().properties.push_back(property);
+        }
+    }
+    if (!headerComplete) {
+        std::cerr << "MeshImporter::loadPLY: Missing end_header!" << std::endl;
+        return false;
+    }
+    
+    PlyReader reader{header.current, data + size, binary};
+    std::vector<double> values;
+    for (const PlyElement& element : elements) {
+        bool isVertex = element.name == "vertex";
+        bool isFace = element.name == "face";
+        int axes[3] = {-1, -1, -1};
+        for (size_t p = 0; p < element.properties.size(); ++p) {
+            const std::string& name = element.properties[p].name;
+            if (name == "x") axes[0] = static_cast<int>(p);
+            if (name == "y") axes[1] = static_cast<int>(p);
+            if (name == "z") axes[2] = static_cast<int>(p);
+        }
+        if (isVertex && (axes[0] < 0 || axes[1] < 0 || axes[2] < 0)) {
+            std::cerr << "MeshImporter::loadPLY: Vertices have no x/y/z properties!" << std::endl;
+            return false;
+        }
+        if (isVertex) {
+            mesh.positions.reserve(element.count);
+        }
+        
+        for (size_t item = 0; item < element.count; ++item) {
+            values.resize(element.properties.size());
+            for (size_t p = 0; p < element.properties.size(); ++p) {
+                const PlyProperty& property = element.properties[p];
+                if (property.countType == PlyType::Invalid) {
+                    if (!reader.read(property.type, values[p])) {
+                        std::cerr << "MeshImporter::loadPLY: Unexpected end of data!" << std::endl;
+                        return false;
+                    }
+                    continue;
+                }
+                
+                double countValue;
+                if (!reader.read(property.countType, countValue)) {
+                    std::cerr << "MeshImporter::loadPLY: Unexpected end of data!" << std::endl;
+                    return false;
+                }
+                size_t count = static_cast<size_t>(countValue);
+                bool faceIndices = isFace && (property.name == "vertex_indices" || property.name == "vertex_index");
+                uint32_t first = 0;
+                uint32_t previous = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    double indexValue;
+                    if (!reader.read(property.type, indexValue)) {
+                        std::cerr << "MeshImporter::loadPLY: Unexpected end of data!" << std::endl;
+                        return false;
+                    }
+                    if (!faceIndices) {
+                        continue;
+                    }
+                    // Fan-triangulate the polygon
+                    uint32_t index = static_cast<uint32_t>(indexValue);
+                    if (i == 0) {
+                        first = index;
+                    } else if (i >= 2) {
+                        mesh.indices.insert(mesh.indices.end(), {first, previous, index});
+                    }
+                    previous = index;
+                }
+            }
+            
+            if (isVertex) {
+                mesh.positions.emplace_back(static_cast<float>(values[axes[0]]),
+                                            static_cast<float>(values[axes[1]]),
+                                            static_cast<float>(values[axes[2]]));
+            }
+        }
+    }
+    
+    // Faces may precede vertices in the file, so indices are validated at the end
+    size_t vertexCount = mesh.positions.size();
+    for (uint32_t index : mesh.indices) {
+        if (index >= vertexCount) {
+            std::cerr << "MeshImporter::loadPLY: Face index " << index << " out of range!" << std::endl;
+            return false;
+        }
+    }
+    return !mesh.positions.empty() && !mesh.indices.empty();
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Triangle mesh read from a source asset (positions only; Mesh has no other attributes)
+struct ImportedMesh {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;  // Three per triangle
+};
+
+// Reads external geometry: Wavefront OBJ and Stanford PLY
+class MeshImporter {
+public:
+    // Load a file, choosing the parser by extension (.obj or .ply)
+    static bool load(const std::string& path, ImportedMesh& mesh);
+    
+    // OBJ: v and f records; polygons are fan-triangulated, negative (relative) indices are allowed
+    static bool loadOBJ(const char* data, size_t size, ImportedMesh& mesh);
+    
+    // PLY: ascii or binary_little_endian, vertex x/y/z and face vertex_indices (or vertex_index) lists
+    static bool loadPLY(const char* data, size_t size, ImportedMesh& mesh);
+};
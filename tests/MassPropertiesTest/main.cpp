@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <glm/glm.hpp>
+#include "utils/MassProperties.h"
+#include "bullet/BulletCollisionShapes.h"
+
+/**
+ * MassPropertiesTest - Checks the inertia handed to Bullet for convex hulls
+ *
+ * Bullet rotates a body about its shape origin and only takes the diagonal of the
+ * local inertia tensor. For boxes that are rotated and moved off the origin, the
+ * moment assigned to each shape axis must equal that axis' diagonal entry of the
+ * analytic tensor R I Rᵀ + m (|c|² E - c cᵀ). A 90 degree turn about Z swaps the X and
+ * Y moments, which catches moments landing on the wrong axis.
+ */
+
+namespace {
+
+constexpr float TOLERANCE = 1.0e-3f;
+
+struct BoxCase {
+    const char* name;
+    glm::vec3 halfExtents;
+    float angleZ;       // Radians
+    glm::vec3 offset;
+    float mass;
+};
+
+glm::mat3 rotationZ(float angle) {
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    return glm::mat3(c, s, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+// Corners and the twelve outward wound triangles of the transformed box
+void buildBox(const BoxCase& box, std::vector<glm::vec3>& vertices, std::vector<glm::ivec3>& triangles) {
+    glm::mat3 rotation = rotationZ(box.angleZ);
+    vertices.clear();
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 corner((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f);
+        vertices.push_back(rotation * (corner * box.halfExtents) + box.offset);
+    }
+    triangles = {
+        {0, 2, 1}, {1, 2, 3},  // -Z
+        {4, 5, 6}, {5, 7, 6},  // +Z
+        {0, 1, 4}, {1, 5, 4},  // -Y
+        {2, 6, 3}, {3, 6, 7},  // +Y
+        {0, 4, 2}, {2, 4, 6},  // -X
+        {1, 3, 5}, {3, 7, 5}   // +X
+    };
+}
+
+glm::vec3 expectedMoments(const BoxCase& box) {
+    glm::vec3 e = box.halfExtents;
+    glm::mat3 centered(0.0f);
+    centered[0][0] = box.mass / 3.0f * (e.y * e.y + e.z * e.z);
+    centered[1][1] = box.mass / 3.0f * (e.x * e.x + e.z * e.z);
+    centered[2][2] = box.mass / 3.0f * (e.x * e.x + e.y * e.y);
+
+    glm::mat3 rotation = rotationZ(box.angleZ);
+    glm::vec3 c = box.offset;
+    glm::mat3 tensor = rotation * centered * glm::transpose(rotation) +
+                       (glm::mat3(glm::dot(c, c)) - glm::outerProduct(c, c)) * box.mass;
+    return glm::vec3(tensor[0][0], tensor[1][1], tensor[2][2]);
+}
+
+bool checkMoments(const char* label, const BoxCase& box, const glm::vec3& actual, const glm::vec3& expected) {
+    bool passed = true;
+    const char* axes[3] = {"x", "y", "z"};
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::abs(actual[axis] - expected[axis]) > TOLERANCE * std::max(1.0f, std::abs(expected[axis]))) {
+            std::cerr << box.name << " (" << label << "): moment about " << axes[axis] << " is " << actual[axis]
+                      << ", expected " << expected[axis] << std::endl;
+            passed = false;
+        }
+    }
+    return passed;
+}
+
+} // namespace
+
+int main() {
+    const BoxCase cases[] = {
+        {"centered", glm::vec3(1.0f, 2.0f, 3.0f), 0.0f, glm::vec3(0.0f), 6.0f},
+        {"quarter turn, off center", glm::vec3(1.0f, 2.0f, 3.0f), 0.5f * 3.14159265f, glm::vec3(2.0f, -1.0f, 0.5f), 6.0f},
+        {"30 degrees, off center", glm::vec3(0.5f, 1.5f, 1.0f), 3.14159265f / 6.0f, glm::vec3(-1.0f, 0.5f, 2.0f), 2.5f},
+    };
+
+    // Hand computed: turning swaps the X and Y moments (26, 20, 10) -> (20, 26, 10), the
+    // offset adds m (|c|² - c_i²) = (7.5, 25.5, 30)
+    const glm::vec3 quarterTurnMoments(27.5f, 51.5f, 40.0f);
+
+    bool passed = true;
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::ivec3> triangles;
+    for (const BoxCase& box : cases) {
+        glm::vec3 expected = expectedMoments(box);
+        buildBox(box, vertices, triangles);
+
+        MassProperties properties = MassProperties::compute(vertices, triangles);
+        glm::mat3 tensor = properties.getInertiaAboutOrigin(box.mass);
+        passed &= checkMoments("MassProperties", box, glm::vec3(tensor[0][0], tensor[1][1], tensor[2][2]), expected);
+
+        btConvexHullShape* hull = BulletCollisionShapes::CreateConvexHull(vertices);
+        passed &= checkMoments("CalculateInertia", box, BulletCollisionShapes::CalculateInertia(hull, box.mass), expected);
+        BulletCollisionShapes::DeleteShape(hull);
+    }
+    passed &= checkMoments("hand computed", cases[1], expectedMoments(cases[1]), quarterTurnMoments);
+
+    std::cout << "MassPropertiesTest: " << (passed ? "passed" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}